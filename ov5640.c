@@ -18,8 +18,6 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "ov5640.h"
-#include "FreeRTOS.h"
-#include "task.h"
 
 /** @addtogroup BSP
  * @{
@@ -39,6 +37,88 @@
  * @{
  */
 
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_Private_Defines
+ * @{
+ */
+#define OV5640_TABLE_LEN(tbl) (sizeof(tbl) / sizeof(OV5640_RegVal_t))
+
+/* Group hold (SRM_GROUP_ACCESS) commands for bank g */
+#define OV5640_GROUP_HOLD_START(g)   ((uint8_t)(g))
+#define OV5640_GROUP_HOLD_END(g)     ((uint8_t)(0x10U | (g)))
+#define OV5640_GROUP_QUICK_LAUNCH(g) ((uint8_t)(0xA0U | (g)))
+#define OV5640_GROUP_DELAY_LAUNCH(g) ((uint8_t)(0x80U | (g)))
+
+/* Bank used by the setters updating several registers atomically */
+#define OV5640_GROUP_DEFAULT         0x03U
+
+/* Bank of the writes queued for the next frame, see OV5640_FlushDeferred */
+#define OV5640_DEFERRED_BANK         0x02U
+
+/* Autofocus sequence steps */
+#define OV5640_AF_STEP_SINGLE     0x00U /* Waiting for 0x3029 to report focused */
+#define OV5640_AF_STEP_RELEASE    0x01U /* Waiting for the release command ack  */
+#define OV5640_AF_STEP_CONTINUOUS 0x02U /* Waiting for the continuous AF ack    */
+
+/* AF firmware readback: window size and count of the sampled check, read
+   size of the full check, CRC-16/CCITT seed */
+#define OV5640_AF_PROBE_SIZE      16U
+#define OV5640_AF_VERIFY_SAMPLES  8U
+#define OV5640_AF_VERIFY_CHUNK    64U
+#define OV5640_AF_CRC_INIT        0xFFFFU
+
+/* Check telling whether the firmware already in the program RAM is ours */
+#if (OV5640_AF_VERIFY_MODE == OV5640_AF_VERIFY_FULL)
+#define OV5640_AF_RESIDENT_CHECK  OV5640_AF_VERIFY_FULL
+#else
+#define OV5640_AF_RESIDENT_CHECK  OV5640_AF_VERIFY_SAMPLED
+#endif
+
+/* 5 ms polls of the AF firmware boot in OV5640_Focus_Init */
+#define OV5640_AF_BOOT_POLLS      1000U
+
+/* Pixel array geometry used by the output mode computation */
+#define OV5640_ARRAY_WIDTH        2624U /* Readable columns, 0x3800 ~ 0x3805  */
+#define OV5640_ARRAY_HEIGHT       1952U /* Readable rows, 0x3802 ~ 0x3807     */
+#define OV5640_ISP_HOFFSET        16U   /* ISP crop on each side, 0x3810      */
+#define OV5640_ISP_VOFFSET        4U    /* ISP crop on each side, 0x3812      */
+#define OV5640_HBLANK_FULL        220U  /* Minimum HTS - width, full readout  */
+#define OV5640_HBLANK_SUBSAMPLE   584U  /* Minimum HTS - width, subsampled    */
+#define OV5640_VBLANK_MIN         16U   /* Minimum VTS - height               */
+
+/* JPEG rate control: steps per frame and dead band around the target */
+#define OV5640_JPEG_QSTEP_UP      8U /* Overshoot is corrected fast      */
+#define OV5640_JPEG_QSTEP_DOWN    1U /* Quality is recovered slowly      */
+#define OV5640_JPEG_DEADBAND(t)   ((t) / 8U)
+
+/* Manual exposure: AEC_PK_MANUAL bits and banks alternating between frames */
+#define OV5640_AEC_MANUAL_MASK    0x03U /* [1] manual AGC, [0] manual AEC */
+#define OV5640_AEC_BANK_FIRST     0x00U
+#define OV5640_AEC_BANK_SECOND    0x01U
+
+/* PLL solver limits */
+#define OV5640_PLL_MULT_MIN       4U
+#define OV5640_PLL_MULT_MAX       252U  /* Even values only above 127         */
+#define OV5640_PLL_SYSDIV_MAX     15U
+#define OV5640_PLL_PCLKDIV_MAX    31U
+#define OV5640_PLL_BIT_DIV        2U    /* 8-bit DVP output                   */
+#define OV5640_PLL_VCO_MIN        250000000U /* Presets go down to 288MHz       */
+#define OV5640_PLL_VCO_MAX        1000000000U
+#define OV5640_PLL_PCLK_MAX       96000000U  /* DVP limit without host limit   */
+#define OV5640_PLL_OUTPUT_BPP     2U    /* RGB565/YUV422 lines of ComputeOutputMode */
+
+/* MIPI link solver limits */
+#define OV5640_MIPI_ROOT_DIV      2U    /* SC_PLL_CONTRL3[4] as in the preset */
+#define OV5640_MIPI_BITS          8U    /* SC_PLL_CONTRL0 0x18, 8-bit lanes   */
+#define OV5640_MIPI_SCLK_RATIO    8U    /* SYSCLK per output byte, preset 224MHz for 28MB/s */
+#define OV5640_MIPI_PCLK_MIN      4000000U   /* PCLK_PERIOD holds 255ns at most */
+#define OV5640_MIPI_VCO_MIN       200000000U /* The preset runs at 224MHz       */
+#define OV5640_MIPI_SCLK_MAX      1000000000U
+#define OV5640_MIPI_LANE_RATE_MAX 672000000U /* Datasheet, per data lane       */
+
 /**
  * @}
  */
@@ -66,6 +146,44 @@ OV5640_CAMERA_Drv_t OV5640_CAMERA_Driver =
         OV5640_GetPixelFormat,
         OV5640_NightModeConfig};
 
+#if (OV5640_CFG_AF == 1U)
+extern const uint8_t OV5640_AF_Config[];
+#endif
+
+/* Registers held by a mode profile, sorted by address so deltas coalesce */
+static const uint16_t OV5640_ProfileRegs[OV5640_PROFILE_NUM_REGS] = {
+    0x3002, 0x3006, 0x3035, 0x3036, 0x3037, 0x3503, 0x3612, 0x3618, 0x3709, 0x370c,
+    0x3800, 0x3801, 0x3802, 0x3803, 0x3804, 0x3805, 0x3806, 0x3807, 0x3808, 0x3809,
+    0x380a, 0x380b, 0x380c, 0x380d, 0x380e, 0x380f, 0x3810, 0x3811, 0x3812, 0x3813,
+    0x3814, 0x3815, 0x3820, 0x3821, 0x3824, 0x3a02, 0x3a03, 0x3a14, 0x3a15, 0x3c07,
+    0x4004, 0x4300, 0x4407, 0x460b, 0x460c, 0x4713, 0x4837, 0x5001, 0x501f};
+
+/* OV5640_PCLK_xxx presets by increasing frequency in Hz */
+static const uint32_t OV5640_PCLKFreq[][2] = {
+    { OV5640_PCLK_7M,  7000000U},
+    { OV5640_PCLK_8M,  8000000U},
+    { OV5640_PCLK_9M,  9000000U},
+    {OV5640_PCLK_12M, 12000000U},
+    {OV5640_PCLK_24M, 24000000U},
+    {OV5640_PCLK_48M, 48000000U},
+};
+
+/* SC_PLL_CONTRL3 pre-divider values tried by the PLL solver */
+static const uint8_t OV5640_PLLPreDiv[] = {1U, 2U, 3U, 4U, 6U, 8U};
+
+/* SDE values of the brightness, saturation and contrast levels -4 to 4 */
+static const uint8_t OV5640_BrightnessLevel[] = {0x40U, 0x30U, 0x20U, 0x10U, 0x00U, 0x10U, 0x20U, 0x30U, 0x40U};
+static const uint8_t OV5640_SaturationLevel[] = {0x00U, 0x10U, 0x20U, 0x30U, 0x40U, 0x50U, 0x60U, 0x70U, 0x80U};
+static const uint8_t OV5640_ContrastLevel[]   = {0x10U, 0x14U, 0x18U, 0x1CU, 0x20U, 0x24U, 0x28U, 0x2CU, 0x30U};
+
+/* SDE_CTRL1, SDE_CTRL2 and SDE_CTRL8 signs of the hue degrees -6 to 5 */
+static const uint8_t OV5640_HueCtrl1[] = {0x80U, 0x6FU, 0x40U, 0x00U, 0x40U, 0x6FU, 0x80U, 0x6FU, 0x40U, 0x00U, 0x40U,
+                                          0x6FU};
+static const uint8_t OV5640_HueCtrl2[] = {0x00U, 0x40U, 0x6FU, 0x80U, 0x6FU, 0x40U, 0x00U, 0x40U, 0x6FU, 0x80U, 0x6FU,
+                                          0x40U};
+static const uint8_t OV5640_HueCtrl8[] = {0x32U, 0x32U, 0x32U, 0x02U, 0x02U, 0x02U, 0x01U, 0x01U, 0x01U, 0x31U, 0x31U,
+                                          0x31U};
+
 /**
  * @}
  */
@@ -75,7 +193,59 @@ OV5640_CAMERA_Drv_t OV5640_CAMERA_Driver =
  */
 static int32_t OV5640_ReadRegWrap(void *handle, uint16_t Reg, uint8_t *Data, uint16_t Length);
 static int32_t OV5640_WriteRegWrap(void *handle, uint16_t Reg, uint8_t *Data, uint16_t Length);
+static int32_t OV5640_BusRead(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static int32_t OV5640_BusWrite(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static int32_t OV5640_BusWriteOnce(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static void    OV5640_BusBackoff(OV5640_Object_t *pObj, uint32_t Attempt);
 static int32_t OV5640_Delay(OV5640_Object_t *pObj, uint32_t Delay);
+#if (OV5640_CFG_AF == 1U) || (OV5640_USE_ASYNC_IO == 1U)
+static int32_t OV5640_WriteBurst(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint32_t Length);
+#endif
+#if (OV5640_CFG_AF == 1U)
+static void    OV5640_AF_Finish(OV5640_Object_t *pObj, uint8_t State);
+static int32_t OV5640_AF_Wait(OV5640_Object_t *pObj);
+static int32_t OV5640_AF_ReadAck(OV5640_Object_t *pObj, uint16_t Reg, uint8_t Value, uint8_t *pReady);
+#endif
+static int32_t OV5640_GroupOpen(OV5640_Object_t *pObj);
+static int32_t OV5640_GroupClose(OV5640_Object_t *pObj);
+static int32_t OV5640_WriteSharpness(OV5640_Object_t *pObj, uint8_t sharp);
+static int32_t OV5640_GroupWriteDelayed(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static int32_t OV5640_ReadStandbySentinel(OV5640_Object_t *pObj, uint8_t *pTiming, uint8_t *pPll);
+#if (OV5640_CFG_AF == 1U)
+static uint8_t OV5640_IsAFResident(OV5640_Object_t *pObj);
+static uint16_t OV5640_Crc16(uint16_t Crc, const uint8_t *pData, uint32_t Length);
+#endif
+static int32_t OV5640_Lock(OV5640_Object_t *pObj, uint32_t Id);
+static void    OV5640_Unlock(OV5640_Object_t *pObj, uint32_t Id);
+static int32_t OV5640_BusAcquire(OV5640_Object_t *pObj);
+static void    OV5640_GetPCLKRegs(uint32_t ClockValue, OV5640_RegVal_t *pRegs);
+static uint32_t OV5640_SearchPLL(uint32_t XClk, uint64_t Target, uint32_t MaxPClk, OV5640_PLL_t *pBest);
+static void    OV5640_ProfileReplay(OV5640_ModeProfile_t *pProfile, const OV5640_RegVal_t *pTable, uint32_t Size);
+static uint8_t OV5640_ProfileGet(const OV5640_ModeProfile_t *pProfile, uint16_t Reg);
+#if (OV5640_USE_REG_CACHE == 1U)
+static uint8_t  OV5640_IsVolatileReg(uint16_t Reg);
+static uint32_t OV5640_CacheIndex(uint16_t Reg);
+static uint8_t  OV5640_CacheLookup(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static void     OV5640_CacheFill(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length,
+                                 int32_t Status);
+static uint8_t  OV5640_CacheMatch(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length);
+static void     OV5640_CacheStore(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length,
+                                  int32_t Status);
+#endif
+#if (OV5640_USE_STATS == 1U)
+static uint32_t OV5640_StatsTick(OV5640_Object_t *pObj);
+static void     OV5640_StatsRecord(OV5640_Object_t *pObj, uint8_t Read, uint16_t Length, int32_t Status,
+                                   uint32_t Ticks);
+#endif
+#if (OV5640_USE_ASYNC_IO == 1U)
+static int32_t  OV5640_AsyncSubmit(OV5640_Object_t *pObj, const OV5640_AsyncJob_t *pJob);
+static void     OV5640_AsyncNext(OV5640_Object_t *pObj);
+#endif
+#if (OV5640_USE_DEFERRED == 1U)
+static int32_t  OV5640_DeferredStore(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length);
+static void     OV5640_DeferredOverlay(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static int32_t  OV5640_DeferredSend(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length);
+#endif
 
 /**
  * @}
@@ -86,6 +256,8 @@ static int32_t OV5640_Delay(OV5640_Object_t *pObj, uint32_t Delay);
  */
 /**
  * @brief  Register component IO bus
+ * @note   The optional hooks of pIO must be NULL when not provided, see
+ *         OV5640_IO_t.
  * @param  Component object pointer
  * @retval Component status
  */
@@ -102,6 +274,13 @@ int32_t OV5640_RegisterBusIO(OV5640_Object_t *pObj, OV5640_IO_t *pIO) {
         pObj->IO.WriteReg  = pIO->WriteReg;
         pObj->IO.ReadReg   = pIO->ReadReg;
         pObj->IO.GetTick   = pIO->GetTick;
+#if (OV5640_USE_DELAY_HOOK == 1U)
+        pObj->IO.Delay     = pIO->Delay;
+#endif
+#if (OV5640_USE_LOCKS == 1U)
+        pObj->IO.Lock      = pIO->Lock;
+        pObj->IO.Unlock    = pIO->Unlock;
+#endif
 
         pObj->Ctx.ReadReg  = OV5640_ReadRegWrap;
         pObj->Ctx.WriteReg = OV5640_WriteRegWrap;
@@ -111,7 +290,42 @@ int32_t OV5640_RegisterBusIO(OV5640_Object_t *pObj, OV5640_IO_t *pIO) {
         pObj->saturation   = 0x41;
         pObj->contrast     = 0x41;
         pObj->huedegree    = 0x32;
-
+        pObj->BurstSize    = OV5640_BURST_SIZE;
+        pObj->pProfile     = NULL;
+        pObj->GroupActive  = 0U;
+        pObj->CustomReadout = 0U;
+        pObj->JPEGRate.TargetSize = 0U;
+        pObj->AEC.Manual   = 0U;
+        pObj->AEC.Bank     = OV5640_AEC_BANK_FIRST;
+        pObj->AF.State     = OV5640_AF_IDLE;
+
+        pObj->Standby.Suspended   = 0U;
+        pObj->Standby.Resolution  = OV5640_MODE_UNKNOWN;
+        pObj->Standby.PixelFormat = OV5640_MODE_UNKNOWN;
+
+#if (OV5640_USE_DEFERRED == 1U)
+        pObj->Deferred.Count    = 0;
+        pObj->Deferred.Start    = 0;
+        pObj->Deferred.Owners   = 0;
+        pObj->Deferred.Flushed  = 0;
+        pObj->Deferred.Capture  = 0U;
+        pObj->Deferred.Overflow = 0U;
+#endif
+
+        (void)OV5640_InvalidateRegCache(pObj);
+#if (OV5640_USE_STATS == 1U)
+        pObj->Stats.Current = 0U;
+        (void)OV5640_ResetStats(pObj);
+#endif
+
+#if (OV5640_USE_ASYNC_IO == 1U)
+        pObj->IO.WriteRegAsync = pIO->WriteRegAsync;
+        pObj->IO.ReadRegAsync  = pIO->ReadRegAsync;
+        pObj->Async.Head       = 0;
+        pObj->Async.Count      = 0;
+        pObj->Async.Busy       = 0U;
+        pObj->Async.Index      = 0;
+#endif
 
         if (pObj->IO.Init != NULL) {
             ret = pObj->IO.Init();
@@ -132,11 +346,15 @@ int32_t OV5640_RegisterBusIO(OV5640_Object_t *pObj, OV5640_IO_t *pIO) {
  * @retval Component status
  */
 int32_t OV5640_Init(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat) {
-    uint32_t index;
     int32_t  ret = OV5640_OK;
+#if (OV5640_CFG_FIXED_INIT == 1U)
+    uint32_t start;
+    uint32_t i;
+#endif
 
+#if (OV5640_CFG_FIXED_INIT != 1U)
     /* Initialization sequence for OV5640 */
-    static const uint16_t OV5640_Common[][2] = {
+    static const OV5640_RegVal_t OV5640_Common[] = {
         {    OV5640_SCCB_SYSTEM_CTRL1, 0x11},
         {        OV5640_SYSTEM_CTROL0, 0x82},
         {    OV5640_SCCB_SYSTEM_CTRL1, 0x03},
@@ -385,11 +603,49 @@ int32_t OV5640_Init(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFo
         {           OV5640_AEC_CTRL1F, 0x14},
         {        OV5640_SYSTEM_CTROL0, 0x02},
     };
-    uint8_t tmp;
+#endif
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
     if (pObj->IsInitialized == 0U) {
+#if (OV5640_CFG_FIXED_INIT == 1U)
+        /* The table holds the whole merged sequence of a single mode */
+        if ((Resolution != OV5640_FixedInitResolution) || (PixelFormat != OV5640_FixedInitFormat) ||
+            (pObj->Mode != OV5640_FixedInitMode)) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            /* Written in runs between the recorded settle delays */
+            start = 0;
+            for (i = 0; (ret == OV5640_OK) && (i <= OV5640_FixedInitSize); i++) {
+                if ((i == OV5640_FixedInitSize) || (OV5640_FixedInit[i].Reg == OV5640_FIXED_INIT_DELAY)) {
+                    if ((i > start) && (OV5640_WriteTable(pObj, &OV5640_FixedInit[start], i - start) != OV5640_OK)) {
+                        ret = OV5640_ERROR;
+                    }
+                    else if (i < OV5640_FixedInitSize) {
+                        (void)OV5640_Delay(pObj, OV5640_FixedInit[i].Value);
+                    }
+                    start = i + 1U;
+                }
+            }
+#if (OV5640_CFG_MIPI == 1U)
+            /* Generated for virtual channel 0 */
+            if ((ret == OV5640_OK) && (pObj->Mode == SERIAL_MODE) &&
+                (OV5640_SetMIPIVirtualChannel(pObj, pObj->VirtualChannelID) != OV5640_OK)) {
+                ret = OV5640_ERROR;
+            }
+#endif
+            if (ret == OV5640_OK) {
+                pObj->CustomReadout = 0U;
+                pObj->AEC.Manual    = 0U;
+                pObj->IsInitialized = 1U;
+            }
+        }
+#else
         /* Check if resolution is supported */
-        if ((Resolution > OV5640_R800x480) ||
+        if ((Resolution > OV5640_R2592x1944) ||
             ((PixelFormat != OV5640_RGB565) && (PixelFormat != OV5640_YUV422) &&
              (PixelFormat != OV5640_RGB888) && (PixelFormat != OV5640_Y8) &&
              (PixelFormat != OV5640_JPEG))) {
@@ -397,27 +653,29 @@ int32_t OV5640_Init(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFo
         }
         else {
             /* Set common parameters for all resolutions */
-            for (index = 0; index < (sizeof(OV5640_Common) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_Common[index][1];
-
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_Common[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_Common, OV5640_TABLE_LEN(OV5640_Common)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
+            pObj->CustomReadout = 0U;
+            pObj->AEC.Manual    = 0U;
 
             if (ret == OV5640_OK) {
                 /* Set configuration for Serial Interface */
                 if (pObj->Mode == SERIAL_MODE) {
+#if (OV5640_CFG_MIPI == 1U)
                     if (OV5640_EnableMIPIMode(pObj) != OV5640_OK) {
                         ret = OV5640_ERROR;
                     }
                     else if (OV5640_SetMIPIVirtualChannel(pObj, pObj->VirtualChannelID) != OV5640_OK) {
                         ret = OV5640_ERROR;
                     }
+#else
+                    /* MIPI interface compiled out */
+                    ret = OV5640_ERROR;
+#endif
                 }
                 else {
+#if (OV5640_CFG_DVP == 1U)
                     /* Set configuration for parallel Interface */
                     if (OV5640_EnableDVPMode(pObj) != OV5640_OK) {
                         ret = OV5640_ERROR;
@@ -425,6 +683,10 @@ int32_t OV5640_Init(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFo
                     else {
                         ret = OV5640_OK;
                     }
+#else
+                    /* Parallel interface compiled out */
+                    ret = OV5640_ERROR;
+#endif
                 }
             }
 
@@ -446,8 +708,12 @@ int32_t OV5640_Init(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFo
                 }
             }
         }
+#endif
     }
 
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -465,6 +731,48 @@ int32_t OV5640_DeInit(OV5640_Object_t *pObj) {
     return OV5640_OK;
 }
 
+/* Initialization sequence for RGB565 pixel format */
+static const OV5640_RegVal_t OV5640_PF_RGB565[] =
+    {
+        /*  SET PIXEL FORMAT: RGB565 */
+        {  OV5640_FORMAT_CTRL00, 0x6F},
+        {OV5640_FORMAT_MUX_CTRL, 0x01},
+};
+
+/* Initialization sequence for YUV422 pixel format */
+static const OV5640_RegVal_t OV5640_PF_YUV422[] =
+    {
+        /*  SET PIXEL FORMAT: YUV422 */
+        {  OV5640_FORMAT_CTRL00, 0x30},
+        {OV5640_FORMAT_MUX_CTRL, 0x00},
+};
+
+/* Initialization sequence for RGB888 pixel format */
+static const OV5640_RegVal_t OV5640_PF_RGB888[] =
+    {
+        /*  SET PIXEL FORMAT: RGB888 (RGBRGB)*/
+        {  OV5640_FORMAT_CTRL00, 0x23},
+        {OV5640_FORMAT_MUX_CTRL, 0x01},
+};
+
+/* Initialization sequence for Monochrome 8bits pixel format */
+static const OV5640_RegVal_t OV5640_PF_Y8[] =
+    {
+        /*  SET PIXEL FORMAT: Y 8bits */
+        {  OV5640_FORMAT_CTRL00, 0x10},
+        {OV5640_FORMAT_MUX_CTRL, 0x00},
+};
+
+#if (OV5640_CFG_JPEG == 1U)
+/* Initialization sequence for JPEG format */
+static const OV5640_RegVal_t OV5640_PF_JPEG[] =
+    {
+        /*  SET PIXEL FORMAT: JPEG */
+        {  OV5640_FORMAT_CTRL00, 0x30},
+        {OV5640_FORMAT_MUX_CTRL, 0x00},
+};
+#endif
+
 /**
  * @brief  Set OV5640 camera Pixel Format.
  * @param  pObj  pointer to component object
@@ -473,48 +781,13 @@ int32_t OV5640_DeInit(OV5640_Object_t *pObj) {
  */
 int32_t OV5640_SetPixelFormat(OV5640_Object_t *pObj, uint32_t PixelFormat) {
     int32_t  ret = OV5640_OK;
-    uint32_t index;
+#if (OV5640_CFG_JPEG == 1U)
     uint8_t  tmp;
+#endif
 
-    /* Initialization sequence for RGB565 pixel format */
-    static const uint16_t OV5640_PF_RGB565[][2] =
-        {
-            /*  SET PIXEL FORMAT: RGB565 */
-            {  OV5640_FORMAT_CTRL00, 0x6F},
-            {OV5640_FORMAT_MUX_CTRL, 0x01},
-    };
-
-    /* Initialization sequence for YUV422 pixel format */
-    static const uint16_t OV5640_PF_YUV422[][2] =
-        {
-            /*  SET PIXEL FORMAT: YUV422 */
-            {  OV5640_FORMAT_CTRL00, 0x30},
-            {OV5640_FORMAT_MUX_CTRL, 0x00},
-    };
-
-    /* Initialization sequence for RGB888 pixel format */
-    static const uint16_t OV5640_PF_RGB888[][2] =
-        {
-            /*  SET PIXEL FORMAT: RGB888 (RGBRGB)*/
-            {  OV5640_FORMAT_CTRL00, 0x23},
-            {OV5640_FORMAT_MUX_CTRL, 0x01},
-    };
-
-    /* Initialization sequence for Monochrome 8bits pixel format */
-    static const uint16_t OV5640_PF_Y8[][2] =
-        {
-            /*  SET PIXEL FORMAT: Y 8bits */
-            {  OV5640_FORMAT_CTRL00, 0x10},
-            {OV5640_FORMAT_MUX_CTRL, 0x00},
-    };
-
-    /* Initialization sequence for JPEG format */
-    static const uint16_t OV5640_PF_JPEG[][2] =
-        {
-            /*  SET PIXEL FORMAT: JPEG */
-            {  OV5640_FORMAT_CTRL00, 0x30},
-            {OV5640_FORMAT_MUX_CTRL, 0x00},
-    };
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
     /* Check if PixelFormat is supported */
     if ((PixelFormat != OV5640_RGB565) && (PixelFormat != OV5640_YUV422) &&
@@ -523,81 +796,65 @@ int32_t OV5640_SetPixelFormat(OV5640_Object_t *pObj, uint32_t PixelFormat) {
         /* Pixel format not supported */
         ret = OV5640_ERROR;
     }
+#if (OV5640_CFG_JPEG != 1U)
+    else if (PixelFormat == OV5640_JPEG) {
+        /* JPEG output compiled out */
+        ret = OV5640_ERROR;
+    }
+#endif
     else {
         /* Set specific parameters for each PixelFormat */
         switch (PixelFormat) {
         case OV5640_YUV422:
-            for (index = 0; index < (sizeof(OV5640_PF_YUV422) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_PF_YUV422[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_PF_YUV422[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else {
-                        (void)OV5640_Delay(pObj, 1);
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_PF_YUV422, OV5640_TABLE_LEN(OV5640_PF_YUV422)) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                (void)OV5640_Delay(pObj, 1);
             }
             break;
 
         case OV5640_RGB888:
-            for (index = 0; index < (sizeof(OV5640_PF_RGB888) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_PF_RGB888[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_PF_RGB888[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else {
-                        (void)OV5640_Delay(pObj, 1);
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_PF_RGB888, OV5640_TABLE_LEN(OV5640_PF_RGB888)) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                (void)OV5640_Delay(pObj, 1);
             }
             break;
 
         case OV5640_Y8:
-            for (index = 0; index < (sizeof(OV5640_PF_Y8) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_PF_Y8[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_PF_Y8[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else {
-                        (void)OV5640_Delay(pObj, 1);
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_PF_Y8, OV5640_TABLE_LEN(OV5640_PF_Y8)) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                (void)OV5640_Delay(pObj, 1);
             }
             break;
 
+#if (OV5640_CFG_JPEG == 1U)
         case OV5640_JPEG:
-            for (index = 0; index < (sizeof(OV5640_PF_JPEG) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_PF_JPEG[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_PF_JPEG[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else {
-                        (void)OV5640_Delay(pObj, 1);
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_PF_JPEG, OV5640_TABLE_LEN(OV5640_PF_JPEG)) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                (void)OV5640_Delay(pObj, 1);
             }
             break;
+#endif
 
         case OV5640_RGB565:
         default:
-            for (index = 0; index < (sizeof(OV5640_PF_RGB565) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_PF_RGB565[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_PF_RGB565[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else {
-                        (void)OV5640_Delay(pObj, 1);
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_PF_RGB565, OV5640_TABLE_LEN(OV5640_PF_RGB565)) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                (void)OV5640_Delay(pObj, 1);
             }
             break;
         }
 
+#if (OV5640_CFG_JPEG == 1U)
         if (PixelFormat == OV5640_JPEG) {
             if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_TC_REG21, &tmp, 1) != OV5640_OK) {
                 ret = OV5640_ERROR;
@@ -631,7 +888,12 @@ int32_t OV5640_SetPixelFormat(OV5640_Object_t *pObj, uint32_t PixelFormat) {
                 }
             }
         }
+#endif
     }
+
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -655,12 +917,37 @@ int32_t OV5640_GetPixelFormat(OV5640_Object_t *pObj, uint32_t *PixelFormat) {
  * @retval Component status
  */
 int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
-    int32_t  ret = OV5640_OK;
-    uint32_t index;
-    uint8_t  tmp;
+    int32_t ret = OV5640_OK;
+
+    /* Subsampled readout of the resolutions up to WVGA, as set by OV5640_Init */
+    static const OV5640_RegVal_t OV5640_Subsampled[] =
+        {
+            {     OV5640_TIMING_HS_HIGH, 0x00},
+            {      OV5640_TIMING_HS_LOW, 0x00},
+            {     OV5640_TIMING_VS_HIGH, 0x00},
+            {      OV5640_TIMING_VS_LOW, 0x04},
+            {     OV5640_TIMING_HW_HIGH, 0x0a},
+            {      OV5640_TIMING_HW_LOW, 0x3f},
+            {     OV5640_TIMING_VH_HIGH, 0x07},
+            {      OV5640_TIMING_VH_LOW, 0x9b},
+            {    OV5640_TIMING_HTS_HIGH, 0x07},
+            {     OV5640_TIMING_HTS_LOW, 0x90},
+            {    OV5640_TIMING_VTS_HIGH, 0x04},
+            {     OV5640_TIMING_VTS_LOW, 0x40},
+            {OV5640_TIMING_HOFFSET_HIGH, 0x00},
+            { OV5640_TIMING_HOFFSET_LOW, 0x10},
+            {OV5640_TIMING_VOFFSET_HIGH, 0x00},
+            { OV5640_TIMING_VOFFSET_LOW, 0x06},
+            {       OV5640_TIMING_X_INC, 0x31},
+            {       OV5640_TIMING_Y_INC, 0x31},
+            {         OV5640_AEC_CTRL02, 0x03},
+            {         OV5640_AEC_CTRL03, 0xd8},
+            {  OV5640_AEC_MAX_EXPO_HIGH, 0x03},
+            {   OV5640_AEC_MAX_EXPO_LOW, 0xd8},
+    };
 
     /* Initialization sequence for WVGA resolution (800x480)*/
-    static const uint16_t OV5640_WVGA[][2] =
+    static const OV5640_RegVal_t OV5640_WVGA[] =
         {
             {OV5640_TIMING_DVPHO_HIGH, 0x03},
             { OV5640_TIMING_DVPHO_LOW, 0x20},
@@ -669,7 +956,7 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
     };
 
     /* Initialization sequence for VGA resolution (640x480)*/
-    static const uint16_t OV5640_VGA[][2] =
+    static const OV5640_RegVal_t OV5640_VGA[] =
         {
             {OV5640_TIMING_DVPHO_HIGH, 0x02},
             { OV5640_TIMING_DVPHO_LOW, 0x80},
@@ -678,7 +965,7 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
     };
 
     /* Initialization sequence for 480x272 resolution */
-    static const uint16_t OV5640_480x272[][2] =
+    static const OV5640_RegVal_t OV5640_480x272[] =
         {
             {OV5640_TIMING_DVPHO_HIGH, 0x01},
             { OV5640_TIMING_DVPHO_LOW, 0xE0},
@@ -687,7 +974,7 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
     };
 
     /* Initialization sequence for QVGA resolution (320x240) */
-    static const uint16_t OV5640_QVGA[][2] =
+    static const OV5640_RegVal_t OV5640_QVGA[] =
         {
             {OV5640_TIMING_DVPHO_HIGH, 0x01},
             { OV5640_TIMING_DVPHO_LOW, 0x40},
@@ -696,7 +983,7 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
     };
 
     /* Initialization sequence for QQVGA resolution (160x120) */
-    static const uint16_t OV5640_QQVGA[][2] =
+    static const OV5640_RegVal_t OV5640_QQVGA[] =
         {
             {OV5640_TIMING_DVPHO_HIGH, 0x00},
             { OV5640_TIMING_DVPHO_LOW, 0xA0},
@@ -704,61 +991,50 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
             { OV5640_TIMING_DVPVO_LOW, 0x78},
     };
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     /* Check if resolution is supported */
-    if (Resolution > OV5640_R800x480) {
+    if (Resolution > OV5640_R2592x1944) {
+        ret = OV5640_ERROR;
+    }
+    else if (Resolution > OV5640_R800x480) {
+        /* Larger sizes no longer fit the subsampled readout: compute it */
+        ret = OV5640_SetOutputMode(pObj, solution_table[Resolution][0], solution_table[Resolution][1], 0U);
+    }
+    else if ((pObj->CustomReadout != 0U) &&
+             (OV5640_WriteTable(pObj, OV5640_Subsampled, OV5640_TABLE_LEN(OV5640_Subsampled)) != OV5640_OK)) {
         ret = OV5640_ERROR;
     }
     else {
+        pObj->CustomReadout = 0U;
+
         /* Initialize OV5640 */
         switch (Resolution) {
         case OV5640_R160x120:
-            for (index = 0; index < (sizeof(OV5640_QQVGA) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_QQVGA[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_QQVGA[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_QQVGA, OV5640_TABLE_LEN(OV5640_QQVGA)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_R320x240:
-            for (index = 0; index < (sizeof(OV5640_QVGA) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_QVGA[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_QVGA[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_QVGA, OV5640_TABLE_LEN(OV5640_QVGA)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_R480x272:
-            for (index = 0; index < (sizeof(OV5640_480x272) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_480x272[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_480x272[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_480x272, OV5640_TABLE_LEN(OV5640_480x272)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_R640x480:
-            for (index = 0; index < (sizeof(OV5640_VGA) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_VGA[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_VGA[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_VGA, OV5640_TABLE_LEN(OV5640_VGA)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_R800x480:
-            for (index = 0; index < (sizeof(OV5640_WVGA) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_WVGA[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_WVGA[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_WVGA, OV5640_TABLE_LEN(OV5640_WVGA)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         default:
@@ -767,6 +1043,9 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
         }
     }
 
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -777,62 +1056,31 @@ int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution) {
  * @retval Component status
  */
 int32_t OV5640_GetResolution(OV5640_Object_t *pObj, uint32_t *Resolution) {
-    int32_t  ret;
+    int32_t  ret = OV5640_ERROR;
     uint16_t x_size;
     uint16_t y_size;
-    uint8_t  tmp;
+    uint8_t  tmp[4];
+    uint32_t index;
 
-    if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_DVPHO_HIGH, &tmp, 1) != OV5640_OK) {
-        ret = OV5640_ERROR;
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
     }
-    else {
-        x_size = (uint16_t)tmp << 8U;
-
-        if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_DVPHO_LOW, &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-        }
-        else {
-            x_size |= tmp;
 
-            if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_DVPVO_HIGH, &tmp, 1) != OV5640_OK) {
-                ret = OV5640_ERROR;
-            }
-            else {
-                y_size = (uint16_t)tmp << 8U;
-                if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_DVPVO_LOW, &tmp, 1) != OV5640_OK) {
-                    ret = OV5640_ERROR;
-                }
-                else {
-                    y_size |= tmp;
+    /* DVPHO and DVPVO are contiguous, read them in one transfer */
+    if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_DVPHO_HIGH, tmp, 4) == OV5640_OK) {
+        x_size = ((uint16_t)tmp[0] << 8U) | tmp[1];
+        y_size = ((uint16_t)tmp[2] << 8U) | tmp[3];
 
-                    if ((x_size == 800U) && (y_size == 480U)) {
-                        *Resolution = OV5640_R800x480;
-                        ret         = OV5640_OK;
-                    }
-                    else if ((x_size == 640U) && (y_size == 480U)) {
-                        *Resolution = OV5640_R640x480;
-                        ret         = OV5640_OK;
-                    }
-                    else if ((x_size == 480U) && (y_size == 272U)) {
-                        *Resolution = OV5640_R480x272;
-                        ret         = OV5640_OK;
-                    }
-                    else if ((x_size == 320U) && (y_size == 240U)) {
-                        *Resolution = OV5640_R320x240;
-                        ret         = OV5640_OK;
-                    }
-                    else if ((x_size == 160U) && (y_size == 120U)) {
-                        *Resolution = OV5640_R160x120;
-                        ret         = OV5640_OK;
-                    }
-                    else {
-                        ret = OV5640_ERROR;
-                    }
-                }
+        for (index = OV5640_R160x120; index <= OV5640_R2592x1944; index++) {
+            if ((x_size == solution_table[index][0]) && (y_size == solution_table[index][1])) {
+                *Resolution = index;
+                ret         = OV5640_OK;
+                break;
             }
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -854,12 +1102,16 @@ int32_t OV5640_SetPolarities(OV5640_Object_t *pObj, uint32_t PclkPolarity, uint3
         ((VsyncPolarity != OV5640_POLARITY_VSYNC_LOW) && (VsyncPolarity != OV5640_POLARITY_VSYNC_HIGH))) {
         ret = OV5640_ERROR;
     }
+    else if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
     else {
         tmp = (uint8_t)(PclkPolarity << 5U) | (HrefPolarity << 1U) | VsyncPolarity;
 
         if (ov5640_write_reg(&pObj->Ctx, OV5640_POLARITY_CTRL, &tmp, 1) != OV5640_OK) {
             ret = OV5640_ERROR;
         }
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     }
 
     return ret;
@@ -881,13 +1133,19 @@ int32_t OV5640_GetPolarities(OV5640_Object_t *pObj, uint32_t *PclkPolarity, uint
     if ((pObj == NULL) || (PclkPolarity == NULL) || (HrefPolarity == NULL) || (VsyncPolarity == NULL)) {
         ret = OV5640_ERROR;
     }
-    else if (ov5640_read_reg(&pObj->Ctx, OV5640_POLARITY_CTRL, &tmp, 1) != OV5640_OK) {
+    else if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
         ret = OV5640_ERROR;
     }
     else {
-        *PclkPolarity  = (tmp >> 5U) & 0x01U;
-        *HrefPolarity  = (tmp >> 1U) & 0x01U;
-        *VsyncPolarity = tmp & 0x01;
+        if (ov5640_read_reg(&pObj->Ctx, OV5640_POLARITY_CTRL, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            *PclkPolarity  = (tmp >> 5U) & 0x01U;
+            *HrefPolarity  = (tmp >> 1U) & 0x01U;
+            *VsyncPolarity = tmp & 0x01;
+        }
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     }
 
     return ret;
@@ -971,11 +1229,10 @@ int32_t OV5640_GetCapabilities(OV5640_Object_t *pObj, OV5640_Capabilities_t *Cap
  */
 int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
     int32_t  ret;
-    uint32_t index;
     uint8_t  tmp;
 
     /* OV5640 Light Mode setting */
-    static const uint16_t OV5640_LightModeAuto[][2] =
+    static const OV5640_RegVal_t OV5640_LightModeAuto[] =
         {
             {OV5640_AWB_MANUAL_CONTROL, 0x00},
             {    OV5640_AWB_R_GAIN_MSB, 0x04},
@@ -986,7 +1243,8 @@ int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
             {    OV5640_AWB_B_GAIN_LSB, 0x00},
     };
 
-    static const uint16_t OV5640_LightModeCloudy[][2] =
+#if (OV5640_CFG_LIGHT_MODES == 1U)
+    static const OV5640_RegVal_t OV5640_LightModeCloudy[] =
         {
             {OV5640_AWB_MANUAL_CONTROL, 0x01},
             {    OV5640_AWB_R_GAIN_MSB, 0x06},
@@ -997,7 +1255,7 @@ int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
             {    OV5640_AWB_B_GAIN_LSB, 0xD3},
     };
 
-    static const uint16_t OV5640_LightModeOffice[][2] =
+    static const OV5640_RegVal_t OV5640_LightModeOffice[] =
         {
             {OV5640_AWB_MANUAL_CONTROL, 0x01},
             {    OV5640_AWB_R_GAIN_MSB, 0x05},
@@ -1008,7 +1266,7 @@ int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
             {    OV5640_AWB_B_GAIN_LSB, 0xCF},
     };
 
-    static const uint16_t OV5640_LightModeHome[][2] =
+    static const OV5640_RegVal_t OV5640_LightModeHome[] =
         {
             {OV5640_AWB_MANUAL_CONTROL, 0x01},
             {    OV5640_AWB_R_GAIN_MSB, 0x04},
@@ -1019,7 +1277,7 @@ int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
             {    OV5640_AWB_B_GAIN_LSB, 0xB6},
     };
 
-    static const uint16_t OV5640_LightModeSunny[][2] =
+    static const OV5640_RegVal_t OV5640_LightModeSunny[] =
         {
             {OV5640_AWB_MANUAL_CONTROL, 0x01},
             {    OV5640_AWB_R_GAIN_MSB, 0x06},
@@ -1029,6 +1287,11 @@ int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
             {    OV5640_AWB_B_GAIN_MSB, 0x04},
             {    OV5640_AWB_B_GAIN_LSB, 0xF3},
     };
+#endif
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
     tmp = 0x00;
     ret = ov5640_write_reg(&pObj->Ctx, OV5640_AWB_MANUAL_CONTROL, &tmp, 1);
@@ -1049,59 +1312,45 @@ int32_t OV5640_SetLightMode(OV5640_Object_t *pObj, uint32_t LightMode) {
 
     if (ret == OV5640_OK) {
         switch (LightMode) {
+#if (OV5640_CFG_LIGHT_MODES == 1U)
         case OV5640_LIGHT_SUNNY:
-            for (index = 0; index < (sizeof(OV5640_LightModeSunny) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_LightModeSunny[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_LightModeSunny[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_LightModeSunny, OV5640_TABLE_LEN(OV5640_LightModeSunny)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_LIGHT_OFFICE:
-            for (index = 0; index < (sizeof(OV5640_LightModeOffice) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_LightModeOffice[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_LightModeOffice[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_LightModeOffice, OV5640_TABLE_LEN(OV5640_LightModeOffice)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_LIGHT_CLOUDY:
-            for (index = 0; index < (sizeof(OV5640_LightModeCloudy) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_LightModeCloudy[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_LightModeCloudy[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_LightModeCloudy, OV5640_TABLE_LEN(OV5640_LightModeCloudy)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         case OV5640_LIGHT_HOME:
-            for (index = 0; index < (sizeof(OV5640_LightModeHome) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_LightModeHome[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_LightModeHome[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_LightModeHome, OV5640_TABLE_LEN(OV5640_LightModeHome)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
+#else
+        case OV5640_LIGHT_SUNNY:
+        case OV5640_LIGHT_OFFICE:
+        case OV5640_LIGHT_CLOUDY:
+        case OV5640_LIGHT_HOME:
+            /* Manual white balance presets compiled out */
+            ret = OV5640_ERROR;
+            break;
+#endif
         case OV5640_LIGHT_AUTO:
         default:
-            for (index = 0; index < (sizeof(OV5640_LightModeAuto) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)OV5640_LightModeAuto[index][1];
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_LightModeAuto[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
+            if (OV5640_WriteTable(pObj, OV5640_LightModeAuto, OV5640_TABLE_LEN(OV5640_LightModeAuto)) != OV5640_OK) {
+                ret = OV5640_ERROR;
             }
             break;
         }
     }
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1115,7 +1364,12 @@ int32_t OV5640_SetColorEffect(OV5640_Object_t *pObj, uint32_t Effect) {
     int32_t ret;
     uint8_t tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     switch (Effect) {
+#if (OV5640_CFG_COLOR_EFFECTS == 1U)
     case OV5640_COLOR_EFFECT_BLUE:
         tmp = 0xFF;
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_ISP_CONTROL01, &tmp, 1);
@@ -1238,6 +1492,17 @@ int32_t OV5640_SetColorEffect(OV5640_Object_t *pObj, uint32_t Effect) {
             ret = OV5640_ERROR;
         }
         break;
+#else
+    case OV5640_COLOR_EFFECT_BLUE:
+    case OV5640_COLOR_EFFECT_RED:
+    case OV5640_COLOR_EFFECT_GREEN:
+    case OV5640_COLOR_EFFECT_BW:
+    case OV5640_COLOR_EFFECT_SEPIA:
+    case OV5640_COLOR_EFFECT_NEGATIVE:
+        /* Color effects compiled out */
+        ret = OV5640_ERROR;
+        break;
+#endif
 
     case OV5640_COLOR_EFFECT_NONE:
     default:
@@ -1256,6 +1521,7 @@ int32_t OV5640_SetColorEffect(OV5640_Object_t *pObj, uint32_t Effect) {
         break;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1270,14 +1536,17 @@ int32_t OV5640_SetColorEffect(OV5640_Object_t *pObj, uint32_t Effect) {
  */
 int32_t OV5640_SetBrightness(OV5640_Object_t *pObj, int32_t Level) {
     int32_t       ret;
-    const uint8_t brightness_level[] = {0x40U, 0x30U, 0x20U, 0x10U, 0x00U, 0x10U, 0x20U, 0x30U, 0x40U};
     uint8_t       tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     tmp = 0xFF;
     ret = ov5640_write_reg(&pObj->Ctx, OV5640_ISP_CONTROL01, &tmp, 1);
 
     if (ret == OV5640_OK) {
-        tmp = brightness_level[Level + 4];
+        tmp = OV5640_BrightnessLevel[Level + 4];
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL7, &tmp, 1);
     }
     if (ret == OV5640_OK) {
@@ -1302,6 +1571,7 @@ int32_t OV5640_SetBrightness(OV5640_Object_t *pObj, int32_t Level) {
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1316,14 +1586,17 @@ int32_t OV5640_SetBrightness(OV5640_Object_t *pObj, int32_t Level) {
  */
 int32_t OV5640_SetSaturation(OV5640_Object_t *pObj, int32_t Level) {
     int32_t       ret;
-    const uint8_t saturation_level[] = {0x00U, 0x10U, 0x20U, 0x30U, 0x40U, 0x50U, 0x60U, 0x70U, 0x80U};
     uint8_t       tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     tmp = 0xFF;
     ret = ov5640_write_reg(&pObj->Ctx, OV5640_ISP_CONTROL01, &tmp, 1);
 
     if (ret == OV5640_OK) {
-        tmp = saturation_level[Level + 4];
+        tmp = OV5640_SaturationLevel[Level + 4];
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL3, &tmp, 1);
     }
     if (ret == OV5640_OK) {
@@ -1344,6 +1617,7 @@ int32_t OV5640_SetSaturation(OV5640_Object_t *pObj, int32_t Level) {
         ret = OV5640_ERROR;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1357,9 +1631,12 @@ int32_t OV5640_SetSaturation(OV5640_Object_t *pObj, int32_t Level) {
  */
 int32_t OV5640_SetContrast(OV5640_Object_t *pObj, int32_t Level) {
     int32_t       ret;
-    const uint8_t contrast_level[] = {0x10U, 0x14U, 0x18U, 0x1CU, 0x20U, 0x24U, 0x28U, 0x2CU, 0x30U};
     uint8_t       tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     tmp = 0xFF;
     ret = ov5640_write_reg(&pObj->Ctx, OV5640_ISP_CONTROL01, &tmp, 1);
 
@@ -1368,7 +1645,7 @@ int32_t OV5640_SetContrast(OV5640_Object_t *pObj, int32_t Level) {
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL0, &tmp, 1);
     }
     if (ret == OV5640_OK) {
-        tmp = contrast_level[Level + 4];
+        tmp = OV5640_ContrastLevel[Level + 4];
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL6, &tmp, 1);
     }
     if (ret == OV5640_OK) {
@@ -1384,6 +1661,7 @@ int32_t OV5640_SetContrast(OV5640_Object_t *pObj, int32_t Level) {
         ret = OV5640_ERROR;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1395,14 +1673,12 @@ int32_t OV5640_SetContrast(OV5640_Object_t *pObj, int32_t Level) {
  */
 int32_t OV5640_SetHueDegree(OV5640_Object_t *pObj, int32_t Degree) {
     int32_t       ret;
-    const uint8_t hue_degree_ctrl1[] = {0x80U, 0x6FU, 0x40U, 0x00U, 0x40U, 0x6FU, 0x80U, 0x6FU, 0x40U, 0x00U, 0x40U,
-                                        0x6FU};
-    const uint8_t hue_degree_ctrl2[] = {0x00U, 0x40U, 0x6FU, 0x80U, 0x6FU, 0x40U, 0x00U, 0x40U, 0x6FU, 0x80U, 0x6FU,
-                                        0x40U};
-    const uint8_t hue_degree_ctrl8[] = {0x32U, 0x32U, 0x32U, 0x02U, 0x02U, 0x02U, 0x01U, 0x01U, 0x01U, 0x31U, 0x31U,
-                                        0x31U};
     uint8_t       tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     tmp = 0xFF;
     ret = ov5640_write_reg(&pObj->Ctx, OV5640_ISP_CONTROL01, &tmp, 1);
 
@@ -1411,15 +1687,15 @@ int32_t OV5640_SetHueDegree(OV5640_Object_t *pObj, int32_t Degree) {
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL0, &tmp, 1);
     }
     if (ret == OV5640_OK) {
-        tmp = hue_degree_ctrl1[Degree + 6];
+        tmp = OV5640_HueCtrl1[Degree + 6];
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL1, &tmp, 1);
     }
     if (ret == OV5640_OK) {
-        tmp = hue_degree_ctrl2[Degree + 6];
+        tmp = OV5640_HueCtrl2[Degree + 6];
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL2, &tmp, 1);
     }
     if (ret == OV5640_OK) {
-        pObj->huedegree = hue_degree_ctrl8[Degree + 6];
+        pObj->huedegree = OV5640_HueCtrl8[Degree + 6];
         tmp             = pObj->contrast | pObj->bright | pObj->huedegree | pObj->saturation;
         ret             = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL8, &tmp, 1);
     }
@@ -1428,43 +1704,156 @@ int32_t OV5640_SetHueDegree(OV5640_Object_t *pObj, int32_t Degree) {
         ret = OV5640_ERROR;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
 /**
- * @brief  Control OV5640 camera mirror/vflip.
- * @param  pObj  pointer to component object
- * @param  Config To configure mirror, flip, both or none
- * @retval Component status
+ * @brief  Compute the registers of an image tuning preset
+ * @note   The SDE values are the ones OV5640_SetBrightness,
+ *         OV5640_SetContrast, OV5640_SetSaturation and OV5640_SetHueDegree
+ *         would leave, composed once so that SDE_CTRL0 to SDE_CTRL8 are sent
+ *         as one burst. Built without bus access.
+ * @param  pLook  pointer to the preset
+ * @param  pRegs  filled with the registers to apply with OV5640_ApplyLook
+ * @retval Component status, OV5640_ERROR when a level is out of range
  */
-int32_t OV5640_MirrorFlipConfig(OV5640_Object_t *pObj, uint32_t Config) {
-    int32_t ret;
-    uint8_t tmp3820 = 0;
-    uint8_t tmp3821;
+int32_t OV5640_ComputeLook(const OV5640_Look_t *pLook, OV5640_LookRegs_t *pRegs) {
+    int32_t ret = OV5640_OK;
 
-    if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_TC_REG20, &tmp3820, 1) != OV5640_OK) {
+    if ((pLook == NULL) || (pRegs == NULL) || (pLook->Brightness < -4) || (pLook->Brightness > 4) ||
+        (pLook->Contrast < -4) || (pLook->Contrast > 4) || (pLook->Saturation < -4) || (pLook->Saturation > 4) ||
+        (pLook->HueDegree < -6) || (pLook->HueDegree > 5)) {
         ret = OV5640_ERROR;
     }
     else {
-        tmp3820 &= 0xF9U;
+        pRegs->Bright    = (pLook->Brightness < 0) ? 0x01U : 0x09U;
+        pRegs->HueDegree = OV5640_HueCtrl8[pLook->HueDegree + 6];
+        pRegs->Sharpness = pLook->Sharpness;
+
+        /* Hue, saturation, contrast and brightness enabled */
+        pRegs->Sde[0]    = 0x07;
+        pRegs->Sde[1]    = OV5640_HueCtrl1[pLook->HueDegree + 6];
+        pRegs->Sde[2]    = OV5640_HueCtrl2[pLook->HueDegree + 6];
+        pRegs->Sde[3]    = OV5640_SaturationLevel[pLook->Saturation + 4];
+        pRegs->Sde[4]    = pRegs->Sde[3];
+        pRegs->Sde[5]    = OV5640_ContrastLevel[pLook->Contrast + 4];
+        pRegs->Sde[6]    = pRegs->Sde[5];
+        pRegs->Sde[7]    = OV5640_BrightnessLevel[pLook->Brightness + 4];
+        pRegs->Sde[8]    = 0x41U | pRegs->Bright | pRegs->HueDegree;
+    }
 
-        if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_TC_REG21, &tmp3821, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-        }
-        else {
-            ret = OV5640_OK;
-            tmp3821 &= 0xF9U;
+    return ret;
+}
 
-            switch (Config) {
-            case OV5640_MIRROR:
-                if (ov5640_write_reg(&pObj->Ctx, OV5640_TIMING_TC_REG20, &tmp3820, 1) != OV5640_OK) {
-                    ret = OV5640_ERROR;
-                }
-                else {
-                    tmp3821 |= 0x06U;
-                    if (ov5640_write_reg(&pObj->Ctx, OV5640_TIMING_TC_REG21, &tmp3821, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
+/**
+ * @brief  Apply the registers of an image tuning preset
+ * @note   The SDE burst and the sharpening registers are written in one
+ *         group hold, or join the open batch. The color effect is replaced.
+ * @param  pObj   pointer to component object
+ * @param  pRegs  registers computed by OV5640_ComputeLook
+ * @retval Component status
+ */
+int32_t OV5640_ApplyLook(OV5640_Object_t *pObj, const OV5640_LookRegs_t *pRegs) {
+    int32_t  ret;
+    uint8_t  sde[OV5640_SDE_SIZE];
+    uint8_t  tmp;
+    uint32_t i;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((pRegs == NULL) || (OV5640_GroupOpen(pObj) != OV5640_OK)) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        return OV5640_ERROR;
+    }
+
+    for (i = 0; i < OV5640_SDE_SIZE; i++) {
+        sde[i] = pRegs->Sde[i];
+    }
+    tmp = 0xFF;
+    ret = ov5640_write_reg(&pObj->Ctx, OV5640_ISP_CONTROL01, &tmp, 1);
+    if (ret == OV5640_OK) {
+        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL0, sde, OV5640_SDE_SIZE);
+    }
+    if ((ret == OV5640_OK) && (pRegs->Sharpness != OV5640_SHARPNESS_KEEP)) {
+        ret = OV5640_WriteSharpness(pObj, pRegs->Sharpness);
+    }
+
+    if ((OV5640_GroupClose(pObj) != OV5640_OK) || (ret != OV5640_OK)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        /* Later single setters compose SDE_CTRL8 from these */
+        pObj->bright     = pRegs->Bright;
+        pObj->huedegree  = pRegs->HueDegree;
+        pObj->contrast   = 0x41;
+        pObj->saturation = 0x41;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Set brightness, contrast, saturation, hue and sharpness at once
+ * @param  pObj   pointer to component object
+ * @param  pLook  pointer to the preset
+ * @retval Component status
+ */
+int32_t OV5640_SetLook(OV5640_Object_t *pObj, const OV5640_Look_t *pLook) {
+    int32_t           ret;
+    OV5640_LookRegs_t regs;
+
+    if (OV5640_ComputeLook(pLook, &regs) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        ret = OV5640_ApplyLook(pObj, &regs);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Control OV5640 camera mirror/vflip.
+ * @param  pObj  pointer to component object
+ * @param  Config To configure mirror, flip, both or none
+ * @retval Component status
+ */
+int32_t OV5640_MirrorFlipConfig(OV5640_Object_t *pObj, uint32_t Config) {
+    int32_t ret;
+    uint8_t tmp3820 = 0;
+    uint8_t tmp3821;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_TC_REG20, &tmp3820, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        tmp3820 &= 0xF9U;
+
+        if (ov5640_read_reg(&pObj->Ctx, OV5640_TIMING_TC_REG21, &tmp3821, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            ret = OV5640_OK;
+            tmp3821 &= 0xF9U;
+
+            switch (Config) {
+            case OV5640_MIRROR:
+                if (ov5640_write_reg(&pObj->Ctx, OV5640_TIMING_TC_REG20, &tmp3820, 1) != OV5640_OK) {
+                    ret = OV5640_ERROR;
+                }
+                else {
+                    tmp3821 |= 0x06U;
+                    if (ov5640_write_reg(&pObj->Ctx, OV5640_TIMING_TC_REG21, &tmp3821, 1) != OV5640_OK) {
+                        ret = OV5640_ERROR;
+                    }
                 }
                 break;
             case OV5640_FLIP:
@@ -1506,6 +1895,9 @@ int32_t OV5640_MirrorFlipConfig(OV5640_Object_t *pObj, uint32_t Config) {
         }
     }
 
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1521,6 +1913,10 @@ int32_t OV5640_ZoomConfig(OV5640_Object_t *pObj, uint32_t Zoom) {
     uint32_t zoom;
     uint8_t  tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     /* Get camera resolution */
     if (OV5640_GetResolution(pObj, &res) != OV5640_OK) {
         ret = OV5640_ERROR;
@@ -1560,6 +1956,7 @@ int32_t OV5640_ZoomConfig(OV5640_Object_t *pObj, uint32_t Zoom) {
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1573,6 +1970,10 @@ int32_t OV5640_NightModeConfig(OV5640_Object_t *pObj, uint32_t Cmd) {
     int32_t ret;
     uint8_t tmp = 0;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     if (Cmd == NIGHT_MODE_ENABLE) {
         /* Auto Frame Rate: 15fps ~ 3.75fps night mode for 60/50Hz light environment,
         24Mhz clock input,24Mhz PCLK*/
@@ -1641,6 +2042,7 @@ int32_t OV5640_NightModeConfig(OV5640_Object_t *pObj, uint32_t Cmd) {
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 /**
@@ -1654,6 +2056,10 @@ int32_t OV5640_EmbeddedSynchroConfig(OV5640_Object_t *pObj, OV5640_SyncCodes_t *
     uint8_t tmp;
     int32_t ret = OV5640_ERROR;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     /*[7] : SYNC code from reg 0x4732-0x4732, [1]: Enable Clip ,[0]: Enable CCIR656 */
     tmp = 0x83;
     if (ov5640_write_reg(&pObj->Ctx, OV5640_CCIR656_CTRL00, &tmp, 1) == OV5640_OK) {
@@ -1661,6 +2067,7 @@ int32_t OV5640_EmbeddedSynchroConfig(OV5640_Object_t *pObj, OV5640_SyncCodes_t *
         if (ov5640_write_reg(&pObj->Ctx, OV5640_CCIR656_FS, &tmp, 1) == OV5640_OK) {
             tmp = pSyncCodes->FrameEndCode;
             if (ov5640_write_reg(&pObj->Ctx, OV5640_CCIR656_FE, &tmp, 1) != OV5640_OK) {
+                OV5640_Unlock(pObj, OV5640_LOCK_ISP);
                 return OV5640_ERROR;
             }
             tmp = pSyncCodes->LineStartCode;
@@ -1689,6 +2096,7 @@ int32_t OV5640_EmbeddedSynchroConfig(OV5640_Object_t *pObj, OV5640_SyncCodes_t *
         ret = ov5640_write_reg(&pObj->Ctx, 0x430A, &tmp, 1);
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 /**
@@ -1701,6 +2109,10 @@ int32_t OV5640_ColorbarModeConfig(OV5640_Object_t *pObj, uint32_t Cmd) {
     int32_t ret;
     uint8_t tmp = 0x40;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     if ((Cmd == COLORBAR_MODE_ENABLE) || (Cmd == COLORBAR_MODE_GRADUALV)) {
         ret = ov5640_write_reg(&pObj->Ctx, OV5640_SDE_CTRL4, &tmp, 1);
         if (ret == OV5640_OK) {
@@ -1723,6 +2135,7 @@ int32_t OV5640_ColorbarModeConfig(OV5640_Object_t *pObj, uint32_t Cmd) {
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1734,68 +2147,35 @@ int32_t OV5640_ColorbarModeConfig(OV5640_Object_t *pObj, uint32_t Cmd) {
  * @retval Component status
  */
 int32_t OV5640_SetPCLK(OV5640_Object_t *pObj, uint32_t ClockValue) {
-    int32_t ret;
-    uint8_t tmp;
+    int32_t         ret = OV5640_OK;
+    OV5640_RegVal_t pll[2];
 
-    switch (ClockValue) {
-    case OV5640_PCLK_7M:
-        tmp = 0x38;
-        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL2, &tmp, 1);
-        tmp = 0x16;
-        ret += ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL3, &tmp, 1);
-        break;
-    case OV5640_PCLK_8M:
-        tmp = 0x40;
-        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL2, &tmp, 1);
-        tmp = 0x16;
-        ret += ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL3, &tmp, 1);
-        break;
-    case OV5640_PCLK_9M:
-        tmp = 0x60;
-        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL2, &tmp, 1);
-        tmp = 0x18;
-        ret += ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL3, &tmp, 1);
-        break;
-    case OV5640_PCLK_12M:
-        tmp = 0x60;
-        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL2, &tmp, 1);
-        tmp = 0x16;
-        ret += ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL3, &tmp, 1);
-        break;
-    case OV5640_PCLK_48M:
-        tmp = 0x60;
-        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL2, &tmp, 1);
-        tmp = 0x03;
-        ret += ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL3, &tmp, 1);
-        break;
-    case OV5640_PCLK_24M:
-    default:
-        tmp = 0x60;
-        ret = ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL2, &tmp, 1);
-        tmp = 0x13;
-        ret += ov5640_write_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL3, &tmp, 1);
-        break;
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
     }
 
-    if (ret != OV5640_OK) {
+    OV5640_GetPCLKRegs(ClockValue, pll);
+    if (OV5640_WriteTable(pObj, pll, OV5640_TABLE_LEN(pll)) != OV5640_OK) {
         ret = OV5640_ERROR;
     }
 
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
+#if (OV5640_CFG_DVP == 1U)
 /**
  * @brief  Enable DVP(Digital Video Port) Mode: Parallel Data Output
  * @param  pObj  pointer to component object
  * @retval Component status
  */
 int OV5640_EnableDVPMode(OV5640_Object_t *pObj) {
-    uint32_t              index;
-    int32_t               ret = OV5640_OK;
-    uint8_t               tmp;
+    int32_t ret = OV5640_OK;
 
 
-    static const uint16_t regs[10][2] = {
+    static const OV5640_RegVal_t regs[] = {
         /* Configure the IO Pad, output FREX/VSYNC/HREF/PCLK/D[9:2]/GPIO0/GPIO1 */
         {OV5640_PAD_OUTPUT_ENABLE01, 0xFF},
         {OV5640_PAD_OUTPUT_ENABLE02, 0xF3},
@@ -1811,24 +2191,19 @@ int OV5640_EnableDVPMode(OV5640_Object_t *pObj) {
         {OV5640_SYSTEM_ROOT_DIVIDER, 0x01},
     };
 
-    for (index = 0; index < sizeof(regs) / 4U; index++) {
-        tmp = (uint8_t)regs[index][1];
-        if (ov5640_write_reg(&pObj->Ctx, regs[index][0], &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-            break;
-        }
+    if (OV5640_WriteTable(pObj, regs, OV5640_TABLE_LEN(regs)) != OV5640_OK) {
+        ret = OV5640_ERROR;
     }
 
     return ret;
 }
+#endif
 
 int OV5640_DisablePADOutput(OV5640_Object_t *pObj) {
-    uint32_t              index;
-    int32_t               ret = OV5640_OK;
-    uint8_t               tmp;
+    int32_t ret = OV5640_OK;
 
 
-    static const uint16_t regs[4][2] =
+    static const OV5640_RegVal_t regs[] =
         {
             /* Configure the IO Pad, output FREX/VSYNC/HREF/PCLK/D[9:2]/GPIO0/GPIO1 */
             {OV5640_PAD_OUTPUT_ENABLE01, 0x00},
@@ -1837,28 +2212,23 @@ int OV5640_DisablePADOutput(OV5640_Object_t *pObj) {
             {       OV5640_PAD_SELECT02,    0},
     };
 
-    for (index = 0; index < sizeof(regs) / 4U; index++) {
-        tmp = (uint8_t)regs[index][1];
-        if (ov5640_write_reg(&pObj->Ctx, regs[index][0], &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-            break;
-        }
+    if (OV5640_WriteTable(pObj, regs, OV5640_TABLE_LEN(regs)) != OV5640_OK) {
+        ret = OV5640_ERROR;
     }
 
     return ret;
 }
 
+#if (OV5640_CFG_MIPI == 1U)
 /**
  * @brief  Enable MIPI (Mobile Industry Processor Interface) Mode: Serial port
  * @param  pObj  pointer to component object
  * @retval Component status
  */
 int32_t OV5640_EnableMIPIMode(OV5640_Object_t *pObj) {
-    int32_t               ret = OV5640_OK;
-    uint8_t               tmp;
-    uint32_t              index;
+    int32_t ret = OV5640_OK;
 
-    static const uint16_t regs[14][2] =
+    static const OV5640_RegVal_t regs[] =
         {
             /* PAD settings */
             {OV5640_PAD_OUTPUT_ENABLE01,    0},
@@ -1879,14 +2249,15 @@ int32_t OV5640_EnableMIPIMode(OV5640_Object_t *pObj) {
             {       OV5640_FRAME_CTRL02, 0x00},
     };
 
-    for (index = 0; index < sizeof(regs) / 4U; index++) {
-        tmp = (uint8_t)regs[index][1];
-        if (ov5640_write_reg(&pObj->Ctx, regs[index][0], &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-            break;
-        }
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_WriteTable(pObj, regs, OV5640_TABLE_LEN(regs)) != OV5640_OK) {
+        ret = OV5640_ERROR;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
     return ret;
 }
 
@@ -1900,6 +2271,10 @@ int32_t OV5640_SetMIPIVirtualChannel(OV5640_Object_t *pObj, uint32_t vchannel) {
     int32_t ret = OV5640_OK;
     uint8_t tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     if (ov5640_read_reg(&pObj->Ctx, 0x4814, &tmp, 1) != OV5640_OK) {
         ret = OV5640_ERROR;
     }
@@ -1911,8 +2286,167 @@ int32_t OV5640_SetMIPIVirtualChannel(OV5640_Object_t *pObj, uint32_t vchannel) {
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Compute the PLL and CSI-2 settings of a MIPI link
+ * @note   The SYSCLK (XCLK / PreDiv * Mult / SysDiv) paces the readout, so it
+ *         is solved like the DVP PCLK: the lowest SYSCLK reaching
+ *         OV5640_MIPI_SCLK_RATIO x PClk, ties broken by the lowest VCO. The
+ *         lanes then carry the SYSCLK / MipiDiv bits per second each, with
+ *         MipiDiv = Lanes x OV5640_MIPI_SCLK_RATIO / OV5640_MIPI_BITS so that
+ *         they drain exactly the bytes read out. The root divider stays at 2
+ *         as in OV5640_EnableMIPIMode. For a 24MHz XCLK the preset 28MB/s on
+ *         2 lanes gives its VCO of 224MHz, MipiDiv 2, 112Mbps per lane and a
+ *         35ns period. Rates needing a SYSCLK above OV5640_MIPI_SCLK_MAX or a
+ *         lane above OV5640_MIPI_LANE_RATE_MAX are rejected.
+ * @param  pConfig  pointer to the link request
+ * @param  pLink    filled with the settings, no register is accessed
+ * @retval Component status
+ */
+int32_t OV5640_ComputeMIPI(const OV5640_MIPIConfig_t *pConfig, OV5640_MIPILink_t *pLink) {
+    int32_t  ret  = OV5640_OK;
+    uint64_t target;
+    uint64_t best = 0;
+    uint64_t best_vco = 0;
+    uint64_t mult;
+    uint64_t vco;
+    uint64_t sclk;
+    uint32_t div;
+    uint32_t pre;
+    uint32_t sys;
+
+    if ((pConfig == NULL) || (pLink == NULL) || (pConfig->XClk == 0U) || (pConfig->PClk < OV5640_MIPI_PCLK_MIN) ||
+        (pConfig->Lanes < 1U) || (pConfig->Lanes > 2U) || (pConfig->Continuous > OV5640_MIPI_CLOCK_CONTINUOUS) ||
+        (pConfig->VirtualChannel > OV5640_MIPI_VC_MAX)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        target = (uint64_t)pConfig->PClk * OV5640_MIPI_SCLK_RATIO;
+        div    = ((uint32_t)pConfig->Lanes * OV5640_MIPI_SCLK_RATIO) / OV5640_MIPI_BITS;
+
+        for (pre = 0; pre < sizeof(OV5640_PLLPreDiv); pre++) {
+            for (sys = 1U; sys <= OV5640_PLL_SYSDIV_MAX; sys++) {
+                /* Smallest multiplier reaching the target */
+                mult = ((target * OV5640_PLLPreDiv[pre] * sys) + pConfig->XClk - 1U) / pConfig->XClk;
+                if (mult < OV5640_PLL_MULT_MIN) {
+                    mult = OV5640_PLL_MULT_MIN;
+                }
+                if ((mult > 127U) && ((mult & 1U) != 0U)) {
+                    mult++;
+                }
+
+                vco  = ((uint64_t)pConfig->XClk * mult) / OV5640_PLLPreDiv[pre];
+                sclk = vco / sys;
+
+                if ((mult <= OV5640_PLL_MULT_MAX) && (vco >= OV5640_MIPI_VCO_MIN) && (vco <= OV5640_PLL_VCO_MAX) &&
+                    (sclk <= OV5640_MIPI_SCLK_MAX) && ((sclk / div) <= OV5640_MIPI_LANE_RATE_MAX) &&
+                    ((best == 0U) || (sclk < best) || ((sclk == best) && (vco < best_vco)))) {
+                    pLink->PreDiv = OV5640_PLLPreDiv[pre];
+                    pLink->Mult   = (uint8_t)mult;
+                    pLink->SysDiv = (uint8_t)sys;
+                    best          = sclk;
+                    best_vco      = vco;
+                }
+            }
+        }
+
+        if (best == 0U) {
+            /* Not reachable within the VCO, SYSCLK and lane rate limits */
+            ret = OV5640_ERROR;
+        }
+        else {
+            pLink->MipiDiv        = (uint8_t)div;
+            pLink->LaneRate       = (uint32_t)(best / div);
+            pLink->PClkPeriod     = (uint8_t)(8000000000ULL / ((uint64_t)pLink->LaneRate * pConfig->Lanes));
+            pLink->Lanes          = pConfig->Lanes;
+            pLink->Continuous     = pConfig->Continuous;
+            pLink->VirtualChannel = pConfig->VirtualChannel;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Apply the settings of a MIPI link
+ * @note   Call after OV5640_Init in SERIAL_MODE with the stream stopped.
+ *         The virtual channel is kept across a later OV5640_Init.
+ * @param  pObj   pointer to component object
+ * @param  pLink  settings computed by OV5640_ComputeMIPI
+ * @retval Component status
+ */
+int32_t OV5640_ApplyMIPI(OV5640_Object_t *pObj, const OV5640_MIPILink_t *pLink) {
+    int32_t         ret = OV5640_OK;
+    OV5640_RegVal_t regs[9];
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((pLink == NULL) || (pLink->LaneRate == 0U) || (pLink->Lanes < 1U) || (pLink->Lanes > 2U) ||
+        (pLink->VirtualChannel > OV5640_MIPI_VC_MAX)) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        return OV5640_ERROR;
+    }
+
+    /* Lane mode [7:5]: 010 two lanes, 000 one lane; MIPI enabled */
+    regs[0].Reg   = OV5640_MIPI_CONTROL00;
+    regs[0].Value = (pLink->Lanes == 2U) ? 0x45U : 0x05U;
+    regs[1].Reg   = OV5640_PAD_OUTPUT_VALUE00;
+    regs[1].Value = 0x70;
+    /* SC_PLL_CONTRL0 ~ 3 go out as one burst */
+    regs[2].Reg   = OV5640_SC_PLL_CONTRL0;
+    regs[2].Value = 0x18;
+    regs[3].Reg   = OV5640_SC_PLL_CONTRL1;
+    regs[3].Value = (uint8_t)((pLink->SysDiv << 4) | pLink->MipiDiv);
+    regs[4].Reg   = OV5640_SC_PLL_CONTRL2;
+    regs[4].Value = pLink->Mult;
+    regs[5].Reg   = OV5640_SC_PLL_CONTRL3;
+    regs[5].Value = (uint8_t)(((OV5640_MIPI_ROOT_DIV - 1U) << 4) | pLink->PreDiv);
+    /* Bit 5 gates the clock lane between packets */
+    regs[6].Reg   = OV5640_MIPI_CTRL00;
+    regs[6].Value = (pLink->Continuous == OV5640_MIPI_CLOCK_CONTINUOUS) ? 0x04U : 0x24U;
+    regs[7].Reg   = 0x4814;
+    regs[7].Value = (uint8_t)((0x2aU & 0x3FU) | (pLink->VirtualChannel << 6));
+    regs[8].Reg   = OV5640_PCLK_PERIOD;
+    regs[8].Value = pLink->PClkPeriod;
+
+    if (OV5640_WriteTable(pObj, regs, OV5640_TABLE_LEN(regs)) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->VirtualChannelID = pLink->VirtualChannel;
+        /* The PLL no longer matches the last mode profile */
+        pObj->pProfile = NULL;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Set the lanes, rate, clock mode and virtual channel of the MIPI link
+ * @param  pObj     pointer to component object
+ * @param  pConfig  pointer to the link request
+ * @retval Component status
+ */
+int32_t OV5640_SetMIPIConfig(OV5640_Object_t *pObj, const OV5640_MIPIConfig_t *pConfig) {
+    int32_t           ret;
+    OV5640_MIPILink_t link;
+
+    if (OV5640_ComputeMIPI(pConfig, &link) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        ret = OV5640_ApplyMIPI(pObj, &link);
+    }
+
     return ret;
 }
+#endif
 
 /**
  * @brief  Start camera
@@ -1920,10 +2454,18 @@ int32_t OV5640_SetMIPIVirtualChannel(OV5640_Object_t *pObj, uint32_t vchannel) {
  * @retval Component status
  */
 int32_t OV5640_Start(OV5640_Object_t *pObj) {
+    int32_t ret;
     uint8_t tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     tmp = 0x2;
-    return ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1);
+    ret = ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1);
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
 }
 
 /**
@@ -1932,10 +2474,18 @@ int32_t OV5640_Start(OV5640_Object_t *pObj) {
  * @retval Component status
  */
 int32_t OV5640_Stop(OV5640_Object_t *pObj) {
+    int32_t ret;
     uint8_t tmp;
 
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     tmp = 0x42;
-    return ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1);
+    ret = ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1);
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
 }
 
 
@@ -1948,568 +2498,1689 @@ int32_t OV5640_Stop(OV5640_Object_t *pObj) {
  */
 /**
  * @brief This function provides accurate delay (in milliseconds)
+ * @note  The IO Delay hook is used when provided (OV5640_USE_DELAY_HOOK) so
+ *        that the calling thread sleeps, otherwise the delay busy-waits on
+ *        IO GetTick.
  * @param pObj   pointer to component object
  * @param Delay  specifies the delay time length, in milliseconds
- * @retval OV5640_OK
+ * @retval Component status
  */
 static int32_t OV5640_Delay(OV5640_Object_t *pObj, uint32_t Delay) {
     uint32_t tickstart;
+    int32_t  ret = OV5640_OK;
+
+#if (OV5640_USE_DELAY_HOOK == 1U)
+    if (pObj->IO.Delay != NULL) {
+        if (pObj->IO.Delay(Delay) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+    else {
+        tickstart = pObj->IO.GetTick();
+        while ((pObj->IO.GetTick() - tickstart) < Delay) {
+        }
+    }
+#else
     tickstart = pObj->IO.GetTick();
     while ((pObj->IO.GetTick() - tickstart) < Delay) {
     }
-    return OV5640_OK;
+#endif
+    return ret;
 }
 
+#if (OV5640_CFG_AF == 1U) || (OV5640_USE_ASYNC_IO == 1U)
 /**
- * @brief  Wrap component ReadReg to Bus Read function
- * @param  handle  Component object handle
- * @param  Reg  The target register address to write
- * @param  pData  The target register value to be written
- * @param  Length  buffer size to be written
- * @retval error status
+ * @brief  Write a block of consecutive registers using the sensor address
+ *         auto-increment, split in bursts of at most pObj->BurstSize bytes
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values to be written
+ * @param  Length  number of bytes to be written
+ * @retval Component status
  */
-static int32_t OV5640_ReadRegWrap(void *handle, uint16_t Reg, uint8_t *pData, uint16_t Length) {
-    OV5640_Object_t *pObj = (OV5640_Object_t *)handle;
+static int32_t OV5640_WriteBurst(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint32_t Length) {
+    int32_t  ret = OV5640_OK;
+    uint32_t chunk;
+    uint32_t burst;
+
+    burst = (pObj->BurstSize == 0U) ? 1U : pObj->BurstSize;
+
+    while ((Length > 0U) && (ret == OV5640_OK)) {
+        chunk = (Length > burst) ? burst : Length;
+
+        if (ov5640_write_reg(&pObj->Ctx, Reg, (uint8_t *)pData, (uint16_t)chunk) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            Reg += (uint16_t)chunk;
+            pData += chunk;
+            Length -= chunk;
+        }
+    }
 
-    return pObj->IO.ReadReg(pObj->IO.Address, Reg, pData, Length);
+    return ret;
 }
+#endif
 
+#if (OV5640_CFG_AF == 1U)
 /**
- * @brief  Wrap component WriteReg to Bus Write function
- * @param  handle  Component object handle
- * @param  Reg  The target register address to write
- * @param  pData  The target register value to be written
- * @param  Length  buffer size to be written
- * @retval error status
+ * @brief  Terminate the autofocus sequence and report its status
+ * @param  pObj   pointer to component object
+ * @param  State  final sequence state
  */
-static int32_t OV5640_WriteRegWrap(void *handle, uint16_t Reg, uint8_t *pData, uint16_t Length) {
-    OV5640_Object_t *pObj = (OV5640_Object_t *)handle;
+static void OV5640_AF_Finish(OV5640_Object_t *pObj, uint8_t State) {
+    pObj->AF.State = State;
+    if (pObj->AF.Callback != NULL) {
+        pObj->AF.Callback(pObj->AF.pArg, (State == OV5640_AF_DONE) ? OV5640_OK : OV5640_ERROR);
+    }
+}
 
-    return pObj->IO.WriteReg(pObj->IO.Address, Reg, pData, Length);
+/**
+ * @brief  Block until the autofocus sequence in progress is over
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+static int32_t OV5640_AF_Wait(OV5640_Object_t *pObj) {
+    (void)OV5640_AF_Process(pObj);
+    while (pObj->AF.State == OV5640_AF_BUSY) {
+        (void)OV5640_Delay(pObj, 5);
+        (void)OV5640_AF_Process(pObj);
+    }
+    return (pObj->AF.State == OV5640_AF_DONE) ? OV5640_OK : OV5640_ERROR;
 }
 
 /**
- * @}
+ * @brief  Tell whether an AF MCU register holds its completion value
+ * @param  pObj    pointer to component object
+ * @param  Reg     0x3029 (focus status) or 0x3023 (command ack)
+ * @param  Value   value reported once the command is over
+ * @param  pReady  set to 1 when done, 0 otherwise or on bus error
+ * @retval Component status
  */
+static int32_t OV5640_AF_ReadAck(OV5640_Object_t *pObj, uint16_t Reg, uint8_t Value, uint8_t *pReady) {
+    int32_t ret = OV5640_OK;
+    uint8_t temp;
 
-static uint16_t ov5640_uxga_init_reg_tbl[][2] = {
-    // 24MHz input clock, 24MHz PCLK
-    {0x3008, 0x42}, // software power down, bit[6]
-    {0x3103, 0x03}, // system clock from PLL, bit[1]
-    {0x3017, 0xff}, // FREX, Vsync, HREF, PCLK, D[9:6] output enable
-    {0x3018, 0xff}, // D[5:0], GPIO[1:0] output enable
-    {0x3034, 0x1a}, // MIPI 10-bit
-    {0x3037, 0x13}, // PLL root divider, bit[4], PLL pre-divider, bit[3:0]
-    {0x3108, 0x01}, // PCLK root divider, bit[5:4], SCLK2x root divider, bit[3:2]
+    *pReady = 0U;
+    if (ov5640_read_reg(&pObj->Ctx, Reg, &temp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (temp == Value) {
+        *pReady = 1U;
+    }
 
-    // SCLK root divider, bit[1:0]
-    {0x3630, 0x36},
-    {0x3631, 0x0e},
-    {0x3632, 0xe2},
-    {0x3633, 0x12},
-    {0x3621, 0xe0},
-    {0x3704, 0xa0},
-    {0x3703, 0x5a},
-    {0x3715, 0x78},
-    {0x3717, 0x01},
-    {0x370b, 0x60},
-    {0x3705, 0x1a},
-    {0x3905, 0x02},
-    {0x3906, 0x10},
-    {0x3901, 0x0a},
-    {0x3731, 0x12},
-    {0x3600, 0x08}, // VCM control
-    {0x3601, 0x33}, // VCM control
-    {0x302d, 0x60}, // system control
-    {0x3620, 0x52},
-    {0x371b, 0x20},
-    {0x471c, 0x50},
-    {0x3a13, 0x43}, // pre-gain = 1.047x
-    {0x3a18, 0x00}, // gain ceiling
-    {0x3a19, 0xf8}, // gain ceiling = 15.5x
-    {0x3635, 0x13},
-    {0x3636, 0x03},
-    {0x3634, 0x40},
-    {0x3622, 0x01},
-    // 50/60Hz detection 50/60Hz 灯光条纹过滤
-    {0x3c01, 0x34}, // Band auto, bit[7]
-    {0x3c04, 0x28}, // threshold low sum
-    {0x3c05, 0x98}, // threshold high sum
-    {0x3c06, 0x00}, // light meter 1 threshold[15:8]
-    {0x3c07, 0x08}, // light meter 1 threshold[7:0]
-    {0x3c08, 0x00}, // light meter 2 threshold[15:8]
-    {0x3c09, 0x1c}, // light meter 2 threshold[7:0]
-    {0x3c0a, 0x9c}, // sample number[15:8]
-    {0x3c0b, 0x40}, // sample number[7:0]
-    {0x3810, 0x00}, // Timing Hoffset[11:8]
-    {0x3811, 0x10}, // Timing Hoffset[7:0]
-    {0x3812, 0x00}, // Timing Voffset[10:8]
-    {0x3708, 0x64},
-    {0x4001, 0x02}, // BLC start from line 2
-    {0x4005, 0x1a}, // BLC always update
-    {0x3000, 0x00}, // enable blocks
-    {0x3004, 0xff}, // enable clocks
-    {0x300e, 0x58}, // MIPI power down, DVP enable
-    {0x302e, 0x00},
-    {0x4300, 0x30}, // YUV 422, YUYV
-    {0x501f, 0x00}, // YUV 422
-    {0x440e, 0x00},
-    {0x5000, 0xa7}, // Lenc on, raw gamma on, BPC on, WPC on, CIP on
-    // AEC target 自动曝光控制
-    {0x3a0f, 0x30}, // stable range in high
-    {0x3a10, 0x28}, // stable range in low
-    {0x3a1b, 0x30}, // stable range out high
-    {0x3a1e, 0x26}, // stable range out low
-    {0x3a11, 0x60}, // fast zone high
-    {0x3a1f, 0x14}, // fast zone low
-    // Lens correction for ? 镜头补偿
-    {0x5800, 0x23},
-    {0x5801, 0x14},
-    {0x5802, 0x0f},
-    {0x5803, 0x0f},
-    {0x5804, 0x12},
-    {0x5805, 0x26},
-    {0x5806, 0x0c},
-    {0x5807, 0x08},
-    {0x5808, 0x05},
-    {0x5809, 0x05},
-    {0x580a, 0x08},
-
-    {0x580b, 0x0d},
-    {0x580c, 0x08},
-    {0x580d, 0x03},
-    {0x580e, 0x00},
-    {0x580f, 0x00},
-    {0x5810, 0x03},
-    {0x5811, 0x09},
-    {0x5812, 0x07},
-    {0x5813, 0x03},
-    {0x5814, 0x00},
-    {0x5815, 0x01},
-    {0x5816, 0x03},
-    {0x5817, 0x08},
-    {0x5818, 0x0d},
-    {0x5819, 0x08},
-    {0x581a, 0x05},
-    {0x581b, 0x06},
-    {0x581c, 0x08},
-    {0x581d, 0x0e},
-    {0x581e, 0x29},
-    {0x581f, 0x17},
-    {0x5820, 0x11},
-    {0x5821, 0x11},
-    {0x5822, 0x15},
-    {0x5823, 0x28},
-    {0x5824, 0x46},
-    {0x5825, 0x26},
-    {0x5826, 0x08},
-    {0x5827, 0x26},
-    {0x5828, 0x64},
-    {0x5829, 0x26},
-    {0x582a, 0x24},
-    {0x582b, 0x22},
-    {0x582c, 0x24},
-    {0x582d, 0x24},
-    {0x582e, 0x06},
-    {0x582f, 0x22},
-    {0x5830, 0x40},
-    {0x5831, 0x42},
-    {0x5832, 0x24},
-    {0x5833, 0x26},
-    {0x5834, 0x24},
-    {0x5835, 0x22},
-    {0x5836, 0x22},
-    {0x5837, 0x26},
-    {0x5838, 0x44},
-    {0x5839, 0x24},
-    {0x583a, 0x26},
-    {0x583b, 0x28},
-    {0x583c, 0x42},
-    {0x583d, 0xce}, // lenc BR offset
-    // AWB 自动白平衡
-    {0x5180, 0xff}, // AWB B block
-    {0x5181, 0xf2}, // AWB control
-    {0x5182, 0x00}, // [7:4] max local counter, [3:0] max fast counter
-    {0x5183, 0x14}, // AWB advanced
-    {0x5184, 0x25},
-    {0x5185, 0x24},
-    {0x5186, 0x09},
-    {0x5187, 0x09},
-    {0x5188, 0x09},
-    {0x5189, 0x75},
-    {0x518a, 0x54},
-    {0x518b, 0xe0},
-    {0x518c, 0xb2},
-    {0x518d, 0x42},
-    {0x518e, 0x3d},
-    {0x518f, 0x56},
-    {0x5190, 0x46},
-    {0x5191, 0xf8}, // AWB top limit
-    {0x5192, 0x04}, // AWB bottom limit
-    {0x5193, 0x70}, // red limit
-    {0x5194, 0xf0}, // green limit
-    {0x5195, 0xf0}, // blue limit
-    {0x5196, 0x03}, // AWB control
-    {0x5197, 0x01}, // local limit
-    {0x5198, 0x04},
-    {0x5199, 0x12},
-    {0x519a, 0x04},
-    {0x519b, 0x00},
-    {0x519c, 0x06},
-    {0x519d, 0x82},
-    {0x519e, 0x38}, // AWB control
-    // Gamma 伽玛曲线
-    {0x5480, 0x01}, // Gamma bias plus on, bit[0]
-    {0x5481, 0x08},
-    {0x5482, 0x14},
-    {0x5483, 0x28},
-    {0x5484, 0x51},
-    {0x5485, 0x65},
-    {0x5486, 0x71},
-    {0x5487, 0x7d},
-    {0x5488, 0x87},
-    {0x5489, 0x91},
-    {0x548a, 0x9a},
-    {0x548b, 0xaa},
-    {0x548c, 0xb8},
-    {0x548d, 0xcd},
-    {0x548e, 0xdd},
-    {0x548f, 0xea},
-    {0x5490, 0x1d},
-    // color matrix 色彩矩阵
-    {0x5381, 0x1e}, // CMX1 for Y
-    {0x5382, 0x5b}, // CMX2 for Y
-    {0x5383, 0x08}, // CMX3 for Y
-    {0x5384, 0x0a}, // CMX4 for U
-    {0x5385, 0x7e}, // CMX5 for U
-    {0x5386, 0x88}, // CMX6 for U
-    {0x5387, 0x7c}, // CMX7 for V
-    {0x5388, 0x6c}, // CMX8 for V
-    {0x5389, 0x10}, // CMX9 for V
-    {0x538a, 0x01}, // sign[9]
-    {0x538b, 0x98}, // sign[8:1]
-    // UV adjust UV 色彩饱和度调整
-    {0x5580, 0x06}, // saturation on, bit[1]
-    {0x5583, 0x40},
-    {0x5584, 0x10},
-    {0x5589, 0x10},
-    {0x558a, 0x00},
-    {0x558b, 0xf8},
-    {0x501d, 0x40}, // enable manual offset of contrast
-    // CIP 锐化和降噪
-    {0x5300, 0x08}, // CIP sharpen MT threshold 1
-    {0x5301, 0x30}, // CIP sharpen MT threshold 2
-    {0x5302, 0x10}, // CIP sharpen MT offset 1
-    {0x5303, 0x00}, // CIP sharpen MT offset 2
-    {0x5304, 0x08}, // CIP DNS threshold 1
-    {0x5305, 0x30}, // CIP DNS threshold 2
-    {0x5306, 0x08}, // CIP DNS offset 1
-    {0x5307, 0x16}, // CIP DNS offset 2
-    {0x5309, 0x08}, // CIP sharpen TH threshold 1
-    {0x530a, 0x30}, // CIP sharpen TH threshold 2
-    {0x530b, 0x04}, // CIP sharpen TH offset 1
-    {0x530c, 0x06}, // CIP sharpen TH offset 2
-    {0x5025, 0x00},
-    {0x3008, 0x02}, // wake up from standby, bit[6]
-    // 自行添加的设置
-    {0x4740, 0X21}, // VSYNC 高有效
-};
+    return ret;
+}
+#endif
 
-static uint16_t OV5640_jpeg_reg_tbl[][2] = {
-    {0x4300, 0x30}, // YUV 422, YUYV
-    {0x501f, 0x00}, // YUV 422
-    // Input clock = 24Mhz
-    {0x3035, 0x21}, // PLL
-    {0x3036, 0x69}, // PLL
-    {0x3c07, 0x07}, // lightmeter 1 threshold[7:0]
-    {0x3820, 0x46}, // flip
-    {0x3821, 0x20}, // mirror
-    {0x3814, 0x11}, // timing X inc
-    {0x3815, 0x11}, // timing Y inc
-    {0x3800, 0x00}, // HS
-    {0x3801, 0x00}, // HS
-    {0x3802, 0x00}, // VS
-    {0x3803, 0x00}, // VS
-    {0x3804, 0x0a}, // HW (HE)
-    {0x3805, 0x3f}, // HW (HE)
-    {0x3806, 0x07}, // VH (VE)
-    {0x3807, 0x9f}, // VH (VE)
+/**
+ * @brief  Start holding register writes in the default group bank
+ * @note   Does nothing while a batch is open, the writes join the batch.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+static int32_t OV5640_GroupOpen(OV5640_Object_t *pObj) {
+    OV5640_RegVal_t hold[] = {
+        {OV5640_SRM_GROUP_ACCESS, OV5640_GROUP_HOLD_START(OV5640_GROUP_DEFAULT)}
+    };
 
-    {0x3808, 0x02}, // DVPHO
-    {0x3809, 0x80}, // DVPHO
-    {0x380a, 0x01}, // DVPVO
-    {0x380b, 0xe0}, // DVPVO
+    return (pObj->GroupActive != 0U) ? OV5640_OK : OV5640_WriteTable(pObj, hold, OV5640_TABLE_LEN(hold));
+}
 
-    {0x380c, 0x0b}, // HTS 		//
-    {0x380d, 0x1c}, // HTS
-    {0x380e, 0x07}, // VTS 		//
-    {0x380f, 0xb0}, // VTS
-    {0x3813, 0x04}, // timing V offset   04
-    {0x3618, 0x04},
-    {0x3612, 0x2b},
-    {0x3709, 0x12},
-    {0x370c, 0x00},
+/**
+ * @brief  Close and quick launch the default group bank
+ * @note   Does nothing while a batch is open, OV5640_CommitBatch launches it.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+static int32_t OV5640_GroupClose(OV5640_Object_t *pObj) {
+    OV5640_RegVal_t launch[] = {
+        {OV5640_SRM_GROUP_ACCESS,      OV5640_GROUP_HOLD_END(OV5640_GROUP_DEFAULT)},
+        {OV5640_SRM_GROUP_ACCESS, OV5640_GROUP_QUICK_LAUNCH(OV5640_GROUP_DEFAULT)}
+    };
 
-    {0x4004, 0x06}, // BLC line number
-    {0x3002, 0x00}, // enable JFIFO, SFIFO, JPG
-    {0x3006, 0xff}, // enable clock of JPEG2x, JPEG
-    {0x4713, 0x03}, // JPEG mode 3
-    {0x4407, 0x01}, // Quantization sacle
-    {0x460b, 0x35},
-    {0x460c, 0x22},
-    {0x4837, 0x16}, // MIPI global timing
-    {0x3824, 0x02}, // PCLK manual divider
-    {0x5001, 0xA3}, // SDE on, Scaling on, CMX on, AWB on
-    {0x3503, 0x00}, // AEC/AGC on
-};
+    return (pObj->GroupActive != 0U) ? OV5640_OK : OV5640_WriteTable(pObj, launch, OV5640_TABLE_LEN(launch));
+}
 
-static uint16_t ov5640_rgb565_reg_tbl[][2] = {
-    {0x4300, 0X6F},
-    {0X501F, 0x01},
-    // 1280x800, 15fps
-    // input clock 24Mhz, PCLK 42Mhz
-    {0x3035, 0x41}, // PLL
-    {0x3036, 0x69}, // PLL
-    {0x3c07, 0x07}, // lightmeter 1 threshold[7:0]
-    {0x3820, 0x46}, // flip
-    {0x3821, 0x00}, // mirror
-    {0x3814, 0x31}, // timing X inc
-    {0x3815, 0x31}, // timing Y inc
-    {0x3800, 0x00}, // HS
-    {0x3801, 0x00}, // HS
-    {0x3802, 0x00}, // VS
-    {0x3803, 0x00}, // VS
-    {0x3804, 0x0a}, // HW (HE)
-    {0x3805, 0x3f}, // HW (HE)
-    {0x3806, 0x06}, // VH (VE)
-    {0x3807, 0xa9}, // VH (VE)
-    {0x3808, 0x05}, // DVPHO
-    {0x3809, 0x00}, // DVPHO
-    {0x380a, 0x02}, // DVPVO
-    {0x380b, 0xd0}, // DVPVO
-    {0x380c, 0x05}, // HTS
-    {0x380d, 0xF8}, // HTS
-    {0x380e, 0x03}, // VTS
-    {0x380f, 0x84}, // VTS
-    {0x3813, 0x04}, // timing V offset
-    {0x3618, 0x00},
-    {0x3612, 0x29},
-    {0x3709, 0x52},
-    {0x370c, 0x03},
-    {0x3a02, 0x02}, // 60Hz max exposure
-    {0x3a03, 0xe0}, // 60Hz max exposure
+/**
+ * @brief  Write one burst through a group bank latched on the next frame
+ * @note   The manual exposure banks alternate, so a burst can be staged
+ *         while the previous one still waits for its frame. Inside a batch
+ *         the burst joins it and OV5640_CommitBatch launches it.
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   register values
+ * @param  Length  number of registers
+ * @retval Component status
+ */
+static int32_t OV5640_GroupWriteDelayed(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    int32_t ret  = OV5640_OK;
+    uint8_t bank = pObj->AEC.Bank;
+    uint8_t tmp;
 
-    {0x3a14, 0x02}, // 50Hz max exposure
-    {0x3a15, 0xe0}, // 50Hz max exposure
-    {0x4004, 0x02}, // BLC line number
-    {0x3002, 0x1c}, // reset JFIFO, SFIFO, JPG
-    {0x3006, 0xc3}, // disable clock of JPEG2x, JPEG
-    {0x4713, 0x03}, // JPEG mode 3
-    {0x4407, 0x04}, // Quantization scale
-    {0x460b, 0x37},
-    {0x460c, 0x20},
-    {0x4837, 0x16}, // MIPI global timing
-    {0x3824, 0x04}, // PCLK manual divider
-    {0x5001, 0xA3}, // SDE on, scale on, UV average off, color matrix on, AWB on
-    {0x3503, 0x00}, // AEC/AGC on
-};
+    if (pObj->GroupActive != 0U) {
+        ret = ov5640_write_reg(&pObj->Ctx, Reg, pData, Length);
+    }
+    else {
+        tmp = OV5640_GROUP_HOLD_START(bank);
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_SRM_GROUP_ACCESS, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            if (ov5640_write_reg(&pObj->Ctx, Reg, pData, Length) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
 
-uint16_t solution_table[][2] = {
-    { 160,  120}, // QQVGA
-    { 320,  240}, // QVGA
-    { 480,  272}, // PSP
-    { 640,  480}, // VGA
-    { 800,  480}, // WVGA
-    { 800,  600}, // SVGA
-    {1024,  768}, // XGA
-    {1280,  800}, // WXGA
-    {1440,  900}, // WXGA+
-    {1280, 1024}, // SXGA
-    {1600, 1200}, // UXGA
-    {1920, 1080}, // 1080P
-    {2048, 1536}, // QXGA
-    {2100, 1575}, // 500W
-};
+            tmp = OV5640_GROUP_HOLD_END(bank);
+            if (ov5640_write_reg(&pObj->Ctx, OV5640_SRM_GROUP_ACCESS, &tmp, 1) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else if (ret == OV5640_OK) {
+                tmp = OV5640_GROUP_DELAY_LAUNCH(bank);
+                ret = ov5640_write_reg(&pObj->Ctx, OV5640_SRM_GROUP_ACCESS, &tmp, 1);
+            }
+        }
 
+        pObj->AEC.Bank = (bank == OV5640_AEC_BANK_FIRST) ? OV5640_AEC_BANK_SECOND : OV5640_AEC_BANK_FIRST;
+    }
 
+    return (ret == OV5640_OK) ? OV5640_OK : OV5640_ERROR;
+}
 
-const uint8_t OV5640_AF_Config[] = {
-    0x02, 0x0f, 0xd6, 0x02, 0x0a, 0x39, 0xc2, 0x01, 0x22, 0x22, 0x00, 0x02, 0x0f, 0xb2, 0xe5, 0x1f, // 0x8000,
-    0x70, 0x72, 0xf5, 0x1e, 0xd2, 0x35, 0xff, 0xef, 0x25, 0xe0, 0x24, 0x4e, 0xf8, 0xe4, 0xf6, 0x08, // 0x8010,
-    0xf6, 0x0f, 0xbf, 0x34, 0xf2, 0x90, 0x0e, 0x93, 0xe4, 0x93, 0xff, 0xe5, 0x4b, 0xc3, 0x9f, 0x50, // 0x8020,
-    0x04, 0x7f, 0x05, 0x80, 0x02, 0x7f, 0xfb, 0x78, 0xbd, 0xa6, 0x07, 0x12, 0x0f, 0x04, 0x40, 0x04, // 0x8030,
-    0x7f, 0x03, 0x80, 0x02, 0x7f, 0x30, 0x78, 0xbc, 0xa6, 0x07, 0xe6, 0x18, 0xf6, 0x08, 0xe6, 0x78, // 0x8040,
-    0xb9, 0xf6, 0x78, 0xbc, 0xe6, 0x78, 0xba, 0xf6, 0x78, 0xbf, 0x76, 0x33, 0xe4, 0x08, 0xf6, 0x78, // 0x8050,
-    0xb8, 0x76, 0x01, 0x75, 0x4a, 0x02, 0x78, 0xb6, 0xf6, 0x08, 0xf6, 0x74, 0xff, 0x78, 0xc1, 0xf6, // 0x8060,
-    0x08, 0xf6, 0x75, 0x1f, 0x01, 0x78, 0xbc, 0xe6, 0x75, 0xf0, 0x05, 0xa4, 0xf5, 0x4b, 0x12, 0x0a, // 0x8070,
-    0xff, 0xc2, 0x37, 0x22, 0x78, 0xb8, 0xe6, 0xd3, 0x94, 0x00, 0x40, 0x02, 0x16, 0x22, 0xe5, 0x1f, // 0x8080,
-    0xb4, 0x05, 0x23, 0xe4, 0xf5, 0x1f, 0xc2, 0x01, 0x78, 0xb6, 0xe6, 0xfe, 0x08, 0xe6, 0xff, 0x78, // 0x8090,
-    0x4e, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0xa2, 0x37, 0xe4, 0x33, 0xf5, 0x3c, 0x90, 0x30, 0x28, 0xf0, // 0x80a0,
-    0x75, 0x1e, 0x10, 0xd2, 0x35, 0x22, 0xe5, 0x4b, 0x75, 0xf0, 0x05, 0x84, 0x78, 0xbc, 0xf6, 0x90, // 0x80b0,
-    0x0e, 0x8c, 0xe4, 0x93, 0xff, 0x25, 0xe0, 0x24, 0x0a, 0xf8, 0xe6, 0xfc, 0x08, 0xe6, 0xfd, 0x78, // 0x80c0,
-    0xbc, 0xe6, 0x25, 0xe0, 0x24, 0x4e, 0xf8, 0xa6, 0x04, 0x08, 0xa6, 0x05, 0xef, 0x12, 0x0f, 0x0b, // 0x80d0,
-    0xd3, 0x78, 0xb7, 0x96, 0xee, 0x18, 0x96, 0x40, 0x0d, 0x78, 0xbc, 0xe6, 0x78, 0xb9, 0xf6, 0x78, // 0x80e0,
-    0xb6, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x90, 0x0e, 0x8c, 0xe4, 0x93, 0x12, 0x0f, 0x0b, 0xc3, 0x78, // 0x80f0,
-    0xc2, 0x96, 0xee, 0x18, 0x96, 0x50, 0x0d, 0x78, 0xbc, 0xe6, 0x78, 0xba, 0xf6, 0x78, 0xc1, 0xa6, // 0x8100,
-    0x06, 0x08, 0xa6, 0x07, 0x78, 0xb6, 0xe6, 0xfe, 0x08, 0xe6, 0xc3, 0x78, 0xc2, 0x96, 0xff, 0xee, // 0x8110,
-    0x18, 0x96, 0x78, 0xc3, 0xf6, 0x08, 0xa6, 0x07, 0x90, 0x0e, 0x95, 0xe4, 0x18, 0x12, 0x0e, 0xe9, // 0x8120,
-    0x40, 0x02, 0xd2, 0x37, 0x78, 0xbc, 0xe6, 0x08, 0x26, 0x08, 0xf6, 0xe5, 0x1f, 0x64, 0x01, 0x70, // 0x8130,
-    0x4a, 0xe6, 0xc3, 0x78, 0xc0, 0x12, 0x0e, 0xdf, 0x40, 0x05, 0x12, 0x0e, 0xda, 0x40, 0x39, 0x12, // 0x8140,
-    0x0f, 0x02, 0x40, 0x04, 0x7f, 0xfe, 0x80, 0x02, 0x7f, 0x02, 0x78, 0xbd, 0xa6, 0x07, 0x78, 0xb9, // 0x8150,
-    0xe6, 0x24, 0x03, 0x78, 0xbf, 0xf6, 0x78, 0xb9, 0xe6, 0x24, 0xfd, 0x78, 0xc0, 0xf6, 0x12, 0x0f, // 0x8160,
-    0x02, 0x40, 0x06, 0x78, 0xc0, 0xe6, 0xff, 0x80, 0x04, 0x78, 0xbf, 0xe6, 0xff, 0x78, 0xbe, 0xa6, // 0x8170,
-    0x07, 0x75, 0x1f, 0x02, 0x78, 0xb8, 0x76, 0x01, 0x02, 0x02, 0x4a, 0xe5, 0x1f, 0x64, 0x02, 0x60, // 0x8180,
-    0x03, 0x02, 0x02, 0x2a, 0x78, 0xbe, 0xe6, 0xff, 0xc3, 0x78, 0xc0, 0x12, 0x0e, 0xe0, 0x40, 0x08, // 0x8190,
-    0x12, 0x0e, 0xda, 0x50, 0x03, 0x02, 0x02, 0x28, 0x12, 0x0f, 0x02, 0x40, 0x04, 0x7f, 0xff, 0x80, // 0x81a0,
-    0x02, 0x7f, 0x01, 0x78, 0xbd, 0xa6, 0x07, 0x78, 0xb9, 0xe6, 0x04, 0x78, 0xbf, 0xf6, 0x78, 0xb9, // 0x81b0,
-    0xe6, 0x14, 0x78, 0xc0, 0xf6, 0x18, 0x12, 0x0f, 0x04, 0x40, 0x04, 0xe6, 0xff, 0x80, 0x02, 0x7f, // 0x81c0,
-    0x00, 0x78, 0xbf, 0xa6, 0x07, 0xd3, 0x08, 0xe6, 0x64, 0x80, 0x94, 0x80, 0x40, 0x04, 0xe6, 0xff, // 0x81d0,
-    0x80, 0x02, 0x7f, 0x00, 0x78, 0xc0, 0xa6, 0x07, 0xc3, 0x18, 0xe6, 0x64, 0x80, 0x94, 0xb3, 0x50, // 0x81e0,
-    0x04, 0xe6, 0xff, 0x80, 0x02, 0x7f, 0x33, 0x78, 0xbf, 0xa6, 0x07, 0xc3, 0x08, 0xe6, 0x64, 0x80, // 0x81f0,
-    0x94, 0xb3, 0x50, 0x04, 0xe6, 0xff, 0x80, 0x02, 0x7f, 0x33, 0x78, 0xc0, 0xa6, 0x07, 0x12, 0x0f, // 0x8200,
-    0x02, 0x40, 0x06, 0x78, 0xc0, 0xe6, 0xff, 0x80, 0x04, 0x78, 0xbf, 0xe6, 0xff, 0x78, 0xbe, 0xa6, // 0x8210,
-    0x07, 0x75, 0x1f, 0x03, 0x78, 0xb8, 0x76, 0x01, 0x80, 0x20, 0xe5, 0x1f, 0x64, 0x03, 0x70, 0x26, // 0x8220,
-    0x78, 0xbe, 0xe6, 0xff, 0xc3, 0x78, 0xc0, 0x12, 0x0e, 0xe0, 0x40, 0x05, 0x12, 0x0e, 0xda, 0x40, // 0x8230,
-    0x09, 0x78, 0xb9, 0xe6, 0x78, 0xbe, 0xf6, 0x75, 0x1f, 0x04, 0x78, 0xbe, 0xe6, 0x75, 0xf0, 0x05, // 0x8240,
-    0xa4, 0xf5, 0x4b, 0x02, 0x0a, 0xff, 0xe5, 0x1f, 0xb4, 0x04, 0x10, 0x90, 0x0e, 0x94, 0xe4, 0x78, // 0x8250,
-    0xc3, 0x12, 0x0e, 0xe9, 0x40, 0x02, 0xd2, 0x37, 0x75, 0x1f, 0x05, 0x22, 0x30, 0x01, 0x03, 0x02, // 0x8260,
-    0x04, 0xc0, 0x30, 0x02, 0x03, 0x02, 0x04, 0xc0, 0x90, 0x51, 0xa5, 0xe0, 0x78, 0x93, 0xf6, 0xa3, // 0x8270,
-    0xe0, 0x08, 0xf6, 0xa3, 0xe0, 0x08, 0xf6, 0xe5, 0x1f, 0x70, 0x3c, 0x75, 0x1e, 0x20, 0xd2, 0x35, // 0x8280,
-    0x12, 0x0c, 0x7a, 0x78, 0x7e, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x78, 0x8b, 0xa6, 0x09, 0x18, 0x76, // 0x8290,
-    0x01, 0x12, 0x0c, 0x5b, 0x78, 0x4e, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x78, 0x8b, 0xe6, 0x78, 0x6e, // 0x82a0,
-    0xf6, 0x75, 0x1f, 0x01, 0x78, 0x93, 0xe6, 0x78, 0x90, 0xf6, 0x78, 0x94, 0xe6, 0x78, 0x91, 0xf6, // 0x82b0,
-    0x78, 0x95, 0xe6, 0x78, 0x92, 0xf6, 0x22, 0x79, 0x90, 0xe7, 0xd3, 0x78, 0x93, 0x96, 0x40, 0x05, // 0x82c0,
-    0xe7, 0x96, 0xff, 0x80, 0x08, 0xc3, 0x79, 0x93, 0xe7, 0x78, 0x90, 0x96, 0xff, 0x78, 0x88, 0x76, // 0x82d0,
-    0x00, 0x08, 0xa6, 0x07, 0x79, 0x91, 0xe7, 0xd3, 0x78, 0x94, 0x96, 0x40, 0x05, 0xe7, 0x96, 0xff, // 0x82e0,
-    0x80, 0x08, 0xc3, 0x79, 0x94, 0xe7, 0x78, 0x91, 0x96, 0xff, 0x12, 0x0c, 0x8e, 0x79, 0x92, 0xe7, // 0x82f0,
-    0xd3, 0x78, 0x95, 0x96, 0x40, 0x05, 0xe7, 0x96, 0xff, 0x80, 0x08, 0xc3, 0x79, 0x95, 0xe7, 0x78, // 0x8300,
-    0x92, 0x96, 0xff, 0x12, 0x0c, 0x8e, 0x12, 0x0c, 0x5b, 0x78, 0x8a, 0xe6, 0x25, 0xe0, 0x24, 0x4e, // 0x8310,
-    0xf8, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x78, 0x8a, 0xe6, 0x24, 0x6e, 0xf8, 0xa6, 0x09, 0x78, 0x8a, // 0x8320,
-    0xe6, 0x24, 0x01, 0xff, 0xe4, 0x33, 0xfe, 0xd3, 0xef, 0x94, 0x0f, 0xee, 0x64, 0x80, 0x94, 0x80, // 0x8330,
-    0x40, 0x04, 0x7f, 0x00, 0x80, 0x05, 0x78, 0x8a, 0xe6, 0x04, 0xff, 0x78, 0x8a, 0xa6, 0x07, 0xe5, // 0x8340,
-    0x1f, 0xb4, 0x01, 0x0a, 0xe6, 0x60, 0x03, 0x02, 0x04, 0xc0, 0x75, 0x1f, 0x02, 0x22, 0x12, 0x0c, // 0x8350,
-    0x7a, 0x78, 0x80, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x12, 0x0c, 0x7a, 0x78, 0x82, 0xa6, 0x06, 0x08, // 0x8360,
-    0xa6, 0x07, 0x78, 0x6e, 0xe6, 0x78, 0x8c, 0xf6, 0x78, 0x6e, 0xe6, 0x78, 0x8d, 0xf6, 0x7f, 0x01, // 0x8370,
-    0xef, 0x25, 0xe0, 0x24, 0x4f, 0xf9, 0xc3, 0x78, 0x81, 0xe6, 0x97, 0x18, 0xe6, 0x19, 0x97, 0x50, // 0x8380,
-    0x0a, 0x12, 0x0c, 0x82, 0x78, 0x80, 0xa6, 0x04, 0x08, 0xa6, 0x05, 0x74, 0x6e, 0x2f, 0xf9, 0x78, // 0x8390,
-    0x8c, 0xe6, 0xc3, 0x97, 0x50, 0x08, 0x74, 0x6e, 0x2f, 0xf8, 0xe6, 0x78, 0x8c, 0xf6, 0xef, 0x25, // 0x83a0,
-    0xe0, 0x24, 0x4f, 0xf9, 0xd3, 0x78, 0x83, 0xe6, 0x97, 0x18, 0xe6, 0x19, 0x97, 0x40, 0x0a, 0x12, // 0x83b0,
-    0x0c, 0x82, 0x78, 0x82, 0xa6, 0x04, 0x08, 0xa6, 0x05, 0x74, 0x6e, 0x2f, 0xf9, 0x78, 0x8d, 0xe6, // 0x83c0,
-    0xd3, 0x97, 0x40, 0x08, 0x74, 0x6e, 0x2f, 0xf8, 0xe6, 0x78, 0x8d, 0xf6, 0x0f, 0xef, 0x64, 0x10, // 0x83d0,
-    0x70, 0x9e, 0xc3, 0x79, 0x81, 0xe7, 0x78, 0x83, 0x96, 0xff, 0x19, 0xe7, 0x18, 0x96, 0x78, 0x84, // 0x83e0,
-    0xf6, 0x08, 0xa6, 0x07, 0xc3, 0x79, 0x8c, 0xe7, 0x78, 0x8d, 0x96, 0x08, 0xf6, 0xd3, 0x79, 0x81, // 0x83f0,
-    0xe7, 0x78, 0x7f, 0x96, 0x19, 0xe7, 0x18, 0x96, 0x40, 0x05, 0x09, 0xe7, 0x08, 0x80, 0x06, 0xc3, // 0x8400,
-    0x79, 0x7f, 0xe7, 0x78, 0x81, 0x96, 0xff, 0x19, 0xe7, 0x18, 0x96, 0xfe, 0x78, 0x86, 0xa6, 0x06, // 0x8410,
-    0x08, 0xa6, 0x07, 0x79, 0x8c, 0xe7, 0xd3, 0x78, 0x8b, 0x96, 0x40, 0x05, 0xe7, 0x96, 0xff, 0x80, // 0x8420,
-    0x08, 0xc3, 0x79, 0x8b, 0xe7, 0x78, 0x8c, 0x96, 0xff, 0x78, 0x8f, 0xa6, 0x07, 0xe5, 0x1f, 0x64, // 0x8430,
-    0x02, 0x70, 0x69, 0x90, 0x0e, 0x91, 0x93, 0xff, 0x18, 0xe6, 0xc3, 0x9f, 0x50, 0x72, 0x12, 0x0c, // 0x8440,
-    0x4a, 0x12, 0x0c, 0x2f, 0x90, 0x0e, 0x8e, 0x12, 0x0c, 0x38, 0x78, 0x80, 0x12, 0x0c, 0x6b, 0x7b, // 0x8450,
-    0x04, 0x12, 0x0c, 0x1d, 0xc3, 0x12, 0x06, 0x45, 0x50, 0x56, 0x90, 0x0e, 0x92, 0xe4, 0x93, 0xff, // 0x8460,
-    0x78, 0x8f, 0xe6, 0x9f, 0x40, 0x02, 0x80, 0x11, 0x90, 0x0e, 0x90, 0xe4, 0x93, 0xff, 0xd3, 0x78, // 0x8470,
-    0x89, 0xe6, 0x9f, 0x18, 0xe6, 0x94, 0x00, 0x40, 0x03, 0x75, 0x1f, 0x05, 0x12, 0x0c, 0x4a, 0x12, // 0x8480,
-    0x0c, 0x2f, 0x90, 0x0e, 0x8f, 0x12, 0x0c, 0x38, 0x78, 0x7e, 0x12, 0x0c, 0x6b, 0x7b, 0x40, 0x12, // 0x8490,
-    0x0c, 0x1d, 0xd3, 0x12, 0x06, 0x45, 0x40, 0x18, 0x75, 0x1f, 0x05, 0x22, 0xe5, 0x1f, 0xb4, 0x05, // 0x84a0,
-    0x0f, 0xd2, 0x01, 0xc2, 0x02, 0xe4, 0xf5, 0x1f, 0xf5, 0x1e, 0xd2, 0x35, 0xd2, 0x33, 0xd2, 0x36, // 0x84b0,
-    0x22, 0xef, 0x8d, 0xf0, 0xa4, 0xa8, 0xf0, 0xcf, 0x8c, 0xf0, 0xa4, 0x28, 0xce, 0x8d, 0xf0, 0xa4, // 0x84c0,
-    0x2e, 0xfe, 0x22, 0xbc, 0x00, 0x0b, 0xbe, 0x00, 0x29, 0xef, 0x8d, 0xf0, 0x84, 0xff, 0xad, 0xf0, // 0x84d0,
-    0x22, 0xe4, 0xcc, 0xf8, 0x75, 0xf0, 0x08, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xec, 0x33, 0xfc, // 0x84e0,
-    0xee, 0x9d, 0xec, 0x98, 0x40, 0x05, 0xfc, 0xee, 0x9d, 0xfe, 0x0f, 0xd5, 0xf0, 0xe9, 0xe4, 0xce, // 0x84f0,
-    0xfd, 0x22, 0xed, 0xf8, 0xf5, 0xf0, 0xee, 0x84, 0x20, 0xd2, 0x1c, 0xfe, 0xad, 0xf0, 0x75, 0xf0, // 0x8500,
-    0x08, 0xef, 0x2f, 0xff, 0xed, 0x33, 0xfd, 0x40, 0x07, 0x98, 0x50, 0x06, 0xd5, 0xf0, 0xf2, 0x22, // 0x8510,
-    0xc3, 0x98, 0xfd, 0x0f, 0xd5, 0xf0, 0xea, 0x22, 0xe8, 0x8f, 0xf0, 0xa4, 0xcc, 0x8b, 0xf0, 0xa4, // 0x8520,
-    0x2c, 0xfc, 0xe9, 0x8e, 0xf0, 0xa4, 0x2c, 0xfc, 0x8a, 0xf0, 0xed, 0xa4, 0x2c, 0xfc, 0xea, 0x8e, // 0x8530,
-    0xf0, 0xa4, 0xcd, 0xa8, 0xf0, 0x8b, 0xf0, 0xa4, 0x2d, 0xcc, 0x38, 0x25, 0xf0, 0xfd, 0xe9, 0x8f, // 0x8540,
-    0xf0, 0xa4, 0x2c, 0xcd, 0x35, 0xf0, 0xfc, 0xeb, 0x8e, 0xf0, 0xa4, 0xfe, 0xa9, 0xf0, 0xeb, 0x8f, // 0x8550,
-    0xf0, 0xa4, 0xcf, 0xc5, 0xf0, 0x2e, 0xcd, 0x39, 0xfe, 0xe4, 0x3c, 0xfc, 0xea, 0xa4, 0x2d, 0xce, // 0x8560,
-    0x35, 0xf0, 0xfd, 0xe4, 0x3c, 0xfc, 0x22, 0x75, 0xf0, 0x08, 0x75, 0x82, 0x00, 0xef, 0x2f, 0xff, // 0x8570,
-    0xee, 0x33, 0xfe, 0xcd, 0x33, 0xcd, 0xcc, 0x33, 0xcc, 0xc5, 0x82, 0x33, 0xc5, 0x82, 0x9b, 0xed, // 0x8580,
-    0x9a, 0xec, 0x99, 0xe5, 0x82, 0x98, 0x40, 0x0c, 0xf5, 0x82, 0xee, 0x9b, 0xfe, 0xed, 0x9a, 0xfd, // 0x8590,
-    0xec, 0x99, 0xfc, 0x0f, 0xd5, 0xf0, 0xd6, 0xe4, 0xce, 0xfb, 0xe4, 0xcd, 0xfa, 0xe4, 0xcc, 0xf9, // 0x85a0,
-    0xa8, 0x82, 0x22, 0xb8, 0x00, 0xc1, 0xb9, 0x00, 0x59, 0xba, 0x00, 0x2d, 0xec, 0x8b, 0xf0, 0x84, // 0x85b0,
-    0xcf, 0xce, 0xcd, 0xfc, 0xe5, 0xf0, 0xcb, 0xf9, 0x78, 0x18, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, // 0x85c0,
-    0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc, 0xeb, 0x33, 0xfb, 0x10, 0xd7, 0x03, 0x99, 0x40, 0x04, 0xeb, // 0x85d0,
-    0x99, 0xfb, 0x0f, 0xd8, 0xe5, 0xe4, 0xf9, 0xfa, 0x22, 0x78, 0x18, 0xef, 0x2f, 0xff, 0xee, 0x33, // 0x85e0,
-    0xfe, 0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc, 0xc9, 0x33, 0xc9, 0x10, 0xd7, 0x05, 0x9b, 0xe9, 0x9a, // 0x85f0,
-    0x40, 0x07, 0xec, 0x9b, 0xfc, 0xe9, 0x9a, 0xf9, 0x0f, 0xd8, 0xe0, 0xe4, 0xc9, 0xfa, 0xe4, 0xcc, // 0x8600,
-    0xfb, 0x22, 0x75, 0xf0, 0x10, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xcc, 0x33, // 0x8610,
-    0xcc, 0xc8, 0x33, 0xc8, 0x10, 0xd7, 0x07, 0x9b, 0xec, 0x9a, 0xe8, 0x99, 0x40, 0x0a, 0xed, 0x9b, // 0x8620,
-    0xfd, 0xec, 0x9a, 0xfc, 0xe8, 0x99, 0xf8, 0x0f, 0xd5, 0xf0, 0xda, 0xe4, 0xcd, 0xfb, 0xe4, 0xcc, // 0x8630,
-    0xfa, 0xe4, 0xc8, 0xf9, 0x22, 0xeb, 0x9f, 0xf5, 0xf0, 0xea, 0x9e, 0x42, 0xf0, 0xe9, 0x9d, 0x42, // 0x8640,
-    0xf0, 0xe8, 0x9c, 0x45, 0xf0, 0x22, 0xe8, 0x60, 0x0f, 0xec, 0xc3, 0x13, 0xfc, 0xed, 0x13, 0xfd, // 0x8650,
-    0xee, 0x13, 0xfe, 0xef, 0x13, 0xff, 0xd8, 0xf1, 0x22, 0xe8, 0x60, 0x0f, 0xef, 0xc3, 0x33, 0xff, // 0x8660,
-    0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc, 0xd8, 0xf1, 0x22, 0xe4, 0x93, 0xfc, 0x74, // 0x8670,
-    0x01, 0x93, 0xfd, 0x74, 0x02, 0x93, 0xfe, 0x74, 0x03, 0x93, 0xff, 0x22, 0xe6, 0xfb, 0x08, 0xe6, // 0x8680,
-    0xf9, 0x08, 0xe6, 0xfa, 0x08, 0xe6, 0xcb, 0xf8, 0x22, 0xec, 0xf6, 0x08, 0xed, 0xf6, 0x08, 0xee, // 0x8690,
-    0xf6, 0x08, 0xef, 0xf6, 0x22, 0xa4, 0x25, 0x82, 0xf5, 0x82, 0xe5, 0xf0, 0x35, 0x83, 0xf5, 0x83, // 0x86a0,
-    0x22, 0xd0, 0x83, 0xd0, 0x82, 0xf8, 0xe4, 0x93, 0x70, 0x12, 0x74, 0x01, 0x93, 0x70, 0x0d, 0xa3, // 0x86b0,
-    0xa3, 0x93, 0xf8, 0x74, 0x01, 0x93, 0xf5, 0x82, 0x88, 0x83, 0xe4, 0x73, 0x74, 0x02, 0x93, 0x68, // 0x86c0,
-    0x60, 0xef, 0xa3, 0xa3, 0xa3, 0x80, 0xdf, 0x90, 0x38, 0x04, 0x78, 0x52, 0x12, 0x0b, 0xfd, 0x90, // 0x86d0,
-    0x38, 0x00, 0xe0, 0xfe, 0xa3, 0xe0, 0xfd, 0xed, 0xff, 0xc3, 0x12, 0x0b, 0x9e, 0x90, 0x38, 0x10, // 0x86e0,
-    0x12, 0x0b, 0x92, 0x90, 0x38, 0x06, 0x78, 0x54, 0x12, 0x0b, 0xfd, 0x90, 0x38, 0x02, 0xe0, 0xfe, // 0x86f0,
-    0xa3, 0xe0, 0xfd, 0xed, 0xff, 0xc3, 0x12, 0x0b, 0x9e, 0x90, 0x38, 0x12, 0x12, 0x0b, 0x92, 0xa3, // 0x8700,
-    0xe0, 0xb4, 0x31, 0x07, 0x78, 0x52, 0x79, 0x52, 0x12, 0x0c, 0x13, 0x90, 0x38, 0x14, 0xe0, 0xb4, // 0x8710,
-    0x71, 0x15, 0x78, 0x52, 0xe6, 0xfe, 0x08, 0xe6, 0x78, 0x02, 0xce, 0xc3, 0x13, 0xce, 0x13, 0xd8, // 0x8720,
-    0xf9, 0x79, 0x53, 0xf7, 0xee, 0x19, 0xf7, 0x90, 0x38, 0x15, 0xe0, 0xb4, 0x31, 0x07, 0x78, 0x54, // 0x8730,
-    0x79, 0x54, 0x12, 0x0c, 0x13, 0x90, 0x38, 0x15, 0xe0, 0xb4, 0x71, 0x15, 0x78, 0x54, 0xe6, 0xfe, // 0x8740,
-    0x08, 0xe6, 0x78, 0x02, 0xce, 0xc3, 0x13, 0xce, 0x13, 0xd8, 0xf9, 0x79, 0x55, 0xf7, 0xee, 0x19, // 0x8750,
-    0xf7, 0x79, 0x52, 0x12, 0x0b, 0xd9, 0x09, 0x12, 0x0b, 0xd9, 0xaf, 0x47, 0x12, 0x0b, 0xb2, 0xe5, // 0x8760,
-    0x44, 0xfb, 0x7a, 0x00, 0xfd, 0x7c, 0x00, 0x12, 0x04, 0xd3, 0x78, 0x5a, 0xa6, 0x06, 0x08, 0xa6, // 0x8770,
-    0x07, 0xaf, 0x45, 0x12, 0x0b, 0xb2, 0xad, 0x03, 0x7c, 0x00, 0x12, 0x04, 0xd3, 0x78, 0x56, 0xa6, // 0x8780,
-    0x06, 0x08, 0xa6, 0x07, 0xaf, 0x48, 0x78, 0x54, 0x12, 0x0b, 0xb4, 0xe5, 0x43, 0xfb, 0xfd, 0x7c, // 0x8790,
-    0x00, 0x12, 0x04, 0xd3, 0x78, 0x5c, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0xaf, 0x46, 0x7e, 0x00, 0x78, // 0x87a0,
-    0x54, 0x12, 0x0b, 0xb6, 0xad, 0x03, 0x7c, 0x00, 0x12, 0x04, 0xd3, 0x78, 0x58, 0xa6, 0x06, 0x08, // 0x87b0,
-    0xa6, 0x07, 0xc3, 0x78, 0x5b, 0xe6, 0x94, 0x08, 0x18, 0xe6, 0x94, 0x00, 0x50, 0x05, 0x76, 0x00, // 0x87c0,
-    0x08, 0x76, 0x08, 0xc3, 0x78, 0x5d, 0xe6, 0x94, 0x08, 0x18, 0xe6, 0x94, 0x00, 0x50, 0x05, 0x76, // 0x87d0,
-    0x00, 0x08, 0x76, 0x08, 0x78, 0x5a, 0x12, 0x0b, 0xc6, 0xff, 0xd3, 0x78, 0x57, 0xe6, 0x9f, 0x18, // 0x87e0,
-    0xe6, 0x9e, 0x40, 0x0e, 0x78, 0x5a, 0xe6, 0x13, 0xfe, 0x08, 0xe6, 0x78, 0x57, 0x12, 0x0c, 0x08, // 0x87f0,
-    0x80, 0x04, 0x7e, 0x00, 0x7f, 0x00, 0x78, 0x5e, 0x12, 0x0b, 0xbe, 0xff, 0xd3, 0x78, 0x59, 0xe6, // 0x8800,
-    0x9f, 0x18, 0xe6, 0x9e, 0x40, 0x0e, 0x78, 0x5c, 0xe6, 0x13, 0xfe, 0x08, 0xe6, 0x78, 0x59, 0x12, // 0x8810,
-    0x0c, 0x08, 0x80, 0x04, 0x7e, 0x00, 0x7f, 0x00, 0xe4, 0xfc, 0xfd, 0x78, 0x62, 0x12, 0x06, 0x99, // 0x8820,
-    0x78, 0x5a, 0x12, 0x0b, 0xc6, 0x78, 0x57, 0x26, 0xff, 0xee, 0x18, 0x36, 0xfe, 0x78, 0x66, 0x12, // 0x8830,
-    0x0b, 0xbe, 0x78, 0x59, 0x26, 0xff, 0xee, 0x18, 0x36, 0xfe, 0xe4, 0xfc, 0xfd, 0x78, 0x6a, 0x12, // 0x8840,
-    0x06, 0x99, 0x12, 0x0b, 0xce, 0x78, 0x66, 0x12, 0x06, 0x8c, 0xd3, 0x12, 0x06, 0x45, 0x40, 0x08, // 0x8850,
-    0x12, 0x0b, 0xce, 0x78, 0x66, 0x12, 0x06, 0x99, 0x78, 0x54, 0x12, 0x0b, 0xd0, 0x78, 0x6a, 0x12, // 0x8860,
-    0x06, 0x8c, 0xd3, 0x12, 0x06, 0x45, 0x40, 0x0a, 0x78, 0x54, 0x12, 0x0b, 0xd0, 0x78, 0x6a, 0x12, // 0x8870,
-    0x06, 0x99, 0x78, 0x61, 0xe6, 0x90, 0x60, 0x01, 0xf0, 0x78, 0x65, 0xe6, 0xa3, 0xf0, 0x78, 0x69, // 0x8880,
-    0xe6, 0xa3, 0xf0, 0x78, 0x55, 0xe6, 0xa3, 0xf0, 0x7d, 0x01, 0x78, 0x61, 0x12, 0x0b, 0xe9, 0x24, // 0x8890,
-    0x01, 0x12, 0x0b, 0xa6, 0x78, 0x65, 0x12, 0x0b, 0xe9, 0x24, 0x02, 0x12, 0x0b, 0xa6, 0x78, 0x69, // 0x88a0,
-    0x12, 0x0b, 0xe9, 0x24, 0x03, 0x12, 0x0b, 0xa6, 0x78, 0x6d, 0x12, 0x0b, 0xe9, 0x24, 0x04, 0x12, // 0x88b0,
-    0x0b, 0xa6, 0x0d, 0xbd, 0x05, 0xd4, 0xc2, 0x0e, 0xc2, 0x06, 0x22, 0x85, 0x08, 0x41, 0x90, 0x30, // 0x88c0,
-    0x24, 0xe0, 0xf5, 0x3d, 0xa3, 0xe0, 0xf5, 0x3e, 0xa3, 0xe0, 0xf5, 0x3f, 0xa3, 0xe0, 0xf5, 0x40, // 0x88d0,
-    0xa3, 0xe0, 0xf5, 0x3c, 0xd2, 0x34, 0xe5, 0x41, 0x12, 0x06, 0xb1, 0x09, 0x31, 0x03, 0x09, 0x35, // 0x88e0,
-    0x04, 0x09, 0x3b, 0x05, 0x09, 0x3e, 0x06, 0x09, 0x41, 0x07, 0x09, 0x4a, 0x08, 0x09, 0x5b, 0x12, // 0x88f0,
-    0x09, 0x73, 0x18, 0x09, 0x89, 0x19, 0x09, 0x5e, 0x1a, 0x09, 0x6a, 0x1b, 0x09, 0xad, 0x80, 0x09, // 0x8900,
-    0xb2, 0x81, 0x0a, 0x1d, 0x8f, 0x0a, 0x09, 0x90, 0x0a, 0x1d, 0x91, 0x0a, 0x1d, 0x92, 0x0a, 0x1d, // 0x8910,
-    0x93, 0x0a, 0x1d, 0x94, 0x0a, 0x1d, 0x98, 0x0a, 0x17, 0x9f, 0x0a, 0x1a, 0xec, 0x00, 0x00, 0x0a, // 0x8920,
-    0x38, 0x12, 0x0f, 0x74, 0x22, 0x12, 0x0f, 0x74, 0xd2, 0x03, 0x22, 0xd2, 0x03, 0x22, 0xc2, 0x03, // 0x8930,
-    0x22, 0xa2, 0x37, 0xe4, 0x33, 0xf5, 0x3c, 0x02, 0x0a, 0x1d, 0xc2, 0x01, 0xc2, 0x02, 0xc2, 0x03, // 0x8940,
-    0x12, 0x0d, 0x0d, 0x75, 0x1e, 0x70, 0xd2, 0x35, 0x02, 0x0a, 0x1d, 0x02, 0x0a, 0x04, 0x85, 0x40, // 0x8950,
-    0x4a, 0x85, 0x3c, 0x4b, 0x12, 0x0a, 0xff, 0x02, 0x0a, 0x1d, 0x85, 0x4a, 0x40, 0x85, 0x4b, 0x3c, // 0x8960,
-    0x02, 0x0a, 0x1d, 0xe4, 0xf5, 0x22, 0xf5, 0x23, 0x85, 0x40, 0x31, 0x85, 0x3f, 0x30, 0x85, 0x3e, // 0x8970,
-    0x2f, 0x85, 0x3d, 0x2e, 0x12, 0x0f, 0x46, 0x80, 0x1f, 0x75, 0x22, 0x00, 0x75, 0x23, 0x01, 0x74, // 0x8980,
-    0xff, 0xf5, 0x2d, 0xf5, 0x2c, 0xf5, 0x2b, 0xf5, 0x2a, 0x12, 0x0f, 0x46, 0x85, 0x2d, 0x40, 0x85, // 0x8990,
-    0x2c, 0x3f, 0x85, 0x2b, 0x3e, 0x85, 0x2a, 0x3d, 0xe4, 0xf5, 0x3c, 0x80, 0x70, 0x12, 0x0f, 0x16, // 0x89a0,
-    0x80, 0x6b, 0x85, 0x3d, 0x45, 0x85, 0x3e, 0x46, 0xe5, 0x47, 0xc3, 0x13, 0xff, 0xe5, 0x45, 0xc3, // 0x89b0,
-    0x9f, 0x50, 0x02, 0x8f, 0x45, 0xe5, 0x48, 0xc3, 0x13, 0xff, 0xe5, 0x46, 0xc3, 0x9f, 0x50, 0x02, // 0x89c0,
-    0x8f, 0x46, 0xe5, 0x47, 0xc3, 0x13, 0xff, 0xfd, 0xe5, 0x45, 0x2d, 0xfd, 0xe4, 0x33, 0xfc, 0xe5, // 0x89d0,
-    0x44, 0x12, 0x0f, 0x90, 0x40, 0x05, 0xe5, 0x44, 0x9f, 0xf5, 0x45, 0xe5, 0x48, 0xc3, 0x13, 0xff, // 0x89e0,
-    0xfd, 0xe5, 0x46, 0x2d, 0xfd, 0xe4, 0x33, 0xfc, 0xe5, 0x43, 0x12, 0x0f, 0x90, 0x40, 0x05, 0xe5, // 0x89f0,
-    0x43, 0x9f, 0xf5, 0x46, 0x12, 0x06, 0xd7, 0x80, 0x14, 0x85, 0x40, 0x48, 0x85, 0x3f, 0x47, 0x85, // 0x8a00,
-    0x3e, 0x46, 0x85, 0x3d, 0x45, 0x80, 0x06, 0x02, 0x06, 0xd7, 0x12, 0x0d, 0x7e, 0x90, 0x30, 0x24, // 0x8a10,
-    0xe5, 0x3d, 0xf0, 0xa3, 0xe5, 0x3e, 0xf0, 0xa3, 0xe5, 0x3f, 0xf0, 0xa3, 0xe5, 0x40, 0xf0, 0xa3, // 0x8a20,
-    0xe5, 0x3c, 0xf0, 0x90, 0x30, 0x23, 0xe4, 0xf0, 0x22, 0xc0, 0xe0, 0xc0, 0x83, 0xc0, 0x82, 0xc0, // 0x8a30,
-    0xd0, 0x90, 0x3f, 0x0c, 0xe0, 0xf5, 0x32, 0xe5, 0x32, 0x30, 0xe3, 0x74, 0x30, 0x36, 0x66, 0x90, // 0x8a40,
-    0x60, 0x19, 0xe0, 0xf5, 0x0a, 0xa3, 0xe0, 0xf5, 0x0b, 0x90, 0x60, 0x1d, 0xe0, 0xf5, 0x14, 0xa3, // 0x8a50,
-    0xe0, 0xf5, 0x15, 0x90, 0x60, 0x21, 0xe0, 0xf5, 0x0c, 0xa3, 0xe0, 0xf5, 0x0d, 0x90, 0x60, 0x29, // 0x8a60,
-    0xe0, 0xf5, 0x0e, 0xa3, 0xe0, 0xf5, 0x0f, 0x90, 0x60, 0x31, 0xe0, 0xf5, 0x10, 0xa3, 0xe0, 0xf5, // 0x8a70,
-    0x11, 0x90, 0x60, 0x39, 0xe0, 0xf5, 0x12, 0xa3, 0xe0, 0xf5, 0x13, 0x30, 0x01, 0x06, 0x30, 0x33, // 0x8a80,
-    0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x09, 0x30, 0x02, 0x06, 0x30, 0x33, 0x03, 0xd3, 0x80, 0x01, // 0x8a90,
-    0xc3, 0x92, 0x0a, 0x30, 0x33, 0x0c, 0x30, 0x03, 0x09, 0x20, 0x02, 0x06, 0x20, 0x01, 0x03, 0xd3, // 0x8aa0,
-    0x80, 0x01, 0xc3, 0x92, 0x0b, 0x90, 0x30, 0x01, 0xe0, 0x44, 0x40, 0xf0, 0xe0, 0x54, 0xbf, 0xf0, // 0x8ab0,
-    0xe5, 0x32, 0x30, 0xe1, 0x14, 0x30, 0x34, 0x11, 0x90, 0x30, 0x22, 0xe0, 0xf5, 0x08, 0xe4, 0xf0, // 0x8ac0,
-    0x30, 0x00, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x08, 0xe5, 0x32, 0x30, 0xe5, 0x12, 0x90, 0x56, // 0x8ad0,
-    0xa1, 0xe0, 0xf5, 0x09, 0x30, 0x31, 0x09, 0x30, 0x05, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x0d, // 0x8ae0,
-    0x90, 0x3f, 0x0c, 0xe5, 0x32, 0xf0, 0xd0, 0xd0, 0xd0, 0x82, 0xd0, 0x83, 0xd0, 0xe0, 0x32, 0x90, // 0x8af0,
+#if (OV5640_USE_DEFERRED == 1U)
+/**
+ * @brief  Queue a write of the open capture
+ * @note   A register already written by the capture keeps its slot. The
+ *         group hold commands of the setters are dropped, the flush opens
+ *         its own group.
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   register values
+ * @param  Length  number of registers
+ * @retval Component status, OV5640_ERROR once the queue is full
+ */
+static int32_t OV5640_DeferredStore(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length) {
+    OV5640_Deferred_t *pDef = &pObj->Deferred;
+    uint32_t           i;
+    uint32_t           j;
+    uint16_t           reg;
+
+    for (i = 0; (i < Length) && (pDef->Overflow == 0U); i++) {
+        reg = (uint16_t)(Reg + i);
+
+        if (reg != OV5640_SRM_GROUP_ACCESS) {
+            j = pDef->Start;
+            while ((j < pDef->Count) && (pDef->Entry[j].Reg != reg)) {
+                j++;
+            }
+
+            if (j < pDef->Count) {
+                pDef->Entry[j].Value = pData[i];
+            }
+            else if (pDef->Count >= OV5640_DEFERRED_SIZE) {
+                pDef->Overflow = 1U;
+            }
+            else {
+                pDef->Entry[pDef->Count].Reg   = reg;
+                pDef->Entry[pDef->Count].Value = pData[i];
+                pDef->Count++;
+            }
+        }
+    }
+
+    return (pDef->Overflow == 0U) ? OV5640_OK : OV5640_ERROR;
+}
+
+/**
+ * @brief  Replace the bytes read from the sensor by the queued values
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values read from the sensor
+ * @param  Length  number of registers
+ */
+static void OV5640_DeferredOverlay(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    OV5640_Deferred_t *pDef = &pObj->Deferred;
+    uint32_t           i;
+
+    /* Oldest first, the last queued value wins */
+    for (i = 0; i < pDef->Count; i++) {
+        if ((uint16_t)(pDef->Entry[i].Reg - Reg) < Length) {
+            pData[(uint16_t)(pDef->Entry[i].Reg - Reg)] = pDef->Entry[i].Value;
+        }
+    }
+}
+
+/**
+ * @brief  Write registers from OV5640_FlushDeferred
+ * @note   Bypasses the lock hooks, which may block, and keeps the register
+ *         cache up to date. A failed transfer is not retried here: the
+ *         backoff would wait in the interrupt, the queue is sent again on
+ *         the next frame instead.
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   register values
+ * @param  Length  number of registers
+ * @retval Component status
+ */
+static int32_t OV5640_DeferredSend(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    int32_t ret;
+
+    ret = OV5640_BusWriteOnce(pObj, Reg, pData, Length);
+#if (OV5640_USE_REG_CACHE == 1U)
+    OV5640_CacheStore(pObj, Reg, pData, Length, ret);
+#endif
+
+    return (ret == OV5640_OK) ? OV5640_OK : OV5640_ERROR;
+}
+#endif
+
+/**
+ * @brief  Read the registers used to detect a register loss in standby
+ * @param  pObj     pointer to component object
+ * @param  pTiming  OV5640_STANDBY_TIMING_SIZE bytes from 0x3800
+ * @param  pPll     OV5640_STANDBY_PLL_SIZE bytes from 0x3034
+ * @retval Component status
+ */
+static int32_t OV5640_ReadStandbySentinel(OV5640_Object_t *pObj, uint8_t *pTiming, uint8_t *pPll) {
+    int32_t ret = OV5640_OK;
+
+    /* Always read on the bus: a shadow cache copy would hide a register loss */
+    if (OV5640_BusAcquire(pObj) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_BusRead(pObj, OV5640_TIMING_HS_HIGH, pTiming, OV5640_STANDBY_TIMING_SIZE) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_BusRead(pObj, OV5640_SC_PLL_CONTRL0, pPll, OV5640_STANDBY_PLL_SIZE) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_BUS);
+    return ret;
+}
+
+#if (OV5640_CFG_AF == 1U)
+/**
+ * @brief  Tell whether the AF firmware is downloaded and running
+ * @note   The MCU must be out of reset (0x3000 bit 5 clear, the soft reset of
+ *         OV5640_Init sets it again), report idle or focused in 0x3029 and
+ *         its program RAM must pass OV5640_Focus_Verify. Any other status,
+ *         0x00 included as the MCU may read it while held in reset, means
+ *         the firmware has to be downloaded again.
+ * @param  pObj  pointer to component object
+ * @retval 1 if the firmware is resident, 0 otherwise
+ */
+static uint8_t OV5640_IsAFResident(OV5640_Object_t *pObj) {
+    uint8_t reset;
+    uint8_t status;
+    uint8_t ret = 0U;
+
+    if ((ov5640_read_reg(&pObj->Ctx, 0x3000, &reset, 1) == OV5640_OK) && ((reset & 0x20U) == 0U) &&
+        (ov5640_read_reg(&pObj->Ctx, 0x3029, &status, 1) == OV5640_OK)) {
+        /* 0x70 idle, 0x10 focused */
+        if ((status == 0x70U) || (status == 0x10U)) {
+            if (OV5640_Focus_Verify(pObj, OV5640_AF_RESIDENT_CHECK, &ret) != OV5640_OK) {
+                ret = 0U;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Update a CRC-16/CCITT (polynomial 0x1021, MSB first)
+ * @param  Crc     CRC of the previous bytes, OV5640_AF_CRC_INIT to start
+ * @param  pData   bytes to add
+ * @param  Length  number of bytes
+ * @retval Updated CRC
+ */
+static uint16_t OV5640_Crc16(uint16_t Crc, const uint8_t *pData, uint32_t Length) {
+    uint32_t i;
+    uint32_t bit;
+
+    for (i = 0; i < Length; i++) {
+        Crc ^= (uint16_t)((uint16_t)pData[i] << 8);
+        for (bit = 0; bit < 8U; bit++) {
+            Crc = ((Crc & 0x8000U) != 0U) ? (uint16_t)((Crc << 1) ^ 0x1021U) : (uint16_t)(Crc << 1);
+        }
+    }
+
+    return Crc;
+}
+#endif
+
+/**
+ * @brief  Take one of the driver locks
+ * @note   Locks are taken in the order ISP, AF then BUS and only the BUS lock
+ *         is taken for each transaction, so a setter waits for at most one
+ *         transfer of a long AF sequence.
+ * @param  pObj  pointer to component object
+ * @param  Id    OV5640_LOCK_BUS, OV5640_LOCK_ISP or OV5640_LOCK_AF
+ * @retval Component status, always OV5640_OK without OV5640_USE_LOCKS
+ */
+static int32_t OV5640_Lock(OV5640_Object_t *pObj, uint32_t Id) {
+    int32_t ret = OV5640_OK;
+#if (OV5640_USE_DEFERRED == 1U)
+    uint32_t primask;
+#endif
+
+#if (OV5640_USE_LOCKS == 1U)
+    if ((pObj->IO.Lock != NULL) && (pObj->IO.Lock(pObj->IO.Address, Id) != 0)) {
+        ret = OV5640_ERROR;
+    }
+#else
+    (void)pObj;
+    (void)Id;
+#endif
+
+#if (OV5640_USE_DEFERRED == 1U)
+    /* Keeps OV5640_FlushDeferred off the bus while a driver call runs */
+    if (ret == OV5640_OK) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        pObj->Deferred.Owners++;
+        __set_PRIMASK(primask);
+    }
+#endif
+
+    return ret;
+}
+
+/**
+ * @brief  Give back a lock taken by OV5640_Lock
+ * @param  pObj  pointer to component object
+ * @param  Id    OV5640_LOCK_BUS, OV5640_LOCK_ISP or OV5640_LOCK_AF
+ */
+static void OV5640_Unlock(OV5640_Object_t *pObj, uint32_t Id) {
+#if (OV5640_USE_DEFERRED == 1U)
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pObj->Deferred.Owners--;
+    __set_PRIMASK(primask);
+#endif
+
+#if (OV5640_USE_LOCKS == 1U)
+    if (pObj->IO.Unlock != NULL) {
+        (void)pObj->IO.Unlock(pObj->IO.Address, Id);
+    }
+#else
+    (void)pObj;
+    (void)Id;
+#endif
+}
+
+/**
+ * @brief  Take the BUS lock for a blocking transaction
+ * @note   While asynchronous jobs are queued the queue owns the bus, the
+ *         register cache and the statistics: the blocking transaction waits
+ *         up to OV5640_ASYNC_WAIT_MS for it to drain.
+ * @param  pObj  pointer to component object
+ * @retval Component status, the lock is not held on error
+ */
+static int32_t OV5640_BusAcquire(OV5640_Object_t *pObj) {
+    int32_t  ret = OV5640_OK;
+#if (OV5640_USE_ASYNC_IO == 1U)
+    uint32_t waited = 0;
+#endif
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_BUS) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+#if (OV5640_USE_ASYNC_IO == 1U)
+    else {
+        while ((ret == OV5640_OK) && (pObj->Async.Busy != 0U)) {
+            if (waited >= OV5640_ASYNC_WAIT_MS) {
+                OV5640_Unlock(pObj, OV5640_LOCK_BUS);
+                ret = OV5640_ERROR;
+            }
+            else {
+                (void)OV5640_Delay(pObj, 1U);
+                waited++;
+            }
+        }
+    }
+#endif
+
+    return ret;
+}
+
+/**
+ * @brief  Get the PLL settings of a pixel clock preset
+ * @param  ClockValue  OV5640_PCLK_xxx preset, unknown values select 24MHz
+ * @param  pRegs       filled with the SC_PLL_CONTRL2 and SC_PLL_CONTRL3 entries
+ */
+static void OV5640_GetPCLKRegs(uint32_t ClockValue, OV5640_RegVal_t *pRegs) {
+    pRegs[0].Reg = OV5640_SC_PLL_CONTRL2;
+    pRegs[1].Reg = OV5640_SC_PLL_CONTRL3;
+
+    switch (ClockValue) {
+    case OV5640_PCLK_7M:
+        pRegs[0].Value = 0x38;
+        pRegs[1].Value = 0x16;
+        break;
+    case OV5640_PCLK_8M:
+        pRegs[0].Value = 0x40;
+        pRegs[1].Value = 0x16;
+        break;
+    case OV5640_PCLK_9M:
+        pRegs[0].Value = 0x60;
+        pRegs[1].Value = 0x18;
+        break;
+    case OV5640_PCLK_12M:
+        pRegs[0].Value = 0x60;
+        pRegs[1].Value = 0x16;
+        break;
+    case OV5640_PCLK_48M:
+        pRegs[0].Value = 0x60;
+        pRegs[1].Value = 0x03;
+        break;
+    case OV5640_PCLK_24M:
+    default:
+        pRegs[0].Value = 0x60;
+        pRegs[1].Value = 0x13;
+        break;
+    }
+}
+
+/**
+ * @brief  Search the PLL settings of a pixel clock
+ * @note   Every pre-divider, root divider, system divider and PCLK divider
+ *         is tried with the multiplier closest to the target, keeping the
+ *         VCO in range. Ties are broken by the lowest VCO. The PCLK never
+ *         exceeds OV5640_PLL_PCLK_MAX, whatever MaxPClk.
+ * @param  XClk     sensor input clock in Hz
+ * @param  Target   lowest PCLK accepted in Hz, 0 for the highest PCLK within MaxPClk
+ * @param  MaxPClk  highest PCLK accepted by the host in Hz, 0 for no host limit
+ * @param  pBest    filled with the settings found
+ * @retval PCLK of the settings found in Hz, 0 when none fits
+ */
+static uint32_t OV5640_SearchPLL(uint32_t XClk, uint64_t Target, uint32_t MaxPClk, OV5640_PLL_t *pBest) {
+    uint64_t best_vco = 0;
+    uint64_t den;
+    uint64_t mult;
+    uint64_t vco;
+    uint64_t pclk;
+    uint32_t pre;
+    uint32_t root;
+    uint32_t sys;
+    uint32_t div;
+    uint8_t  better;
+
+    /* The sensor limit applies on top of the host one */
+    if ((MaxPClk == 0U) || (MaxPClk > OV5640_PLL_PCLK_MAX)) {
+        MaxPClk = OV5640_PLL_PCLK_MAX;
+    }
+
+    pBest->PClk = 0;
+
+    for (pre = 0; pre < sizeof(OV5640_PLLPreDiv); pre++) {
+        for (root = 1U; root <= 2U; root++) {
+            for (sys = 1U; sys <= OV5640_PLL_SYSDIV_MAX; sys++) {
+                for (div = 1U; div <= OV5640_PLL_PCLKDIV_MAX; div++) {
+                    den = (uint64_t)OV5640_PLLPreDiv[pre] * root * OV5640_PLL_BIT_DIV * sys * div;
+                    if (Target != 0U) {
+                        /* Smallest multiplier reaching the target */
+                        mult = ((Target * den) + XClk - 1U) / XClk;
+                        if (mult < OV5640_PLL_MULT_MIN) {
+                            mult = OV5640_PLL_MULT_MIN;
+                        }
+                        if ((mult > 127U) && ((mult & 1U) != 0U)) {
+                            mult++;
+                        }
+                    }
+                    else {
+                        /* Largest multiplier staying within the limit */
+                        mult = ((uint64_t)MaxPClk * den) / XClk;
+                        if (mult > OV5640_PLL_MULT_MAX) {
+                            mult = OV5640_PLL_MULT_MAX;
+                        }
+                        if ((mult > 127U) && ((mult & 1U) != 0U)) {
+                            mult--;
+                        }
+                    }
+
+                    vco  = ((uint64_t)XClk * mult) / OV5640_PLLPreDiv[pre];
+                    pclk = ((uint64_t)XClk * mult) / den;
+
+                    if (pBest->PClk == 0U) {
+                        better = 1U;
+                    }
+                    else if (pclk == pBest->PClk) {
+                        better = (vco < best_vco) ? 1U : 0U;
+                    }
+                    else if (Target != 0U) {
+                        better = (pclk < pBest->PClk) ? 1U : 0U;
+                    }
+                    else {
+                        better = (pclk > pBest->PClk) ? 1U : 0U;
+                    }
+
+                    if ((better != 0U) && (mult >= OV5640_PLL_MULT_MIN) && (mult <= OV5640_PLL_MULT_MAX) &&
+                        (vco >= OV5640_PLL_VCO_MIN) && (vco <= OV5640_PLL_VCO_MAX) && (pclk <= MaxPClk)) {
+                        pBest->PreDiv  = OV5640_PLLPreDiv[pre];
+                        pBest->RootDiv = (uint8_t)root;
+                        pBest->Mult    = (uint8_t)mult;
+                        pBest->SysDiv  = (uint8_t)sys;
+                        pBest->PClkDiv = (uint8_t)div;
+                        pBest->PClk    = (uint32_t)pclk;
+                        best_vco       = vco;
+                    }
+                }
+            }
+        }
+    }
+
+    return pBest->PClk;
+}
+
+/**
+ * @brief  Apply a register table to a mode profile register image
+ * @note   Entries targeting registers outside the profile are ignored.
+ *         Registers never written by the mode tables are left undefined and
+ *         are not touched when the profile is applied.
+ * @param  pProfile  pointer to the profile being built
+ * @param  pTable    pointer to the register table
+ * @param  Size      number of entries in the table
+ */
+static void OV5640_ProfileReplay(OV5640_ModeProfile_t *pProfile, const OV5640_RegVal_t *pTable, uint32_t Size) {
+    uint32_t index;
+    uint32_t i;
+
+    for (index = 0; index < Size; index++) {
+        for (i = 0; i < OV5640_PROFILE_NUM_REGS; i++) {
+            if (OV5640_ProfileRegs[i] == pTable[index].Reg) {
+                pProfile->Value[i]   = pTable[index].Value;
+                pProfile->Defined[i] = 1U;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief  Get a register value of a mode profile register image
+ * @param  pProfile  pointer to the profile
+ * @param  Reg       register address
+ * @retval Register value, 0 when the profile does not define it
+ */
+static uint8_t OV5640_ProfileGet(const OV5640_ModeProfile_t *pProfile, uint16_t Reg) {
+    uint8_t  ret = 0;
+    uint32_t i;
+
+    for (i = 0; i < OV5640_PROFILE_NUM_REGS; i++) {
+        if ((OV5640_ProfileRegs[i] == Reg) && (pProfile->Defined[i] != 0U)) {
+            ret = pProfile->Value[i];
+            break;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Read registers through the IO bus hook
+ * @note   A failed transfer is issued again up to OV5640_BUS_RETRIES times.
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   destination buffer
+ * @param  Length  number of bytes to be read
+ * @retval Component status
+ */
+static int32_t OV5640_BusRead(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    int32_t  ret;
+    uint32_t attempt = 0;
+#if (OV5640_USE_STATS == 1U)
+    uint32_t tickstart;
+#endif
+
+    do {
+        if (attempt != 0U) {
+            OV5640_BusBackoff(pObj, attempt);
+        }
+#if (OV5640_USE_STATS == 1U)
+        tickstart = OV5640_StatsTick(pObj);
+        ret       = pObj->IO.ReadReg(pObj->IO.Address, Reg, pData, Length);
+        OV5640_StatsRecord(pObj, 1U, Length, ret, OV5640_StatsTick(pObj) - tickstart);
+#else
+        ret = pObj->IO.ReadReg(pObj->IO.Address, Reg, pData, Length);
+#endif
+        attempt++;
+    }
+    while ((ret != OV5640_OK) && (attempt <= OV5640_BUS_RETRIES));
+
+    return ret;
+}
+
+/**
+ * @brief  Write registers through the IO bus hook
+ * @note   A failed transfer is issued again up to OV5640_BUS_RETRIES times.
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values to be written
+ * @param  Length  number of bytes to be written
+ * @retval Component status
+ */
+static int32_t OV5640_BusWrite(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    int32_t  ret;
+    uint32_t attempt = 0;
+
+    do {
+        if (attempt != 0U) {
+            OV5640_BusBackoff(pObj, attempt);
+        }
+        ret = OV5640_BusWriteOnce(pObj, Reg, pData, Length);
+        attempt++;
+    }
+    while ((ret != OV5640_OK) && (attempt <= OV5640_BUS_RETRIES));
+
+    return ret;
+}
+
+/**
+ * @brief  Write registers through the IO bus hook, in a single attempt
+ * @note   Never waits, so it can be used from interrupt context.
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values to be written
+ * @param  Length  number of bytes to be written
+ * @retval Component status
+ */
+static int32_t OV5640_BusWriteOnce(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    int32_t  ret;
+#if (OV5640_USE_STATS == 1U)
+    uint32_t tickstart;
+
+    tickstart = OV5640_StatsTick(pObj);
+    ret       = pObj->IO.WriteReg(pObj->IO.Address, Reg, pData, Length);
+    OV5640_StatsRecord(pObj, 0U, Length, ret, OV5640_StatsTick(pObj) - tickstart);
+#else
+    ret = pObj->IO.WriteReg(pObj->IO.Address, Reg, pData, Length);
+#endif
+
+    return ret;
+}
+
+/**
+ * @brief  Wait before issuing a failed bus transfer again
+ * @note   The wait starts at OV5640_BUS_RETRY_DELAY and doubles with each
+ *         attempt, which bounds the time a transfer can take.
+ * @param  pObj     pointer to component object
+ * @param  Attempt  1 for the first retry
+ */
+static void OV5640_BusBackoff(OV5640_Object_t *pObj, uint32_t Attempt) {
+#if (OV5640_USE_STATS == 1U)
+    pObj->Stats.Site[pObj->Stats.Current].Retries++;
+#endif
+    (void)OV5640_Delay(pObj, (uint32_t)OV5640_BUS_RETRY_DELAY << (Attempt - 1U));
+}
+
+#if (OV5640_USE_STATS == 1U)
+/**
+ * @brief  Get the current tick for the instrumentation
+ * @param  pObj  pointer to component object
+ * @retval IO GetTick value, 0 when no tick source is registered
+ */
+static uint32_t OV5640_StatsTick(OV5640_Object_t *pObj) {
+    return (pObj->IO.GetTick != NULL) ? (uint32_t)pObj->IO.GetTick() : 0U;
+}
+
+/**
+ * @brief  Charge a bus transfer to the current call site
+ * @param  pObj    pointer to component object
+ * @param  Read    1 for a read transfer, 0 for a write
+ * @param  Length  number of bytes transferred
+ * @param  Status  transfer status
+ * @param  Ticks   time spent in the bus hook
+ */
+static void OV5640_StatsRecord(OV5640_Object_t *pObj, uint8_t Read, uint16_t Length, int32_t Status,
+                               uint32_t Ticks) {
+    OV5640_StatsCounter_t *pSite = &pObj->Stats.Site[pObj->Stats.Current];
+
+    pSite->Transactions++;
+    if (Read != 0U) {
+        pSite->BytesRead += Length;
+    }
+    else {
+        pSite->BytesWritten += Length;
+    }
+    if (Status != OV5640_OK) {
+        pSite->Errors++;
+    }
+    pSite->Ticks += Ticks;
+}
+#endif
+
+/**
+ * @brief  Wrap component ReadReg to Bus Read function
+ * @param  handle  Component object handle
+ * @param  Reg  The target register address to write
+ * @param  pData  The target register value to be written
+ * @param  Length  buffer size to be written
+ * @retval error status
+ */
+static int32_t OV5640_ReadRegWrap(void *handle, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    OV5640_Object_t *pObj = (OV5640_Object_t *)handle;
+    int32_t          ret;
+
+    /* The transaction and its cache and statistics updates are atomic */
+    if (OV5640_BusAcquire(pObj) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+#if (OV5640_USE_REG_CACHE == 1U)
+    /* Serve the read from the shadow when every byte is known */
+    if (OV5640_CacheLookup(pObj, Reg, pData, Length) != 0U) {
+#if (OV5640_USE_STATS == 1U)
+        pObj->Stats.Site[pObj->Stats.Current].CacheHits++;
+#endif
+        ret = OV5640_OK;
+    }
+    else {
+        ret = OV5640_BusRead(pObj, Reg, pData, Length);
+        OV5640_CacheFill(pObj, Reg, pData, Length, ret);
+    }
+#else
+    ret = OV5640_BusRead(pObj, Reg, pData, Length);
+#endif
+
+    OV5640_Unlock(pObj, OV5640_LOCK_BUS);
+
+#if (OV5640_USE_DEFERRED == 1U)
+    /* Read-modify-write setters build on the values they queued */
+    if ((ret == OV5640_OK) && (pObj->Deferred.Capture != 0U)) {
+        OV5640_DeferredOverlay(pObj, Reg, pData, Length);
+    }
+#endif
+    return ret;
+}
+
+/**
+ * @brief  Wrap component WriteReg to Bus Write function
+ * @param  handle  Component object handle
+ * @param  Reg  The target register address to write
+ * @param  pData  The target register value to be written
+ * @param  Length  buffer size to be written
+ * @retval error status
+ */
+static int32_t OV5640_WriteRegWrap(void *handle, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    OV5640_Object_t *pObj = (OV5640_Object_t *)handle;
+    int32_t          ret;
+
+#if (OV5640_USE_DEFERRED == 1U)
+    /* Held for OV5640_FlushDeferred instead of being sent */
+    if (pObj->Deferred.Capture != 0U) {
+        return OV5640_DeferredStore(pObj, Reg, pData, Length);
+    }
+#endif
+
+    if (OV5640_BusAcquire(pObj) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+#if (OV5640_USE_REG_CACHE == 1U)
+    /* Skip the transaction when the sensor already holds every value */
+    if (OV5640_CacheMatch(pObj, Reg, pData, Length) != 0U) {
+#if (OV5640_USE_STATS == 1U)
+        pObj->Stats.Site[pObj->Stats.Current].CacheHits++;
+#endif
+        ret = OV5640_OK;
+    }
+    else {
+        ret = OV5640_BusWrite(pObj, Reg, pData, Length);
+        OV5640_CacheStore(pObj, Reg, pData, Length, ret);
+    }
+#else
+    ret = OV5640_BusWrite(pObj, Reg, pData, Length);
+#endif
+
+    OV5640_Unlock(pObj, OV5640_LOCK_BUS);
+    return ret;
+}
+
+#if (OV5640_USE_REG_CACHE == 1U)
+/**
+ * @brief  Tell whether a register must bypass the shadow cache
+ * @note   Self-clearing controls, AF MCU mailbox and firmware memory, group
+ *         hold control and registers updated by the sensor itself (AEC, AGC,
+ *         AWB, averages) are always accessed on the bus.
+ * @param  Reg  register address
+ * @retval 1 if the register is volatile, 0 otherwise
+ */
+static uint8_t OV5640_IsVolatileReg(uint16_t Reg) {
+    uint8_t ret;
+
+    if ((Reg == OV5640_SYSTEM_CTROL0) ||
+        ((Reg >= 0x3022U) && (Reg <= 0x3029U)) ||
+        ((Reg >= OV5640_SRM_GROUP_ACCESS) && (Reg <= OV5640_SRM_GROUP_STATUS)) ||
+        ((Reg >= OV5640_AWB_R_GAIN_MSB) && (Reg <= OV5640_AWB_B_GAIN_LSB)) ||
+        ((Reg >= OV5640_AEC_PK_EXPOSURE_19_16) && (Reg <= OV5640_AEC_PK_VTS_LOW)) ||
+        ((Reg >= OV5640_SIGMA_DELTA_CTRL0C) && (Reg <= OV5640_LIGHTMETER_OUTPUT_BYTE1)) ||
+        ((Reg >= OV5640_AWB_CURRENT_R_GAIN_HIGH) && (Reg <= OV5640_AWB_AVERAGE_B)) ||
+        ((Reg >= OV5640_AVG_WIN_00) && (Reg <= OV5640_AVG_READOUT)) ||
+        ((Reg >= OV5640_AFC_CTRL00) && (Reg <= OV5640_AFC_READ60)) ||
+        ((Reg >= 0x8000U) && (Reg <= 0x8FFFU))) {
+        ret = 1U;
+    }
+    else {
+        ret = 0U;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Compute the shadow cache slot of a register
+ * @param  Reg  register address
+ * @retval cache slot
+ */
+static uint32_t OV5640_CacheIndex(uint16_t Reg) {
+    /* Registers are grouped by block (high byte), spread blocks over the cache */
+    return (((uint32_t)Reg >> 8U) * 0x1FU + (uint32_t)Reg) & (OV5640_REG_CACHE_SIZE - 1U);
+}
+
+/**
+ * @brief  Copy a block of registers out of the shadow cache
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   destination buffer
+ * @param  Length  number of registers
+ * @retval 1 if every register was found in the cache, 0 otherwise
+ */
+static uint8_t OV5640_CacheLookup(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    uint16_t i;
+    uint16_t reg;
+
+    for (i = 0; i < Length; i++) {
+        reg = (uint16_t)(Reg + i);
+        if ((OV5640_IsVolatileReg(reg) != 0U) || (pObj->RegCache.Reg[OV5640_CacheIndex(reg)] != reg)) {
+            break;
+        }
+    }
+
+    if (i == Length) {
+        for (i = 0; i < Length; i++) {
+            pData[i] = pObj->RegCache.Value[OV5640_CacheIndex((uint16_t)(Reg + i))];
+        }
+    }
+
+    return (i == Length) ? 1U : 0U;
+}
+
+/**
+ * @brief  Record the result of a bus read in the shadow cache
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values read from the sensor
+ * @param  Length  number of registers
+ * @param  Status  status of the bus read
+ */
+static void OV5640_CacheFill(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length,
+                             int32_t Status) {
+    uint32_t index;
+    uint16_t i;
+    uint16_t reg;
+
+    if (Status == OV5640_OK) {
+        for (i = 0; i < Length; i++) {
+            reg = (uint16_t)(Reg + i);
+            if (OV5640_IsVolatileReg(reg) == 0U) {
+                index                       = OV5640_CacheIndex(reg);
+                pObj->RegCache.Reg[index]   = reg;
+                pObj->RegCache.Value[index] = pData[i];
+            }
+        }
+    }
+}
+
+/**
+ * @brief  Tell whether a block write would leave the sensor unchanged
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values to be written
+ * @param  Length  number of registers
+ * @retval 1 if every register already holds the value, 0 otherwise
+ */
+static uint8_t OV5640_CacheMatch(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length) {
+    uint32_t index;
+    uint16_t i;
+    uint16_t reg;
+
+    for (i = 0; i < Length; i++) {
+        reg   = (uint16_t)(Reg + i);
+        index = OV5640_CacheIndex(reg);
+        if ((OV5640_IsVolatileReg(reg) != 0U) || (pObj->RegCache.Reg[index] != reg) ||
+            (pObj->RegCache.Value[index] != pData[i])) {
+            break;
+        }
+    }
+
+    return (i == Length) ? 1U : 0U;
+}
+
+/**
+ * @brief  Record the result of a bus write in the shadow cache
+ * @param  pObj    pointer to component object
+ * @param  Reg     first register address
+ * @param  pData   values written to the sensor
+ * @param  Length  number of registers
+ * @param  Status  status of the bus write
+ */
+static void OV5640_CacheStore(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint16_t Length,
+                              int32_t Status) {
+    uint32_t index;
+    uint16_t i;
+    uint16_t reg;
+
+    for (i = 0; i < Length; i++) {
+        reg = (uint16_t)(Reg + i);
+
+        if ((reg == OV5640_SYSTEM_CTROL0) && ((pData[i] & 0x80U) != 0U)) {
+            /* Software reset: every register goes back to its default */
+            (void)OV5640_InvalidateRegCache(pObj);
+        }
+        else if (OV5640_IsVolatileReg(reg) == 0U) {
+            index = OV5640_CacheIndex(reg);
+            if (Status == OV5640_OK) {
+                pObj->RegCache.Reg[index]   = reg;
+                pObj->RegCache.Value[index] = pData[i];
+            }
+            else if (pObj->RegCache.Reg[index] == reg) {
+                /* Sensor content is unknown after a failed write */
+                pObj->RegCache.Reg[index] = 0xFFFFU;
+            }
+        }
+    }
+}
+#endif
+
+#if (OV5640_USE_ASYNC_IO == 1U)
+/**
+ * @brief  Append a job to the asynchronous queue and start it if idle
+ * @note   Starting the queue takes the bus over from the blocking calls:
+ *         it is done under the BUS lock, so it never overlaps a blocking
+ *         transaction and its cache and statistics updates. Jobs appended
+ *         to a running queue, e.g. from a completion callback, need no lock.
+ * @param  pObj  pointer to component object
+ * @param  pJob  job description, copied in the queue
+ * @retval Component status
+ */
+static int32_t OV5640_AsyncSubmit(OV5640_Object_t *pObj, const OV5640_AsyncJob_t *pJob) {
+    OV5640_Async_t *pAsync = &pObj->Async;
+    int32_t         ret    = OV5640_OK;
+    uint32_t        primask;
+    uint8_t         start  = 0U;
+    uint8_t         locked = 0U;
+    uint8_t         retry;
+
+    do {
+        retry   = 0U;
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (pAsync->Count >= OV5640_ASYNC_QUEUE_SIZE) {
+            ret = OV5640_ERROR;
+        }
+        else if ((pAsync->Busy == 0U) && (locked == 0U)) {
+            /* Idle queue: take the bus first */
+            retry = 1U;
+        }
+        else {
+            pAsync->Job[(pAsync->Head + pAsync->Count) % OV5640_ASYNC_QUEUE_SIZE] = *pJob;
+            pAsync->Count++;
+            if (pAsync->Busy == 0U) {
+                pAsync->Busy = 1U;
+                start        = 1U;
+            }
+        }
+        __set_PRIMASK(primask);
+
+        if (retry != 0U) {
+            if (OV5640_Lock(pObj, OV5640_LOCK_BUS) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                locked = 1U;
+            }
+        }
+    }
+    while ((retry != 0U) && (ret == OV5640_OK));
+
+    if (locked != 0U) {
+        OV5640_Unlock(pObj, OV5640_LOCK_BUS);
+    }
+
+    if (start != 0U) {
+        OV5640_AsyncNext(pObj);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Start the next transfer of the asynchronous queue
+ * @note   Completed jobs are retired and their callback called until a
+ *         transfer is in flight or the queue is empty.
+ * @param  pObj  pointer to component object
+ */
+static void OV5640_AsyncNext(OV5640_Object_t *pObj) {
+    OV5640_Async_t      *pAsync = &pObj->Async;
+    OV5640_AsyncJob_t   *pJob;
+    OV5640_XferCplt_Func callback;
+    void                *arg;
+    int32_t              status;
+    uint32_t             primask;
+    uint32_t             max;
+    uint16_t             len;
+    uint8_t              done = 0U;
+
+    max                       = OV5640_TABLE_RUN_SIZE;
+    if ((pObj->BurstSize != 0U) && (pObj->BurstSize < max)) {
+        max = pObj->BurstSize;
+    }
+
+    while (done == 0U) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (pAsync->Count == 0U) {
+            pAsync->Busy = 0U;
+            done         = 1U;
+        }
+        __set_PRIMASK(primask);
+
+        if (done == 0U) {
+            pJob   = &pAsync->Job[pAsync->Head];
+            status = OV5640_OK;
+
+            while ((done == 0U) && (status == OV5640_OK) && (pAsync->Index < pJob->Size)) {
+                if (pJob->pTable != NULL) {
+                    /* Merge the next run of consecutive registers */
+                    pAsync->XferReg = pJob->pTable[pAsync->Index].Reg;
+                    len             = 0;
+                    do {
+                        pAsync->Run[len] = pJob->pTable[pAsync->Index].Value;
+                        len++;
+                        pAsync->Index++;
+                    }
+                    while ((pAsync->Index < pJob->Size) && (len < max) &&
+                           (pJob->pTable[pAsync->Index].Reg == (uint16_t)(pAsync->XferReg + len)));
+                    pAsync->pXfer = pAsync->Run;
+                }
+                else {
+                    pAsync->XferReg = (uint16_t)(pJob->Reg + pAsync->Index);
+                    len             = (uint16_t)(((pJob->Size - pAsync->Index) > max) ? max : (pJob->Size - pAsync->Index));
+                    pAsync->pXfer   = &pJob->pData[pAsync->Index];
+                    pAsync->Index += len;
+                }
+                pAsync->XferLen = len;
+
+#if (OV5640_USE_REG_CACHE == 1U)
+                if ((pJob->Read == 0U) && (OV5640_CacheMatch(pObj, pAsync->XferReg, pAsync->pXfer, len) != 0U)) {
+#if (OV5640_USE_STATS == 1U)
+                    pObj->Stats.Site[pObj->Stats.Current].CacheHits++;
+#endif
+                    continue;
+                }
+#endif
+                if (pJob->Read != 0U) {
+                    status = pObj->IO.ReadRegAsync(pObj->IO.Address, pAsync->XferReg, pAsync->pXfer, len);
+                }
+                else {
+                    status = pObj->IO.WriteRegAsync(pObj->IO.Address, pAsync->XferReg, pAsync->pXfer, len);
+                }
+
+                if (status == OV5640_OK) {
+                    /* Wait for OV5640_AsyncCpltCallback */
+                    return;
+                }
+            }
+
+            /* Job over (or failed to start): retire it */
+            callback      = pJob->Callback;
+            arg           = pJob->pArg;
+            pAsync->Index = 0;
+
+            primask       = __get_PRIMASK();
+            __disable_irq();
+            pAsync->Head = (pAsync->Head + 1U) % OV5640_ASYNC_QUEUE_SIZE;
+            pAsync->Count--;
+            __set_PRIMASK(primask);
+
+            if (callback != NULL) {
+                callback(arg, (status == OV5640_OK) ? OV5640_OK : OV5640_ERROR);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @}
+ */
+
+static const OV5640_RegVal_t ov5640_uxga_init_reg_tbl[] = {
+    // 24MHz input clock, 24MHz PCLK
+    {0x3008, 0x42}, // software power down, bit[6]
+    {0x3103, 0x03}, // system clock from PLL, bit[1]
+    {0x3017, 0xff}, // FREX, Vsync, HREF, PCLK, D[9:6] output enable
+    {0x3018, 0xff}, // D[5:0], GPIO[1:0] output enable
+    {0x3034, 0x1a}, // MIPI 10-bit
+    {0x3037, 0x13}, // PLL root divider, bit[4], PLL pre-divider, bit[3:0]
+    {0x3108, 0x01}, // PCLK root divider, bit[5:4], SCLK2x root divider, bit[3:2]
+
+    // SCLK root divider, bit[1:0]
+    {0x3630, 0x36},
+    {0x3631, 0x0e},
+    {0x3632, 0xe2},
+    {0x3633, 0x12},
+    {0x3621, 0xe0},
+    {0x3704, 0xa0},
+    {0x3703, 0x5a},
+    {0x3715, 0x78},
+    {0x3717, 0x01},
+    {0x370b, 0x60},
+    {0x3705, 0x1a},
+    {0x3905, 0x02},
+    {0x3906, 0x10},
+    {0x3901, 0x0a},
+    {0x3731, 0x12},
+    {0x3600, 0x08}, // VCM control
+    {0x3601, 0x33}, // VCM control
+    {0x302d, 0x60}, // system control
+    {0x3620, 0x52},
+    {0x371b, 0x20},
+    {0x471c, 0x50},
+    {0x3a13, 0x43}, // pre-gain = 1.047x
+    {0x3a18, 0x00}, // gain ceiling
+    {0x3a19, 0xf8}, // gain ceiling = 15.5x
+    {0x3635, 0x13},
+    {0x3636, 0x03},
+    {0x3634, 0x40},
+    {0x3622, 0x01},
+    // 50/60Hz detection 50/60Hz 灯光条纹过滤
+    {0x3c01, 0x34}, // Band auto, bit[7]
+    {0x3c04, 0x28}, // threshold low sum
+    {0x3c05, 0x98}, // threshold high sum
+    {0x3c06, 0x00}, // light meter 1 threshold[15:8]
+    {0x3c07, 0x08}, // light meter 1 threshold[7:0]
+    {0x3c08, 0x00}, // light meter 2 threshold[15:8]
+    {0x3c09, 0x1c}, // light meter 2 threshold[7:0]
+    {0x3c0a, 0x9c}, // sample number[15:8]
+    {0x3c0b, 0x40}, // sample number[7:0]
+    {0x3810, 0x00}, // Timing Hoffset[11:8]
+    {0x3811, 0x10}, // Timing Hoffset[7:0]
+    {0x3812, 0x00}, // Timing Voffset[10:8]
+    {0x3708, 0x64},
+    {0x4001, 0x02}, // BLC start from line 2
+    {0x4005, 0x1a}, // BLC always update
+    {0x3000, 0x00}, // enable blocks
+    {0x3004, 0xff}, // enable clocks
+    {0x300e, 0x58}, // MIPI power down, DVP enable
+    {0x302e, 0x00},
+    {0x4300, 0x30}, // YUV 422, YUYV
+    {0x501f, 0x00}, // YUV 422
+    {0x440e, 0x00},
+    {0x5000, 0xa7}, // Lenc on, raw gamma on, BPC on, WPC on, CIP on
+    // AEC target 自动曝光控制
+    {0x3a0f, 0x30}, // stable range in high
+    {0x3a10, 0x28}, // stable range in low
+    {0x3a1b, 0x30}, // stable range out high
+    {0x3a1e, 0x26}, // stable range out low
+    {0x3a11, 0x60}, // fast zone high
+    {0x3a1f, 0x14}, // fast zone low
+    // Lens correction for ? 镜头补偿
+    {0x5800, 0x23},
+    {0x5801, 0x14},
+    {0x5802, 0x0f},
+    {0x5803, 0x0f},
+    {0x5804, 0x12},
+    {0x5805, 0x26},
+    {0x5806, 0x0c},
+    {0x5807, 0x08},
+    {0x5808, 0x05},
+    {0x5809, 0x05},
+    {0x580a, 0x08},
+
+    {0x580b, 0x0d},
+    {0x580c, 0x08},
+    {0x580d, 0x03},
+    {0x580e, 0x00},
+    {0x580f, 0x00},
+    {0x5810, 0x03},
+    {0x5811, 0x09},
+    {0x5812, 0x07},
+    {0x5813, 0x03},
+    {0x5814, 0x00},
+    {0x5815, 0x01},
+    {0x5816, 0x03},
+    {0x5817, 0x08},
+    {0x5818, 0x0d},
+    {0x5819, 0x08},
+    {0x581a, 0x05},
+    {0x581b, 0x06},
+    {0x581c, 0x08},
+    {0x581d, 0x0e},
+    {0x581e, 0x29},
+    {0x581f, 0x17},
+    {0x5820, 0x11},
+    {0x5821, 0x11},
+    {0x5822, 0x15},
+    {0x5823, 0x28},
+    {0x5824, 0x46},
+    {0x5825, 0x26},
+    {0x5826, 0x08},
+    {0x5827, 0x26},
+    {0x5828, 0x64},
+    {0x5829, 0x26},
+    {0x582a, 0x24},
+    {0x582b, 0x22},
+    {0x582c, 0x24},
+    {0x582d, 0x24},
+    {0x582e, 0x06},
+    {0x582f, 0x22},
+    {0x5830, 0x40},
+    {0x5831, 0x42},
+    {0x5832, 0x24},
+    {0x5833, 0x26},
+    {0x5834, 0x24},
+    {0x5835, 0x22},
+    {0x5836, 0x22},
+    {0x5837, 0x26},
+    {0x5838, 0x44},
+    {0x5839, 0x24},
+    {0x583a, 0x26},
+    {0x583b, 0x28},
+    {0x583c, 0x42},
+    {0x583d, 0xce}, // lenc BR offset
+    // AWB 自动白平衡
+    {0x5180, 0xff}, // AWB B block
+    {0x5181, 0xf2}, // AWB control
+    {0x5182, 0x00}, // [7:4] max local counter, [3:0] max fast counter
+    {0x5183, 0x14}, // AWB advanced
+    {0x5184, 0x25},
+    {0x5185, 0x24},
+    {0x5186, 0x09},
+    {0x5187, 0x09},
+    {0x5188, 0x09},
+    {0x5189, 0x75},
+    {0x518a, 0x54},
+    {0x518b, 0xe0},
+    {0x518c, 0xb2},
+    {0x518d, 0x42},
+    {0x518e, 0x3d},
+    {0x518f, 0x56},
+    {0x5190, 0x46},
+    {0x5191, 0xf8}, // AWB top limit
+    {0x5192, 0x04}, // AWB bottom limit
+    {0x5193, 0x70}, // red limit
+    {0x5194, 0xf0}, // green limit
+    {0x5195, 0xf0}, // blue limit
+    {0x5196, 0x03}, // AWB control
+    {0x5197, 0x01}, // local limit
+    {0x5198, 0x04},
+    {0x5199, 0x12},
+    {0x519a, 0x04},
+    {0x519b, 0x00},
+    {0x519c, 0x06},
+    {0x519d, 0x82},
+    {0x519e, 0x38}, // AWB control
+    // Gamma 伽玛曲线
+    {0x5480, 0x01}, // Gamma bias plus on, bit[0]
+    {0x5481, 0x08},
+    {0x5482, 0x14},
+    {0x5483, 0x28},
+    {0x5484, 0x51},
+    {0x5485, 0x65},
+    {0x5486, 0x71},
+    {0x5487, 0x7d},
+    {0x5488, 0x87},
+    {0x5489, 0x91},
+    {0x548a, 0x9a},
+    {0x548b, 0xaa},
+    {0x548c, 0xb8},
+    {0x548d, 0xcd},
+    {0x548e, 0xdd},
+    {0x548f, 0xea},
+    {0x5490, 0x1d},
+    // color matrix 色彩矩阵
+    {0x5381, 0x1e}, // CMX1 for Y
+    {0x5382, 0x5b}, // CMX2 for Y
+    {0x5383, 0x08}, // CMX3 for Y
+    {0x5384, 0x0a}, // CMX4 for U
+    {0x5385, 0x7e}, // CMX5 for U
+    {0x5386, 0x88}, // CMX6 for U
+    {0x5387, 0x7c}, // CMX7 for V
+    {0x5388, 0x6c}, // CMX8 for V
+    {0x5389, 0x10}, // CMX9 for V
+    {0x538a, 0x01}, // sign[9]
+    {0x538b, 0x98}, // sign[8:1]
+    // UV adjust UV 色彩饱和度调整
+    {0x5580, 0x06}, // saturation on, bit[1]
+    {0x5583, 0x40},
+    {0x5584, 0x10},
+    {0x5589, 0x10},
+    {0x558a, 0x00},
+    {0x558b, 0xf8},
+    {0x501d, 0x40}, // enable manual offset of contrast
+    // CIP 锐化和降噪
+    {0x5300, 0x08}, // CIP sharpen MT threshold 1
+    {0x5301, 0x30}, // CIP sharpen MT threshold 2
+    {0x5302, 0x10}, // CIP sharpen MT offset 1
+    {0x5303, 0x00}, // CIP sharpen MT offset 2
+    {0x5304, 0x08}, // CIP DNS threshold 1
+    {0x5305, 0x30}, // CIP DNS threshold 2
+    {0x5306, 0x08}, // CIP DNS offset 1
+    {0x5307, 0x16}, // CIP DNS offset 2
+    {0x5309, 0x08}, // CIP sharpen TH threshold 1
+    {0x530a, 0x30}, // CIP sharpen TH threshold 2
+    {0x530b, 0x04}, // CIP sharpen TH offset 1
+    {0x530c, 0x06}, // CIP sharpen TH offset 2
+    {0x5025, 0x00},
+    {0x3008, 0x02}, // wake up from standby, bit[6]
+    // 自行添加的设置
+    {0x4740, 0X21}, // VSYNC 高有效
+};
+
+#if (OV5640_CFG_JPEG == 1U)
+static const OV5640_RegVal_t OV5640_jpeg_reg_tbl[] = {
+    {0x4300, 0x30}, // YUV 422, YUYV
+    {0x501f, 0x00}, // YUV 422
+    // Input clock = 24Mhz
+    {0x3035, 0x21}, // PLL
+    {0x3036, 0x69}, // PLL
+    {0x3c07, 0x07}, // lightmeter 1 threshold[7:0]
+    {0x3820, 0x46}, // flip
+    {0x3821, 0x20}, // mirror
+    {0x3814, 0x11}, // timing X inc
+    {0x3815, 0x11}, // timing Y inc
+    {0x3800, 0x00}, // HS
+    {0x3801, 0x00}, // HS
+    {0x3802, 0x00}, // VS
+    {0x3803, 0x00}, // VS
+    {0x3804, 0x0a}, // HW (HE)
+    {0x3805, 0x3f}, // HW (HE)
+    {0x3806, 0x07}, // VH (VE)
+    {0x3807, 0x9f}, // VH (VE)
+
+    {0x3808, 0x02}, // DVPHO
+    {0x3809, 0x80}, // DVPHO
+    {0x380a, 0x01}, // DVPVO
+    {0x380b, 0xe0}, // DVPVO
+
+    {0x380c, 0x0b}, // HTS 		//
+    {0x380d, 0x1c}, // HTS
+    {0x380e, 0x07}, // VTS 		//
+    {0x380f, 0xb0}, // VTS
+    {0x3813, 0x04}, // timing V offset   04
+    {0x3618, 0x04},
+    {0x3612, 0x2b},
+    {0x3709, 0x12},
+    {0x370c, 0x00},
+
+    {0x4004, 0x06}, // BLC line number
+    {0x3002, 0x00}, // enable JFIFO, SFIFO, JPG
+    {0x3006, 0xff}, // enable clock of JPEG2x, JPEG
+    {0x4713, 0x03}, // JPEG mode 3
+    {0x4407, 0x01}, // Quantization sacle
+    {0x460b, 0x35},
+    {0x460c, 0x22},
+    {0x4837, 0x16}, // MIPI global timing
+    {0x3824, 0x02}, // PCLK manual divider
+    {0x5001, 0xA3}, // SDE on, Scaling on, CMX on, AWB on
+    {0x3503, 0x00}, // AEC/AGC on
+};
+#endif
+
+static const OV5640_RegVal_t ov5640_rgb565_reg_tbl[] = {
+    {0x4300, 0X6F},
+    {0X501F, 0x01},
+    // 1280x800, 15fps
+    // input clock 24Mhz, PCLK 42Mhz
+    {0x3035, 0x41}, // PLL
+    {0x3036, 0x69}, // PLL
+    {0x3c07, 0x07}, // lightmeter 1 threshold[7:0]
+    {0x3820, 0x46}, // flip
+    {0x3821, 0x00}, // mirror
+    {0x3814, 0x31}, // timing X inc
+    {0x3815, 0x31}, // timing Y inc
+    {0x3800, 0x00}, // HS
+    {0x3801, 0x00}, // HS
+    {0x3802, 0x00}, // VS
+    {0x3803, 0x00}, // VS
+    {0x3804, 0x0a}, // HW (HE)
+    {0x3805, 0x3f}, // HW (HE)
+    {0x3806, 0x06}, // VH (VE)
+    {0x3807, 0xa9}, // VH (VE)
+    {0x3808, 0x05}, // DVPHO
+    {0x3809, 0x00}, // DVPHO
+    {0x380a, 0x02}, // DVPVO
+    {0x380b, 0xd0}, // DVPVO
+    {0x380c, 0x05}, // HTS
+    {0x380d, 0xF8}, // HTS
+    {0x380e, 0x03}, // VTS
+    {0x380f, 0x84}, // VTS
+    {0x3813, 0x04}, // timing V offset
+    {0x3618, 0x00},
+    {0x3612, 0x29},
+    {0x3709, 0x52},
+    {0x370c, 0x03},
+    {0x3a02, 0x02}, // 60Hz max exposure
+    {0x3a03, 0xe0}, // 60Hz max exposure
+
+    {0x3a14, 0x02}, // 50Hz max exposure
+    {0x3a15, 0xe0}, // 50Hz max exposure
+    {0x4004, 0x02}, // BLC line number
+    {0x3002, 0x1c}, // reset JFIFO, SFIFO, JPG
+    {0x3006, 0xc3}, // disable clock of JPEG2x, JPEG
+    {0x4713, 0x03}, // JPEG mode 3
+    {0x4407, 0x04}, // Quantization scale
+    {0x460b, 0x37},
+    {0x460c, 0x20},
+    {0x4837, 0x16}, // MIPI global timing
+    {0x3824, 0x04}, // PCLK manual divider
+    {0x5001, 0xA3}, // SDE on, scale on, UV average off, color matrix on, AWB on
+    {0x3503, 0x00}, // AEC/AGC on
+};
+
+uint16_t solution_table[][2] = {
+    { 160,  120}, // QQVGA
+    { 320,  240}, // QVGA
+    { 480,  272}, // PSP
+    { 640,  480}, // VGA
+    { 800,  480}, // WVGA
+    { 800,  600}, // SVGA
+    {1024,  768}, // XGA
+    {1280,  800}, // WXGA
+    {1440,  900}, // WXGA+
+    {1280, 1024}, // SXGA
+    {1600, 1200}, // UXGA
+    {1920, 1080}, // 1080P
+    {2048, 1536}, // QXGA
+    {2100, 1575}, // 500W
+};
+
+
+
+#if (OV5640_CFG_AF == 1U)
+const uint8_t OV5640_AF_Config[] = {
+    0x02, 0x0f, 0xd6, 0x02, 0x0a, 0x39, 0xc2, 0x01, 0x22, 0x22, 0x00, 0x02, 0x0f, 0xb2, 0xe5, 0x1f, // 0x8000,
+    0x70, 0x72, 0xf5, 0x1e, 0xd2, 0x35, 0xff, 0xef, 0x25, 0xe0, 0x24, 0x4e, 0xf8, 0xe4, 0xf6, 0x08, // 0x8010,
+    0xf6, 0x0f, 0xbf, 0x34, 0xf2, 0x90, 0x0e, 0x93, 0xe4, 0x93, 0xff, 0xe5, 0x4b, 0xc3, 0x9f, 0x50, // 0x8020,
+    0x04, 0x7f, 0x05, 0x80, 0x02, 0x7f, 0xfb, 0x78, 0xbd, 0xa6, 0x07, 0x12, 0x0f, 0x04, 0x40, 0x04, // 0x8030,
+    0x7f, 0x03, 0x80, 0x02, 0x7f, 0x30, 0x78, 0xbc, 0xa6, 0x07, 0xe6, 0x18, 0xf6, 0x08, 0xe6, 0x78, // 0x8040,
+    0xb9, 0xf6, 0x78, 0xbc, 0xe6, 0x78, 0xba, 0xf6, 0x78, 0xbf, 0x76, 0x33, 0xe4, 0x08, 0xf6, 0x78, // 0x8050,
+    0xb8, 0x76, 0x01, 0x75, 0x4a, 0x02, 0x78, 0xb6, 0xf6, 0x08, 0xf6, 0x74, 0xff, 0x78, 0xc1, 0xf6, // 0x8060,
+    0x08, 0xf6, 0x75, 0x1f, 0x01, 0x78, 0xbc, 0xe6, 0x75, 0xf0, 0x05, 0xa4, 0xf5, 0x4b, 0x12, 0x0a, // 0x8070,
+    0xff, 0xc2, 0x37, 0x22, 0x78, 0xb8, 0xe6, 0xd3, 0x94, 0x00, 0x40, 0x02, 0x16, 0x22, 0xe5, 0x1f, // 0x8080,
+    0xb4, 0x05, 0x23, 0xe4, 0xf5, 0x1f, 0xc2, 0x01, 0x78, 0xb6, 0xe6, 0xfe, 0x08, 0xe6, 0xff, 0x78, // 0x8090,
+    0x4e, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0xa2, 0x37, 0xe4, 0x33, 0xf5, 0x3c, 0x90, 0x30, 0x28, 0xf0, // 0x80a0,
+    0x75, 0x1e, 0x10, 0xd2, 0x35, 0x22, 0xe5, 0x4b, 0x75, 0xf0, 0x05, 0x84, 0x78, 0xbc, 0xf6, 0x90, // 0x80b0,
+    0x0e, 0x8c, 0xe4, 0x93, 0xff, 0x25, 0xe0, 0x24, 0x0a, 0xf8, 0xe6, 0xfc, 0x08, 0xe6, 0xfd, 0x78, // 0x80c0,
+    0xbc, 0xe6, 0x25, 0xe0, 0x24, 0x4e, 0xf8, 0xa6, 0x04, 0x08, 0xa6, 0x05, 0xef, 0x12, 0x0f, 0x0b, // 0x80d0,
+    0xd3, 0x78, 0xb7, 0x96, 0xee, 0x18, 0x96, 0x40, 0x0d, 0x78, 0xbc, 0xe6, 0x78, 0xb9, 0xf6, 0x78, // 0x80e0,
+    0xb6, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x90, 0x0e, 0x8c, 0xe4, 0x93, 0x12, 0x0f, 0x0b, 0xc3, 0x78, // 0x80f0,
+    0xc2, 0x96, 0xee, 0x18, 0x96, 0x50, 0x0d, 0x78, 0xbc, 0xe6, 0x78, 0xba, 0xf6, 0x78, 0xc1, 0xa6, // 0x8100,
+    0x06, 0x08, 0xa6, 0x07, 0x78, 0xb6, 0xe6, 0xfe, 0x08, 0xe6, 0xc3, 0x78, 0xc2, 0x96, 0xff, 0xee, // 0x8110,
+    0x18, 0x96, 0x78, 0xc3, 0xf6, 0x08, 0xa6, 0x07, 0x90, 0x0e, 0x95, 0xe4, 0x18, 0x12, 0x0e, 0xe9, // 0x8120,
+    0x40, 0x02, 0xd2, 0x37, 0x78, 0xbc, 0xe6, 0x08, 0x26, 0x08, 0xf6, 0xe5, 0x1f, 0x64, 0x01, 0x70, // 0x8130,
+    0x4a, 0xe6, 0xc3, 0x78, 0xc0, 0x12, 0x0e, 0xdf, 0x40, 0x05, 0x12, 0x0e, 0xda, 0x40, 0x39, 0x12, // 0x8140,
+    0x0f, 0x02, 0x40, 0x04, 0x7f, 0xfe, 0x80, 0x02, 0x7f, 0x02, 0x78, 0xbd, 0xa6, 0x07, 0x78, 0xb9, // 0x8150,
+    0xe6, 0x24, 0x03, 0x78, 0xbf, 0xf6, 0x78, 0xb9, 0xe6, 0x24, 0xfd, 0x78, 0xc0, 0xf6, 0x12, 0x0f, // 0x8160,
+    0x02, 0x40, 0x06, 0x78, 0xc0, 0xe6, 0xff, 0x80, 0x04, 0x78, 0xbf, 0xe6, 0xff, 0x78, 0xbe, 0xa6, // 0x8170,
+    0x07, 0x75, 0x1f, 0x02, 0x78, 0xb8, 0x76, 0x01, 0x02, 0x02, 0x4a, 0xe5, 0x1f, 0x64, 0x02, 0x60, // 0x8180,
+    0x03, 0x02, 0x02, 0x2a, 0x78, 0xbe, 0xe6, 0xff, 0xc3, 0x78, 0xc0, 0x12, 0x0e, 0xe0, 0x40, 0x08, // 0x8190,
+    0x12, 0x0e, 0xda, 0x50, 0x03, 0x02, 0x02, 0x28, 0x12, 0x0f, 0x02, 0x40, 0x04, 0x7f, 0xff, 0x80, // 0x81a0,
+    0x02, 0x7f, 0x01, 0x78, 0xbd, 0xa6, 0x07, 0x78, 0xb9, 0xe6, 0x04, 0x78, 0xbf, 0xf6, 0x78, 0xb9, // 0x81b0,
+    0xe6, 0x14, 0x78, 0xc0, 0xf6, 0x18, 0x12, 0x0f, 0x04, 0x40, 0x04, 0xe6, 0xff, 0x80, 0x02, 0x7f, // 0x81c0,
+    0x00, 0x78, 0xbf, 0xa6, 0x07, 0xd3, 0x08, 0xe6, 0x64, 0x80, 0x94, 0x80, 0x40, 0x04, 0xe6, 0xff, // 0x81d0,
+    0x80, 0x02, 0x7f, 0x00, 0x78, 0xc0, 0xa6, 0x07, 0xc3, 0x18, 0xe6, 0x64, 0x80, 0x94, 0xb3, 0x50, // 0x81e0,
+    0x04, 0xe6, 0xff, 0x80, 0x02, 0x7f, 0x33, 0x78, 0xbf, 0xa6, 0x07, 0xc3, 0x08, 0xe6, 0x64, 0x80, // 0x81f0,
+    0x94, 0xb3, 0x50, 0x04, 0xe6, 0xff, 0x80, 0x02, 0x7f, 0x33, 0x78, 0xc0, 0xa6, 0x07, 0x12, 0x0f, // 0x8200,
+    0x02, 0x40, 0x06, 0x78, 0xc0, 0xe6, 0xff, 0x80, 0x04, 0x78, 0xbf, 0xe6, 0xff, 0x78, 0xbe, 0xa6, // 0x8210,
+    0x07, 0x75, 0x1f, 0x03, 0x78, 0xb8, 0x76, 0x01, 0x80, 0x20, 0xe5, 0x1f, 0x64, 0x03, 0x70, 0x26, // 0x8220,
+    0x78, 0xbe, 0xe6, 0xff, 0xc3, 0x78, 0xc0, 0x12, 0x0e, 0xe0, 0x40, 0x05, 0x12, 0x0e, 0xda, 0x40, // 0x8230,
+    0x09, 0x78, 0xb9, 0xe6, 0x78, 0xbe, 0xf6, 0x75, 0x1f, 0x04, 0x78, 0xbe, 0xe6, 0x75, 0xf0, 0x05, // 0x8240,
+    0xa4, 0xf5, 0x4b, 0x02, 0x0a, 0xff, 0xe5, 0x1f, 0xb4, 0x04, 0x10, 0x90, 0x0e, 0x94, 0xe4, 0x78, // 0x8250,
+    0xc3, 0x12, 0x0e, 0xe9, 0x40, 0x02, 0xd2, 0x37, 0x75, 0x1f, 0x05, 0x22, 0x30, 0x01, 0x03, 0x02, // 0x8260,
+    0x04, 0xc0, 0x30, 0x02, 0x03, 0x02, 0x04, 0xc0, 0x90, 0x51, 0xa5, 0xe0, 0x78, 0x93, 0xf6, 0xa3, // 0x8270,
+    0xe0, 0x08, 0xf6, 0xa3, 0xe0, 0x08, 0xf6, 0xe5, 0x1f, 0x70, 0x3c, 0x75, 0x1e, 0x20, 0xd2, 0x35, // 0x8280,
+    0x12, 0x0c, 0x7a, 0x78, 0x7e, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x78, 0x8b, 0xa6, 0x09, 0x18, 0x76, // 0x8290,
+    0x01, 0x12, 0x0c, 0x5b, 0x78, 0x4e, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x78, 0x8b, 0xe6, 0x78, 0x6e, // 0x82a0,
+    0xf6, 0x75, 0x1f, 0x01, 0x78, 0x93, 0xe6, 0x78, 0x90, 0xf6, 0x78, 0x94, 0xe6, 0x78, 0x91, 0xf6, // 0x82b0,
+    0x78, 0x95, 0xe6, 0x78, 0x92, 0xf6, 0x22, 0x79, 0x90, 0xe7, 0xd3, 0x78, 0x93, 0x96, 0x40, 0x05, // 0x82c0,
+    0xe7, 0x96, 0xff, 0x80, 0x08, 0xc3, 0x79, 0x93, 0xe7, 0x78, 0x90, 0x96, 0xff, 0x78, 0x88, 0x76, // 0x82d0,
+    0x00, 0x08, 0xa6, 0x07, 0x79, 0x91, 0xe7, 0xd3, 0x78, 0x94, 0x96, 0x40, 0x05, 0xe7, 0x96, 0xff, // 0x82e0,
+    0x80, 0x08, 0xc3, 0x79, 0x94, 0xe7, 0x78, 0x91, 0x96, 0xff, 0x12, 0x0c, 0x8e, 0x79, 0x92, 0xe7, // 0x82f0,
+    0xd3, 0x78, 0x95, 0x96, 0x40, 0x05, 0xe7, 0x96, 0xff, 0x80, 0x08, 0xc3, 0x79, 0x95, 0xe7, 0x78, // 0x8300,
+    0x92, 0x96, 0xff, 0x12, 0x0c, 0x8e, 0x12, 0x0c, 0x5b, 0x78, 0x8a, 0xe6, 0x25, 0xe0, 0x24, 0x4e, // 0x8310,
+    0xf8, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x78, 0x8a, 0xe6, 0x24, 0x6e, 0xf8, 0xa6, 0x09, 0x78, 0x8a, // 0x8320,
+    0xe6, 0x24, 0x01, 0xff, 0xe4, 0x33, 0xfe, 0xd3, 0xef, 0x94, 0x0f, 0xee, 0x64, 0x80, 0x94, 0x80, // 0x8330,
+    0x40, 0x04, 0x7f, 0x00, 0x80, 0x05, 0x78, 0x8a, 0xe6, 0x04, 0xff, 0x78, 0x8a, 0xa6, 0x07, 0xe5, // 0x8340,
+    0x1f, 0xb4, 0x01, 0x0a, 0xe6, 0x60, 0x03, 0x02, 0x04, 0xc0, 0x75, 0x1f, 0x02, 0x22, 0x12, 0x0c, // 0x8350,
+    0x7a, 0x78, 0x80, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0x12, 0x0c, 0x7a, 0x78, 0x82, 0xa6, 0x06, 0x08, // 0x8360,
+    0xa6, 0x07, 0x78, 0x6e, 0xe6, 0x78, 0x8c, 0xf6, 0x78, 0x6e, 0xe6, 0x78, 0x8d, 0xf6, 0x7f, 0x01, // 0x8370,
+    0xef, 0x25, 0xe0, 0x24, 0x4f, 0xf9, 0xc3, 0x78, 0x81, 0xe6, 0x97, 0x18, 0xe6, 0x19, 0x97, 0x50, // 0x8380,
+    0x0a, 0x12, 0x0c, 0x82, 0x78, 0x80, 0xa6, 0x04, 0x08, 0xa6, 0x05, 0x74, 0x6e, 0x2f, 0xf9, 0x78, // 0x8390,
+    0x8c, 0xe6, 0xc3, 0x97, 0x50, 0x08, 0x74, 0x6e, 0x2f, 0xf8, 0xe6, 0x78, 0x8c, 0xf6, 0xef, 0x25, // 0x83a0,
+    0xe0, 0x24, 0x4f, 0xf9, 0xd3, 0x78, 0x83, 0xe6, 0x97, 0x18, 0xe6, 0x19, 0x97, 0x40, 0x0a, 0x12, // 0x83b0,
+    0x0c, 0x82, 0x78, 0x82, 0xa6, 0x04, 0x08, 0xa6, 0x05, 0x74, 0x6e, 0x2f, 0xf9, 0x78, 0x8d, 0xe6, // 0x83c0,
+    0xd3, 0x97, 0x40, 0x08, 0x74, 0x6e, 0x2f, 0xf8, 0xe6, 0x78, 0x8d, 0xf6, 0x0f, 0xef, 0x64, 0x10, // 0x83d0,
+    0x70, 0x9e, 0xc3, 0x79, 0x81, 0xe7, 0x78, 0x83, 0x96, 0xff, 0x19, 0xe7, 0x18, 0x96, 0x78, 0x84, // 0x83e0,
+    0xf6, 0x08, 0xa6, 0x07, 0xc3, 0x79, 0x8c, 0xe7, 0x78, 0x8d, 0x96, 0x08, 0xf6, 0xd3, 0x79, 0x81, // 0x83f0,
+    0xe7, 0x78, 0x7f, 0x96, 0x19, 0xe7, 0x18, 0x96, 0x40, 0x05, 0x09, 0xe7, 0x08, 0x80, 0x06, 0xc3, // 0x8400,
+    0x79, 0x7f, 0xe7, 0x78, 0x81, 0x96, 0xff, 0x19, 0xe7, 0x18, 0x96, 0xfe, 0x78, 0x86, 0xa6, 0x06, // 0x8410,
+    0x08, 0xa6, 0x07, 0x79, 0x8c, 0xe7, 0xd3, 0x78, 0x8b, 0x96, 0x40, 0x05, 0xe7, 0x96, 0xff, 0x80, // 0x8420,
+    0x08, 0xc3, 0x79, 0x8b, 0xe7, 0x78, 0x8c, 0x96, 0xff, 0x78, 0x8f, 0xa6, 0x07, 0xe5, 0x1f, 0x64, // 0x8430,
+    0x02, 0x70, 0x69, 0x90, 0x0e, 0x91, 0x93, 0xff, 0x18, 0xe6, 0xc3, 0x9f, 0x50, 0x72, 0x12, 0x0c, // 0x8440,
+    0x4a, 0x12, 0x0c, 0x2f, 0x90, 0x0e, 0x8e, 0x12, 0x0c, 0x38, 0x78, 0x80, 0x12, 0x0c, 0x6b, 0x7b, // 0x8450,
+    0x04, 0x12, 0x0c, 0x1d, 0xc3, 0x12, 0x06, 0x45, 0x50, 0x56, 0x90, 0x0e, 0x92, 0xe4, 0x93, 0xff, // 0x8460,
+    0x78, 0x8f, 0xe6, 0x9f, 0x40, 0x02, 0x80, 0x11, 0x90, 0x0e, 0x90, 0xe4, 0x93, 0xff, 0xd3, 0x78, // 0x8470,
+    0x89, 0xe6, 0x9f, 0x18, 0xe6, 0x94, 0x00, 0x40, 0x03, 0x75, 0x1f, 0x05, 0x12, 0x0c, 0x4a, 0x12, // 0x8480,
+    0x0c, 0x2f, 0x90, 0x0e, 0x8f, 0x12, 0x0c, 0x38, 0x78, 0x7e, 0x12, 0x0c, 0x6b, 0x7b, 0x40, 0x12, // 0x8490,
+    0x0c, 0x1d, 0xd3, 0x12, 0x06, 0x45, 0x40, 0x18, 0x75, 0x1f, 0x05, 0x22, 0xe5, 0x1f, 0xb4, 0x05, // 0x84a0,
+    0x0f, 0xd2, 0x01, 0xc2, 0x02, 0xe4, 0xf5, 0x1f, 0xf5, 0x1e, 0xd2, 0x35, 0xd2, 0x33, 0xd2, 0x36, // 0x84b0,
+    0x22, 0xef, 0x8d, 0xf0, 0xa4, 0xa8, 0xf0, 0xcf, 0x8c, 0xf0, 0xa4, 0x28, 0xce, 0x8d, 0xf0, 0xa4, // 0x84c0,
+    0x2e, 0xfe, 0x22, 0xbc, 0x00, 0x0b, 0xbe, 0x00, 0x29, 0xef, 0x8d, 0xf0, 0x84, 0xff, 0xad, 0xf0, // 0x84d0,
+    0x22, 0xe4, 0xcc, 0xf8, 0x75, 0xf0, 0x08, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xec, 0x33, 0xfc, // 0x84e0,
+    0xee, 0x9d, 0xec, 0x98, 0x40, 0x05, 0xfc, 0xee, 0x9d, 0xfe, 0x0f, 0xd5, 0xf0, 0xe9, 0xe4, 0xce, // 0x84f0,
+    0xfd, 0x22, 0xed, 0xf8, 0xf5, 0xf0, 0xee, 0x84, 0x20, 0xd2, 0x1c, 0xfe, 0xad, 0xf0, 0x75, 0xf0, // 0x8500,
+    0x08, 0xef, 0x2f, 0xff, 0xed, 0x33, 0xfd, 0x40, 0x07, 0x98, 0x50, 0x06, 0xd5, 0xf0, 0xf2, 0x22, // 0x8510,
+    0xc3, 0x98, 0xfd, 0x0f, 0xd5, 0xf0, 0xea, 0x22, 0xe8, 0x8f, 0xf0, 0xa4, 0xcc, 0x8b, 0xf0, 0xa4, // 0x8520,
+    0x2c, 0xfc, 0xe9, 0x8e, 0xf0, 0xa4, 0x2c, 0xfc, 0x8a, 0xf0, 0xed, 0xa4, 0x2c, 0xfc, 0xea, 0x8e, // 0x8530,
+    0xf0, 0xa4, 0xcd, 0xa8, 0xf0, 0x8b, 0xf0, 0xa4, 0x2d, 0xcc, 0x38, 0x25, 0xf0, 0xfd, 0xe9, 0x8f, // 0x8540,
+    0xf0, 0xa4, 0x2c, 0xcd, 0x35, 0xf0, 0xfc, 0xeb, 0x8e, 0xf0, 0xa4, 0xfe, 0xa9, 0xf0, 0xeb, 0x8f, // 0x8550,
+    0xf0, 0xa4, 0xcf, 0xc5, 0xf0, 0x2e, 0xcd, 0x39, 0xfe, 0xe4, 0x3c, 0xfc, 0xea, 0xa4, 0x2d, 0xce, // 0x8560,
+    0x35, 0xf0, 0xfd, 0xe4, 0x3c, 0xfc, 0x22, 0x75, 0xf0, 0x08, 0x75, 0x82, 0x00, 0xef, 0x2f, 0xff, // 0x8570,
+    0xee, 0x33, 0xfe, 0xcd, 0x33, 0xcd, 0xcc, 0x33, 0xcc, 0xc5, 0x82, 0x33, 0xc5, 0x82, 0x9b, 0xed, // 0x8580,
+    0x9a, 0xec, 0x99, 0xe5, 0x82, 0x98, 0x40, 0x0c, 0xf5, 0x82, 0xee, 0x9b, 0xfe, 0xed, 0x9a, 0xfd, // 0x8590,
+    0xec, 0x99, 0xfc, 0x0f, 0xd5, 0xf0, 0xd6, 0xe4, 0xce, 0xfb, 0xe4, 0xcd, 0xfa, 0xe4, 0xcc, 0xf9, // 0x85a0,
+    0xa8, 0x82, 0x22, 0xb8, 0x00, 0xc1, 0xb9, 0x00, 0x59, 0xba, 0x00, 0x2d, 0xec, 0x8b, 0xf0, 0x84, // 0x85b0,
+    0xcf, 0xce, 0xcd, 0xfc, 0xe5, 0xf0, 0xcb, 0xf9, 0x78, 0x18, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, // 0x85c0,
+    0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc, 0xeb, 0x33, 0xfb, 0x10, 0xd7, 0x03, 0x99, 0x40, 0x04, 0xeb, // 0x85d0,
+    0x99, 0xfb, 0x0f, 0xd8, 0xe5, 0xe4, 0xf9, 0xfa, 0x22, 0x78, 0x18, 0xef, 0x2f, 0xff, 0xee, 0x33, // 0x85e0,
+    0xfe, 0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc, 0xc9, 0x33, 0xc9, 0x10, 0xd7, 0x05, 0x9b, 0xe9, 0x9a, // 0x85f0,
+    0x40, 0x07, 0xec, 0x9b, 0xfc, 0xe9, 0x9a, 0xf9, 0x0f, 0xd8, 0xe0, 0xe4, 0xc9, 0xfa, 0xe4, 0xcc, // 0x8600,
+    0xfb, 0x22, 0x75, 0xf0, 0x10, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xcc, 0x33, // 0x8610,
+    0xcc, 0xc8, 0x33, 0xc8, 0x10, 0xd7, 0x07, 0x9b, 0xec, 0x9a, 0xe8, 0x99, 0x40, 0x0a, 0xed, 0x9b, // 0x8620,
+    0xfd, 0xec, 0x9a, 0xfc, 0xe8, 0x99, 0xf8, 0x0f, 0xd5, 0xf0, 0xda, 0xe4, 0xcd, 0xfb, 0xe4, 0xcc, // 0x8630,
+    0xfa, 0xe4, 0xc8, 0xf9, 0x22, 0xeb, 0x9f, 0xf5, 0xf0, 0xea, 0x9e, 0x42, 0xf0, 0xe9, 0x9d, 0x42, // 0x8640,
+    0xf0, 0xe8, 0x9c, 0x45, 0xf0, 0x22, 0xe8, 0x60, 0x0f, 0xec, 0xc3, 0x13, 0xfc, 0xed, 0x13, 0xfd, // 0x8650,
+    0xee, 0x13, 0xfe, 0xef, 0x13, 0xff, 0xd8, 0xf1, 0x22, 0xe8, 0x60, 0x0f, 0xef, 0xc3, 0x33, 0xff, // 0x8660,
+    0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc, 0xd8, 0xf1, 0x22, 0xe4, 0x93, 0xfc, 0x74, // 0x8670,
+    0x01, 0x93, 0xfd, 0x74, 0x02, 0x93, 0xfe, 0x74, 0x03, 0x93, 0xff, 0x22, 0xe6, 0xfb, 0x08, 0xe6, // 0x8680,
+    0xf9, 0x08, 0xe6, 0xfa, 0x08, 0xe6, 0xcb, 0xf8, 0x22, 0xec, 0xf6, 0x08, 0xed, 0xf6, 0x08, 0xee, // 0x8690,
+    0xf6, 0x08, 0xef, 0xf6, 0x22, 0xa4, 0x25, 0x82, 0xf5, 0x82, 0xe5, 0xf0, 0x35, 0x83, 0xf5, 0x83, // 0x86a0,
+    0x22, 0xd0, 0x83, 0xd0, 0x82, 0xf8, 0xe4, 0x93, 0x70, 0x12, 0x74, 0x01, 0x93, 0x70, 0x0d, 0xa3, // 0x86b0,
+    0xa3, 0x93, 0xf8, 0x74, 0x01, 0x93, 0xf5, 0x82, 0x88, 0x83, 0xe4, 0x73, 0x74, 0x02, 0x93, 0x68, // 0x86c0,
+    0x60, 0xef, 0xa3, 0xa3, 0xa3, 0x80, 0xdf, 0x90, 0x38, 0x04, 0x78, 0x52, 0x12, 0x0b, 0xfd, 0x90, // 0x86d0,
+    0x38, 0x00, 0xe0, 0xfe, 0xa3, 0xe0, 0xfd, 0xed, 0xff, 0xc3, 0x12, 0x0b, 0x9e, 0x90, 0x38, 0x10, // 0x86e0,
+    0x12, 0x0b, 0x92, 0x90, 0x38, 0x06, 0x78, 0x54, 0x12, 0x0b, 0xfd, 0x90, 0x38, 0x02, 0xe0, 0xfe, // 0x86f0,
+    0xa3, 0xe0, 0xfd, 0xed, 0xff, 0xc3, 0x12, 0x0b, 0x9e, 0x90, 0x38, 0x12, 0x12, 0x0b, 0x92, 0xa3, // 0x8700,
+    0xe0, 0xb4, 0x31, 0x07, 0x78, 0x52, 0x79, 0x52, 0x12, 0x0c, 0x13, 0x90, 0x38, 0x14, 0xe0, 0xb4, // 0x8710,
+    0x71, 0x15, 0x78, 0x52, 0xe6, 0xfe, 0x08, 0xe6, 0x78, 0x02, 0xce, 0xc3, 0x13, 0xce, 0x13, 0xd8, // 0x8720,
+    0xf9, 0x79, 0x53, 0xf7, 0xee, 0x19, 0xf7, 0x90, 0x38, 0x15, 0xe0, 0xb4, 0x31, 0x07, 0x78, 0x54, // 0x8730,
+    0x79, 0x54, 0x12, 0x0c, 0x13, 0x90, 0x38, 0x15, 0xe0, 0xb4, 0x71, 0x15, 0x78, 0x54, 0xe6, 0xfe, // 0x8740,
+    0x08, 0xe6, 0x78, 0x02, 0xce, 0xc3, 0x13, 0xce, 0x13, 0xd8, 0xf9, 0x79, 0x55, 0xf7, 0xee, 0x19, // 0x8750,
+    0xf7, 0x79, 0x52, 0x12, 0x0b, 0xd9, 0x09, 0x12, 0x0b, 0xd9, 0xaf, 0x47, 0x12, 0x0b, 0xb2, 0xe5, // 0x8760,
+    0x44, 0xfb, 0x7a, 0x00, 0xfd, 0x7c, 0x00, 0x12, 0x04, 0xd3, 0x78, 0x5a, 0xa6, 0x06, 0x08, 0xa6, // 0x8770,
+    0x07, 0xaf, 0x45, 0x12, 0x0b, 0xb2, 0xad, 0x03, 0x7c, 0x00, 0x12, 0x04, 0xd3, 0x78, 0x56, 0xa6, // 0x8780,
+    0x06, 0x08, 0xa6, 0x07, 0xaf, 0x48, 0x78, 0x54, 0x12, 0x0b, 0xb4, 0xe5, 0x43, 0xfb, 0xfd, 0x7c, // 0x8790,
+    0x00, 0x12, 0x04, 0xd3, 0x78, 0x5c, 0xa6, 0x06, 0x08, 0xa6, 0x07, 0xaf, 0x46, 0x7e, 0x00, 0x78, // 0x87a0,
+    0x54, 0x12, 0x0b, 0xb6, 0xad, 0x03, 0x7c, 0x00, 0x12, 0x04, 0xd3, 0x78, 0x58, 0xa6, 0x06, 0x08, // 0x87b0,
+    0xa6, 0x07, 0xc3, 0x78, 0x5b, 0xe6, 0x94, 0x08, 0x18, 0xe6, 0x94, 0x00, 0x50, 0x05, 0x76, 0x00, // 0x87c0,
+    0x08, 0x76, 0x08, 0xc3, 0x78, 0x5d, 0xe6, 0x94, 0x08, 0x18, 0xe6, 0x94, 0x00, 0x50, 0x05, 0x76, // 0x87d0,
+    0x00, 0x08, 0x76, 0x08, 0x78, 0x5a, 0x12, 0x0b, 0xc6, 0xff, 0xd3, 0x78, 0x57, 0xe6, 0x9f, 0x18, // 0x87e0,
+    0xe6, 0x9e, 0x40, 0x0e, 0x78, 0x5a, 0xe6, 0x13, 0xfe, 0x08, 0xe6, 0x78, 0x57, 0x12, 0x0c, 0x08, // 0x87f0,
+    0x80, 0x04, 0x7e, 0x00, 0x7f, 0x00, 0x78, 0x5e, 0x12, 0x0b, 0xbe, 0xff, 0xd3, 0x78, 0x59, 0xe6, // 0x8800,
+    0x9f, 0x18, 0xe6, 0x9e, 0x40, 0x0e, 0x78, 0x5c, 0xe6, 0x13, 0xfe, 0x08, 0xe6, 0x78, 0x59, 0x12, // 0x8810,
+    0x0c, 0x08, 0x80, 0x04, 0x7e, 0x00, 0x7f, 0x00, 0xe4, 0xfc, 0xfd, 0x78, 0x62, 0x12, 0x06, 0x99, // 0x8820,
+    0x78, 0x5a, 0x12, 0x0b, 0xc6, 0x78, 0x57, 0x26, 0xff, 0xee, 0x18, 0x36, 0xfe, 0x78, 0x66, 0x12, // 0x8830,
+    0x0b, 0xbe, 0x78, 0x59, 0x26, 0xff, 0xee, 0x18, 0x36, 0xfe, 0xe4, 0xfc, 0xfd, 0x78, 0x6a, 0x12, // 0x8840,
+    0x06, 0x99, 0x12, 0x0b, 0xce, 0x78, 0x66, 0x12, 0x06, 0x8c, 0xd3, 0x12, 0x06, 0x45, 0x40, 0x08, // 0x8850,
+    0x12, 0x0b, 0xce, 0x78, 0x66, 0x12, 0x06, 0x99, 0x78, 0x54, 0x12, 0x0b, 0xd0, 0x78, 0x6a, 0x12, // 0x8860,
+    0x06, 0x8c, 0xd3, 0x12, 0x06, 0x45, 0x40, 0x0a, 0x78, 0x54, 0x12, 0x0b, 0xd0, 0x78, 0x6a, 0x12, // 0x8870,
+    0x06, 0x99, 0x78, 0x61, 0xe6, 0x90, 0x60, 0x01, 0xf0, 0x78, 0x65, 0xe6, 0xa3, 0xf0, 0x78, 0x69, // 0x8880,
+    0xe6, 0xa3, 0xf0, 0x78, 0x55, 0xe6, 0xa3, 0xf0, 0x7d, 0x01, 0x78, 0x61, 0x12, 0x0b, 0xe9, 0x24, // 0x8890,
+    0x01, 0x12, 0x0b, 0xa6, 0x78, 0x65, 0x12, 0x0b, 0xe9, 0x24, 0x02, 0x12, 0x0b, 0xa6, 0x78, 0x69, // 0x88a0,
+    0x12, 0x0b, 0xe9, 0x24, 0x03, 0x12, 0x0b, 0xa6, 0x78, 0x6d, 0x12, 0x0b, 0xe9, 0x24, 0x04, 0x12, // 0x88b0,
+    0x0b, 0xa6, 0x0d, 0xbd, 0x05, 0xd4, 0xc2, 0x0e, 0xc2, 0x06, 0x22, 0x85, 0x08, 0x41, 0x90, 0x30, // 0x88c0,
+    0x24, 0xe0, 0xf5, 0x3d, 0xa3, 0xe0, 0xf5, 0x3e, 0xa3, 0xe0, 0xf5, 0x3f, 0xa3, 0xe0, 0xf5, 0x40, // 0x88d0,
+    0xa3, 0xe0, 0xf5, 0x3c, 0xd2, 0x34, 0xe5, 0x41, 0x12, 0x06, 0xb1, 0x09, 0x31, 0x03, 0x09, 0x35, // 0x88e0,
+    0x04, 0x09, 0x3b, 0x05, 0x09, 0x3e, 0x06, 0x09, 0x41, 0x07, 0x09, 0x4a, 0x08, 0x09, 0x5b, 0x12, // 0x88f0,
+    0x09, 0x73, 0x18, 0x09, 0x89, 0x19, 0x09, 0x5e, 0x1a, 0x09, 0x6a, 0x1b, 0x09, 0xad, 0x80, 0x09, // 0x8900,
+    0xb2, 0x81, 0x0a, 0x1d, 0x8f, 0x0a, 0x09, 0x90, 0x0a, 0x1d, 0x91, 0x0a, 0x1d, 0x92, 0x0a, 0x1d, // 0x8910,
+    0x93, 0x0a, 0x1d, 0x94, 0x0a, 0x1d, 0x98, 0x0a, 0x17, 0x9f, 0x0a, 0x1a, 0xec, 0x00, 0x00, 0x0a, // 0x8920,
+    0x38, 0x12, 0x0f, 0x74, 0x22, 0x12, 0x0f, 0x74, 0xd2, 0x03, 0x22, 0xd2, 0x03, 0x22, 0xc2, 0x03, // 0x8930,
+    0x22, 0xa2, 0x37, 0xe4, 0x33, 0xf5, 0x3c, 0x02, 0x0a, 0x1d, 0xc2, 0x01, 0xc2, 0x02, 0xc2, 0x03, // 0x8940,
+    0x12, 0x0d, 0x0d, 0x75, 0x1e, 0x70, 0xd2, 0x35, 0x02, 0x0a, 0x1d, 0x02, 0x0a, 0x04, 0x85, 0x40, // 0x8950,
+    0x4a, 0x85, 0x3c, 0x4b, 0x12, 0x0a, 0xff, 0x02, 0x0a, 0x1d, 0x85, 0x4a, 0x40, 0x85, 0x4b, 0x3c, // 0x8960,
+    0x02, 0x0a, 0x1d, 0xe4, 0xf5, 0x22, 0xf5, 0x23, 0x85, 0x40, 0x31, 0x85, 0x3f, 0x30, 0x85, 0x3e, // 0x8970,
+    0x2f, 0x85, 0x3d, 0x2e, 0x12, 0x0f, 0x46, 0x80, 0x1f, 0x75, 0x22, 0x00, 0x75, 0x23, 0x01, 0x74, // 0x8980,
+    0xff, 0xf5, 0x2d, 0xf5, 0x2c, 0xf5, 0x2b, 0xf5, 0x2a, 0x12, 0x0f, 0x46, 0x85, 0x2d, 0x40, 0x85, // 0x8990,
+    0x2c, 0x3f, 0x85, 0x2b, 0x3e, 0x85, 0x2a, 0x3d, 0xe4, 0xf5, 0x3c, 0x80, 0x70, 0x12, 0x0f, 0x16, // 0x89a0,
+    0x80, 0x6b, 0x85, 0x3d, 0x45, 0x85, 0x3e, 0x46, 0xe5, 0x47, 0xc3, 0x13, 0xff, 0xe5, 0x45, 0xc3, // 0x89b0,
+    0x9f, 0x50, 0x02, 0x8f, 0x45, 0xe5, 0x48, 0xc3, 0x13, 0xff, 0xe5, 0x46, 0xc3, 0x9f, 0x50, 0x02, // 0x89c0,
+    0x8f, 0x46, 0xe5, 0x47, 0xc3, 0x13, 0xff, 0xfd, 0xe5, 0x45, 0x2d, 0xfd, 0xe4, 0x33, 0xfc, 0xe5, // 0x89d0,
+    0x44, 0x12, 0x0f, 0x90, 0x40, 0x05, 0xe5, 0x44, 0x9f, 0xf5, 0x45, 0xe5, 0x48, 0xc3, 0x13, 0xff, // 0x89e0,
+    0xfd, 0xe5, 0x46, 0x2d, 0xfd, 0xe4, 0x33, 0xfc, 0xe5, 0x43, 0x12, 0x0f, 0x90, 0x40, 0x05, 0xe5, // 0x89f0,
+    0x43, 0x9f, 0xf5, 0x46, 0x12, 0x06, 0xd7, 0x80, 0x14, 0x85, 0x40, 0x48, 0x85, 0x3f, 0x47, 0x85, // 0x8a00,
+    0x3e, 0x46, 0x85, 0x3d, 0x45, 0x80, 0x06, 0x02, 0x06, 0xd7, 0x12, 0x0d, 0x7e, 0x90, 0x30, 0x24, // 0x8a10,
+    0xe5, 0x3d, 0xf0, 0xa3, 0xe5, 0x3e, 0xf0, 0xa3, 0xe5, 0x3f, 0xf0, 0xa3, 0xe5, 0x40, 0xf0, 0xa3, // 0x8a20,
+    0xe5, 0x3c, 0xf0, 0x90, 0x30, 0x23, 0xe4, 0xf0, 0x22, 0xc0, 0xe0, 0xc0, 0x83, 0xc0, 0x82, 0xc0, // 0x8a30,
+    0xd0, 0x90, 0x3f, 0x0c, 0xe0, 0xf5, 0x32, 0xe5, 0x32, 0x30, 0xe3, 0x74, 0x30, 0x36, 0x66, 0x90, // 0x8a40,
+    0x60, 0x19, 0xe0, 0xf5, 0x0a, 0xa3, 0xe0, 0xf5, 0x0b, 0x90, 0x60, 0x1d, 0xe0, 0xf5, 0x14, 0xa3, // 0x8a50,
+    0xe0, 0xf5, 0x15, 0x90, 0x60, 0x21, 0xe0, 0xf5, 0x0c, 0xa3, 0xe0, 0xf5, 0x0d, 0x90, 0x60, 0x29, // 0x8a60,
+    0xe0, 0xf5, 0x0e, 0xa3, 0xe0, 0xf5, 0x0f, 0x90, 0x60, 0x31, 0xe0, 0xf5, 0x10, 0xa3, 0xe0, 0xf5, // 0x8a70,
+    0x11, 0x90, 0x60, 0x39, 0xe0, 0xf5, 0x12, 0xa3, 0xe0, 0xf5, 0x13, 0x30, 0x01, 0x06, 0x30, 0x33, // 0x8a80,
+    0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x09, 0x30, 0x02, 0x06, 0x30, 0x33, 0x03, 0xd3, 0x80, 0x01, // 0x8a90,
+    0xc3, 0x92, 0x0a, 0x30, 0x33, 0x0c, 0x30, 0x03, 0x09, 0x20, 0x02, 0x06, 0x20, 0x01, 0x03, 0xd3, // 0x8aa0,
+    0x80, 0x01, 0xc3, 0x92, 0x0b, 0x90, 0x30, 0x01, 0xe0, 0x44, 0x40, 0xf0, 0xe0, 0x54, 0xbf, 0xf0, // 0x8ab0,
+    0xe5, 0x32, 0x30, 0xe1, 0x14, 0x30, 0x34, 0x11, 0x90, 0x30, 0x22, 0xe0, 0xf5, 0x08, 0xe4, 0xf0, // 0x8ac0,
+    0x30, 0x00, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x08, 0xe5, 0x32, 0x30, 0xe5, 0x12, 0x90, 0x56, // 0x8ad0,
+    0xa1, 0xe0, 0xf5, 0x09, 0x30, 0x31, 0x09, 0x30, 0x05, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x0d, // 0x8ae0,
+    0x90, 0x3f, 0x0c, 0xe5, 0x32, 0xf0, 0xd0, 0xd0, 0xd0, 0x82, 0xd0, 0x83, 0xd0, 0xe0, 0x32, 0x90, // 0x8af0,
     0x0e, 0x7e, 0xe4, 0x93, 0xfe, 0x74, 0x01, 0x93, 0xff, 0xc3, 0x90, 0x0e, 0x7c, 0x74, 0x01, 0x93, // 0x8b00,
     0x9f, 0xff, 0xe4, 0x93, 0x9e, 0xfe, 0xe4, 0x8f, 0x3b, 0x8e, 0x3a, 0xf5, 0x39, 0xf5, 0x38, 0xab, // 0x8b10,
     0x3b, 0xaa, 0x3a, 0xa9, 0x39, 0xa8, 0x38, 0xaf, 0x4b, 0xfc, 0xfd, 0xfe, 0x12, 0x05, 0x28, 0x12, // 0x8b20,
@@ -2590,312 +4261,2384 @@ const uint8_t OV5640_AF_Config[] = {
     0x93, 0xf5, 0x82, 0x8e, 0x83, 0x22, 0x78, 0x7f, 0xe4, 0xf6, 0xd8, 0xfd, 0x75, 0x81, 0xcd, 0x02, // 0x8fd0,
     0x0c, 0x98, 0x8f, 0x82, 0x8e, 0x83, 0x75, 0xf0, 0x04, 0xed, 0x02, 0x06, 0xa5,                   // 0x8fe0
 };
+#endif
+
+int32_t OV5640_OutSize_Set(OV5640_Object_t *pObj, uint16_t offx, uint16_t offy, uint16_t width, uint16_t height) {
+    int32_t ret = OV5640_OK;
+
+    OV5640_RegVal_t datas[] = {
+        {0x3808,    width >> 8},
+        {0x3809,  width & 0xff},
+        {0x380a,   height >> 8},
+        {0x380b, height & 0xff},
+        {0x3810,     offx >> 8},
+        {0x3811,   offx & 0xff},
+        {0x3812,     offy >> 8},
+        {0x3813,   offy & 0xff}
+    };
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_GroupOpen(pObj) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        if (OV5640_WriteTable(pObj, datas, OV5640_TABLE_LEN(datas)) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        if (OV5640_GroupClose(pObj) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+int32_t OV5640_ImageWin_Set(OV5640_Object_t *pObj, uint16_t offx, uint16_t offy, uint16_t width, uint16_t height) {
+    uint16_t xst, yst, xend, yend;
+    xst  = offx;
+    yst  = offy;
+    xend = offx + width - 1;
+    yend = offy + height - 1;
+
+    int32_t ret = OV5640_OK;
+
+    //
+    OV5640_RegVal_t datas[] = {
+        {0X3800,    xst >> 8},
+        {0X3801,  xst & 0XFF},
+        {0X3802,    yst >> 8},
+        {0X3803,  yst & 0XFF},
+        {0X3804,   xend >> 8},
+        {0X3805, xend & 0XFF},
+        {0X3806,   yend >> 8},
+        {0X3807, yend & 0XFF}
+    };
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_GroupOpen(pObj) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        if (OV5640_WriteTable(pObj, datas, OV5640_TABLE_LEN(datas)) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        if (OV5640_GroupClose(pObj) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+#if (OV5640_CFG_JPEG == 1U)
+int32_t OV5640_JPEG_Mode(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_WriteTable(pObj, OV5640_jpeg_reg_tbl, OV5640_TABLE_LEN(OV5640_jpeg_reg_tbl)) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+
+    pObj->pProfile      = NULL;
+    pObj->CustomReadout = 0U;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+#endif
+
+int32_t OV5640_RGB565_Mode(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_WriteTable(pObj, ov5640_rgb565_reg_tbl, OV5640_TABLE_LEN(ov5640_rgb565_reg_tbl)) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+
+    pObj->pProfile      = NULL;
+    pObj->CustomReadout = 0U;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+#if (OV5640_CFG_JPEG == 1U)
+/**
+ * @brief  Set the JPEG quantization scale
+ * @param  pObj    pointer to component object
+ * @param  QScale  OV5640_JPEG_QSCALE_MIN (best quality) to OV5640_JPEG_QSCALE_MAX
+ * @retval Component status
+ */
+int32_t OV5640_JPEG_SetQScale(OV5640_Object_t *pObj, uint8_t QScale) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((QScale < OV5640_JPEG_QSCALE_MIN) || (QScale > OV5640_JPEG_QSCALE_MAX)) {
+        ret = OV5640_ERROR;
+    }
+    else if (ov5640_read_reg(&pObj->Ctx, OV5640_JPEG_CTRL07, &tmp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        /* The scale is bits[5:0], keep bits[7:6] */
+        tmp = (uint8_t)((tmp & (uint8_t)~OV5640_JPEG_QSCALE_MAX) | QScale);
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_JPEG_CTRL07, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    if (ret == OV5640_OK) {
+        pObj->JPEGRate.QScale = QScale;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Start controlling the JPEG quality from the reported frame sizes
+ * @note   The controller starts from the quantization scale programmed by
+ *         the current mode. Restart it after OV5640_JPEG_Mode or
+ *         OV5640_SetPixelFormat, which program their own scale.
+ * @param  pObj        pointer to component object
+ * @param  TargetSize  target compressed bytes per frame, 0 to stop the control
+ * @param  MinQScale   best quality allowed, OV5640_JPEG_QSCALE_MIN or more
+ * @param  MaxQScale   strongest compression allowed, OV5640_JPEG_QSCALE_MAX or less
+ * @retval Component status
+ */
+int32_t OV5640_JPEG_StartRateControl(OV5640_Object_t *pObj, uint32_t TargetSize, uint8_t MinQScale,
+                                     uint8_t MaxQScale) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    pObj->JPEGRate.TargetSize = 0;
+
+    if (TargetSize == 0U) {
+        ret = OV5640_OK;
+    }
+    else if ((MinQScale < OV5640_JPEG_QSCALE_MIN) || (MaxQScale > OV5640_JPEG_QSCALE_MAX) ||
+             (MinQScale > MaxQScale)) {
+        ret = OV5640_ERROR;
+    }
+    else if (ov5640_read_reg(&pObj->Ctx, OV5640_JPEG_CTRL07, &tmp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->JPEGRate.MinQScale = MinQScale;
+        pObj->JPEGRate.MaxQScale = MaxQScale;
+        pObj->JPEGRate.QScale    = tmp & OV5640_JPEG_QSCALE_MAX;
+
+        /* Bring the current scale within the bounds */
+        if (pObj->JPEGRate.QScale < MinQScale) {
+            ret = OV5640_JPEG_SetQScale(pObj, MinQScale);
+        }
+        else if (pObj->JPEGRate.QScale > MaxQScale) {
+            ret = OV5640_JPEG_SetQScale(pObj, MaxQScale);
+        }
+
+        if (ret == OV5640_OK) {
+            pObj->JPEGRate.TargetSize = TargetSize;
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Report the compressed size of the last JPEG frame
+ * @note   Call it once per frame, outside interrupt context, with the size
+ *         measured by the host (DMA count or EOI position). The frame size
+ *         is taken as inversely proportional to the quantization scale: a
+ *         frame above the target raises the scale at once by up to
+ *         OV5640_JPEG_QSTEP_UP, a frame below the dead band lowers it one
+ *         step per frame, so the size converges from above and the buffers
+ *         can be sized for TargetSize.
+ * @param  pObj       pointer to component object
+ * @param  FrameSize  compressed size of the last frame in bytes
+ * @retval Component status
+ */
+int32_t OV5640_JPEG_ReportFrame(OV5640_Object_t *pObj, uint32_t FrameSize) {
+    int32_t  ret    = OV5640_OK;
+    uint32_t target;
+    uint32_t qscale;
+    uint32_t wanted;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    target = pObj->JPEGRate.TargetSize;
+    qscale = pObj->JPEGRate.QScale;
+
+    if (target == 0U) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        if (FrameSize > target) {
+            /* Scale that brings the frame to the target, rounded up */
+            wanted = ((qscale * FrameSize) + target - 1U) / target;
+            if (wanted > (qscale + OV5640_JPEG_QSTEP_UP)) {
+                wanted = qscale + OV5640_JPEG_QSTEP_UP;
+            }
+        }
+        else if ((FrameSize < (target - OV5640_JPEG_DEADBAND(target))) && (qscale > OV5640_JPEG_QSTEP_DOWN)) {
+            /* Step down only when the predicted size still fits the target */
+            wanted = qscale - OV5640_JPEG_QSTEP_DOWN;
+            if ((FrameSize * qscale) > (target * wanted)) {
+                wanted = qscale;
+            }
+        }
+        else {
+            wanted = qscale;
+        }
+
+        if (wanted < pObj->JPEGRate.MinQScale) {
+            wanted = pObj->JPEGRate.MinQScale;
+        }
+        if (wanted > pObj->JPEGRate.MaxQScale) {
+            wanted = pObj->JPEGRate.MaxQScale;
+        }
+
+        if (wanted != qscale) {
+            ret = OV5640_JPEG_SetQScale(pObj, (uint8_t)wanted);
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+#endif
+
+/**
+ * @brief  Switch between the sensor AEC/AGC and manual exposure and gain
+ * @note   Enabling reads the exposure and gain in use into the shadow of
+ *         0x3500 ~ 0x350B, so manual control starts from the last automatic
+ *         values without a jump.
+ * @param  pObj    pointer to component object
+ * @param  Enable  1 for manual exposure and gain, 0 for the sensor AEC/AGC
+ * @retval Component status
+ */
+int32_t OV5640_SetManualExposure(OV5640_Object_t *pObj, uint32_t Enable) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    pObj->AEC.Manual = 0U;
+
+    if (ov5640_read_reg(&pObj->Ctx, OV5640_AEC_PK_EXPOSURE_19_16, pObj->AEC.Regs, OV5640_AEC_SHADOW_SIZE) !=
+        OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        tmp = pObj->AEC.Regs[OV5640_AEC_PK_MANUAL - OV5640_AEC_PK_EXPOSURE_19_16];
+        tmp = (Enable != 0U) ? (uint8_t)(tmp | OV5640_AEC_MANUAL_MASK) : (uint8_t)(tmp & ~OV5640_AEC_MANUAL_MASK);
+
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_AEC_PK_MANUAL, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            pObj->AEC.Regs[OV5640_AEC_PK_MANUAL - OV5640_AEC_PK_EXPOSURE_19_16] = tmp;
+            pObj->AEC.Manual = (Enable != 0U) ? 1U : 0U;
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Set the manual exposure and gain of the next frame
+ * @note   Only the registers differing from the shadow are sent, as one
+ *         burst inside a group hold latched on the next frame: exposure and
+ *         gain always change on the same frame, and an unchanged call costs
+ *         nothing. Call it once per frame, e.g. from the VSYNC task, after
+ *         OV5640_SetManualExposure. The exposure should stay below the frame
+ *         length (VTS - 4 lines) or the sensor stretches the frame.
+ * @param  pObj      pointer to component object
+ * @param  Exposure  exposure in 1/16 line, up to OV5640_EXPOSURE_MAX
+ * @param  Gain      gain in 1/16 (16 = 1x), up to OV5640_GAIN_MAX
+ * @retval Component status
+ */
+int32_t OV5640_SetExposureGain(OV5640_Object_t *pObj, uint32_t Exposure, uint16_t Gain) {
+    int32_t  ret = OV5640_OK;
+    uint8_t  regs[OV5640_AEC_SHADOW_SIZE];
+    uint32_t first;
+    uint32_t last;
+    uint32_t i;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((pObj->AEC.Manual == 0U) || (Exposure > OV5640_EXPOSURE_MAX) || (Gain > OV5640_GAIN_MAX)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        for (i = 0; i < OV5640_AEC_SHADOW_SIZE; i++) {
+            regs[i] = pObj->AEC.Regs[i];
+        }
+        regs[0]  = (uint8_t)((Exposure >> 16) & 0x0FU);
+        regs[1]  = (uint8_t)(Exposure >> 8);
+        regs[2]  = (uint8_t)Exposure;
+        regs[10] = (uint8_t)((Gain >> 8) & 0x03U);
+        regs[11] = (uint8_t)Gain;
+
+        /* Smallest span holding every change, 0x3503 ~ 0x3509 in between are resent as is */
+        first = OV5640_AEC_SHADOW_SIZE;
+        last  = 0;
+        for (i = 0; i < OV5640_AEC_SHADOW_SIZE; i++) {
+            if (regs[i] != pObj->AEC.Regs[i]) {
+                if (first == OV5640_AEC_SHADOW_SIZE) {
+                    first = i;
+                }
+                last = i;
+            }
+        }
+
+        if (first < OV5640_AEC_SHADOW_SIZE) {
+            if (OV5640_GroupWriteDelayed(pObj, (uint16_t)(OV5640_AEC_PK_EXPOSURE_19_16 + first), &regs[first],
+                                         (uint16_t)(last - first + 1U)) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                for (i = first; i <= last; i++) {
+                    pObj->AEC.Regs[i] = regs[i];
+                }
+            }
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Read the exposure and gain in use, from the AEC/AGC or manual
+ * @param  pObj       pointer to component object
+ * @param  pExposure  exposure in 1/16 line
+ * @param  pGain      gain in 1/16 (16 = 1x)
+ * @retval Component status
+ */
+int32_t OV5640_GetExposureGain(OV5640_Object_t *pObj, uint32_t *pExposure, uint16_t *pGain) {
+    int32_t ret = OV5640_OK;
+    uint8_t regs[OV5640_AEC_SHADOW_SIZE];
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (ov5640_read_reg(&pObj->Ctx, OV5640_AEC_PK_EXPOSURE_19_16, regs, OV5640_AEC_SHADOW_SIZE) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        *pExposure = ((uint32_t)(regs[0] & 0x0FU) << 16) | ((uint32_t)regs[1] << 8) | regs[2];
+        *pGain     = (uint16_t)(((uint16_t)(regs[10] & 0x03U) << 8) | regs[11]);
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Set the window metered by the AEC, in output image pixels
+ * @note   Sent as one burst latched on the next frame, like the exposure.
+ * @param  pObj    pointer to component object
+ * @param  X       left column of the window
+ * @param  Y       top row of the window
+ * @param  Width   window width
+ * @param  Height  window height
+ * @retval Component status
+ */
+int32_t OV5640_SetAECWindow(OV5640_Object_t *pObj, uint16_t X, uint16_t Y, uint16_t Width, uint16_t Height) {
+    int32_t ret = OV5640_OK;
+    uint8_t regs[8];
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((X > OV5640_AEC_WINDOW_MAX) || (Y > OV5640_AEC_WINDOW_MAX) || (Width > OV5640_AEC_WINDOW_MAX) ||
+        (Height > OV5640_AEC_WINDOW_MAX)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        /* 0x5680 ~ 0x5687: X start, Y start, X window, Y window */
+        regs[0] = (uint8_t)(X >> 8);
+        regs[1] = (uint8_t)X;
+        regs[2] = (uint8_t)(Y >> 8);
+        regs[3] = (uint8_t)Y;
+        regs[4] = (uint8_t)(Width >> 8);
+        regs[5] = (uint8_t)Width;
+        regs[6] = (uint8_t)(Height >> 8);
+        regs[7] = (uint8_t)Height;
+
+        ret     = OV5640_GroupWriteDelayed(pObj, OV5640_X_START_HIGH, regs, (uint16_t)sizeof(regs));
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Read the measurements the sensor made for its AEC and AWB
+ * @note   Each block is one burst read: 17 bytes from 0x5691 for the luma
+ *         averages, 9 bytes from 0x519F for the AWB gains and averages, 12
+ *         bytes from 0x3500 for the exposure and gain. The values are
+ *         updated by the sensor once per frame, read them e.g. from the
+ *         frame end event.
+ * @param  pObj    pointer to component object
+ * @param  Blocks  OV5640_SENSOR_STATS_xxx combination, the other fields of
+ *                 pStats are left untouched
+ * @param  pStats  filled with the measurements
+ * @retval Component status
+ */
+int32_t OV5640_GetSensorStats(OV5640_Object_t *pObj, uint32_t Blocks, OV5640_SensorStats_t *pStats) {
+    int32_t  ret = OV5640_OK;
+    uint8_t  regs[OV5640_LUMA_ZONES + 1U];
+    uint32_t i;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((pStats == NULL) || (Blocks == 0U) || ((Blocks & ~OV5640_SENSOR_STATS_ALL) != 0U)) {
+        ret = OV5640_ERROR;
+    }
+    else if ((Blocks & OV5640_SENSOR_STATS_LUMA) != 0U) {
+        /* 0x5691 ~ 0x56A0 windows, then 0x56A1 whole AEC window */
+        if (ov5640_read_reg(&pObj->Ctx, OV5640_AVG_WIN_00, regs, (uint16_t)(OV5640_LUMA_ZONES + 1U)) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            for (i = 0; i < OV5640_LUMA_ZONES; i++) {
+                pStats->ZoneLuma[i] = regs[i];
+            }
+            pStats->Luma = regs[OV5640_LUMA_ZONES];
+        }
+    }
+
+    if ((ret == OV5640_OK) && ((Blocks & OV5640_SENSOR_STATS_AWB) != 0U)) {
+        /* 0x519F ~ 0x51A4 R, G, B gains [11:0], then 0x51A5 ~ 0x51A7 averages */
+        if (ov5640_read_reg(&pObj->Ctx, OV5640_AWB_CURRENT_R_GAIN_HIGH, regs, 9) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            for (i = 0; i < 3U; i++) {
+                pStats->AWBGain[i]    = (uint16_t)(((uint16_t)(regs[2U * i] & 0x0FU) << 8) | regs[(2U * i) + 1U]);
+                pStats->AWBAverage[i] = regs[6U + i];
+            }
+        }
+    }
+
+    if ((ret == OV5640_OK) && ((Blocks & OV5640_SENSOR_STATS_AEC) != 0U)) {
+        if (ov5640_read_reg(&pObj->Ctx, OV5640_AEC_PK_EXPOSURE_19_16, regs, OV5640_AEC_SHADOW_SIZE) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            pStats->Exposure = ((uint32_t)(regs[0] & 0x0FU) << 16) | ((uint32_t)regs[1] << 8) | regs[2];
+            pStats->Gain     = (uint16_t)(((uint16_t)(regs[10] & 0x03U) << 8) | regs[11]);
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+int32_t OV5640_Init_General_Mode(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat) {
+    int32_t ret = OV5640_OK;
+
+    if (pObj->IsInitialized == 0U) {
+        ret = OV5640_Init_General_Config(pObj, Resolution, PixelFormat);
+
+#if (OV5640_CFG_AF == 1U)
+        if ((ret == OV5640_OK) && (OV5640_Focus_Init(pObj) != OV5640_OK)) {
+            ret = OV5640_ERROR;
+        }
+#endif
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Apply the OV5640_Init_General_Mode configuration without the AF firmware
+ * @note   Used to interleave the configuration of several sensors with the
+ *         boot of their AF firmware, see OV5640_Focus_Upload.
+ * @param  pObj         pointer to component object
+ * @param  Resolution   index in solution_table
+ * @param  PixelFormat  OV5640_RGB565 or OV5640_JPEG
+ * @retval Component status
+ */
+int32_t OV5640_Init_General_Config(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    /* Check if resolution is supported */
+    if ((Resolution > OV5640_R2592x1944) ||
+        ((PixelFormat != OV5640_RGB565) && (PixelFormat != OV5640_JPEG))) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_Init_General_Common(pObj) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_Init_General_Format(pObj, Resolution, PixelFormat) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Write the common part of the OV5640_Init_General_Mode configuration
+ * @note   Write-only, it can go through a broadcast IO reaching several sensors.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Init_General_Common(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    /* Set common parameters for all resolutions */
+    if (OV5640_WriteTable(pObj, ov5640_uxga_init_reg_tbl, OV5640_TABLE_LEN(ov5640_uxga_init_reg_tbl)) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    pObj->AEC.Manual = 0U;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Apply the pixel format and resolution of OV5640_Init_General_Mode
+ * @note   To be called after OV5640_Init_General_Common.
+ * @param  pObj         pointer to component object
+ * @param  Resolution   index in solution_table
+ * @param  PixelFormat  OV5640_RGB565 or OV5640_JPEG
+ * @retval Component status
+ */
+int32_t OV5640_Init_General_Format(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((Resolution > OV5640_R2592x1944) ||
+        ((PixelFormat != OV5640_RGB565) && (PixelFormat != OV5640_JPEG))) {
+        ret = OV5640_ERROR;
+    }
+#if (OV5640_CFG_JPEG != 1U)
+    else if (PixelFormat == OV5640_JPEG) {
+        /* JPEG output compiled out */
+        ret = OV5640_ERROR;
+    }
+#endif
+    else {
+        pObj->Standby.Resolution  = Resolution;
+        pObj->Standby.PixelFormat = PixelFormat;
+
+        if (PixelFormat == OV5640_RGB565) {
+            if (OV5640_RGB565_Mode(pObj) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+        }
+#if (OV5640_CFG_JPEG == 1U)
+        else if (OV5640_JPEG_Mode(pObj) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+#endif
+
+        if (ret == OV5640_OK) {
+            if (OV5640_Set_Solution_More(pObj, Resolution) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else if (OV5640_SetPolarities(pObj, OV5640_POLARITY_PCLK_HIGH, OV5640_POLARITY_HREF_HIGH, OV5640_POLARITY_VSYNC_HIGH) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+int32_t OV5640_Set_Solution_More(OV5640_Object_t *pObj, uint32_t solution) {
+    return OV5640_OutSize_Set(pObj, 4, 0, solution_table[solution][0], solution_table[solution][1]);
+}
+
+/**
+ * @brief  Precompute the register image of a sensor mode
+ * @note   The image holds the values OV5640_Init_General_Mode, then
+ *         OV5640_SetPixelFormat and OV5640_SetPCLK, leave in the timing, PLL
+ *         and format registers. It is built without bus access and can be
+ *         kept in flash or RAM for the lifetime of the application.
+ * @param  pProfile     pointer to the profile to build
+ * @param  Resolution   index in solution_table, OV5640_R160x120 to OV5640_R2592x1944
+ * @param  PixelFormat  OV5640_RGB565, OV5640_YUV422, OV5640_RGB888, OV5640_Y8 or OV5640_JPEG
+ * @param  PixelClock   OV5640_PCLK_xxx preset or OV5640_PROFILE_PCLK_AUTO
+ * @retval Component status
+ */
+int32_t OV5640_BuildModeProfile(OV5640_ModeProfile_t *pProfile, uint32_t Resolution, uint32_t PixelFormat,
+                                uint32_t PixelClock) {
+    int32_t         ret = OV5640_OK;
+    OV5640_RegVal_t out[8];
+    OV5640_RegVal_t pll[2];
+    uint16_t        width;
+    uint16_t        height;
+    uint32_t        i;
+
+    if ((pProfile == NULL) || (Resolution > OV5640_R2592x1944) ||
+        ((PixelClock != OV5640_PROFILE_PCLK_AUTO) && (PixelClock != OV5640_PCLK_7M) &&
+         (PixelClock != OV5640_PCLK_8M) && (PixelClock != OV5640_PCLK_9M) && (PixelClock != OV5640_PCLK_12M) &&
+         (PixelClock != OV5640_PCLK_24M) && (PixelClock != OV5640_PCLK_48M))) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        for (i = 0; i < OV5640_PROFILE_NUM_REGS; i++) {
+            pProfile->Value[i]   = 0;
+            pProfile->Defined[i] = 0U;
+        }
+
+        /* Start from the general mode base setting */
+        OV5640_ProfileReplay(pProfile, ov5640_uxga_init_reg_tbl, OV5640_TABLE_LEN(ov5640_uxga_init_reg_tbl));
+
+        switch (PixelFormat) {
+#if (OV5640_CFG_JPEG == 1U)
+        case OV5640_JPEG:
+            OV5640_ProfileReplay(pProfile, OV5640_jpeg_reg_tbl, OV5640_TABLE_LEN(OV5640_jpeg_reg_tbl));
+            OV5640_ProfileReplay(pProfile, OV5640_PF_JPEG, OV5640_TABLE_LEN(OV5640_PF_JPEG));
+            break;
+#endif
+        case OV5640_RGB565:
+            OV5640_ProfileReplay(pProfile, ov5640_rgb565_reg_tbl, OV5640_TABLE_LEN(ov5640_rgb565_reg_tbl));
+            OV5640_ProfileReplay(pProfile, OV5640_PF_RGB565, OV5640_TABLE_LEN(OV5640_PF_RGB565));
+            break;
+        case OV5640_YUV422:
+            OV5640_ProfileReplay(pProfile, ov5640_rgb565_reg_tbl, OV5640_TABLE_LEN(ov5640_rgb565_reg_tbl));
+            OV5640_ProfileReplay(pProfile, OV5640_PF_YUV422, OV5640_TABLE_LEN(OV5640_PF_YUV422));
+            break;
+        case OV5640_RGB888:
+            OV5640_ProfileReplay(pProfile, ov5640_rgb565_reg_tbl, OV5640_TABLE_LEN(ov5640_rgb565_reg_tbl));
+            OV5640_ProfileReplay(pProfile, OV5640_PF_RGB888, OV5640_TABLE_LEN(OV5640_PF_RGB888));
+            break;
+        case OV5640_Y8:
+            OV5640_ProfileReplay(pProfile, ov5640_rgb565_reg_tbl, OV5640_TABLE_LEN(ov5640_rgb565_reg_tbl));
+            OV5640_ProfileReplay(pProfile, OV5640_PF_Y8, OV5640_TABLE_LEN(OV5640_PF_Y8));
+            break;
+        default:
+            ret = OV5640_ERROR;
+            break;
+        }
+    }
+
+    if (ret == OV5640_OK) {
+        /* Output size and offsets as set by OV5640_Set_Solution_More */
+        width         = solution_table[Resolution][0];
+        height        = solution_table[Resolution][1];
+        out[0].Reg    = 0x3808;
+        out[0].Value  = (uint8_t)(width >> 8);
+        out[1].Reg    = 0x3809;
+        out[1].Value  = (uint8_t)(width & 0xFFU);
+        out[2].Reg    = 0x380a;
+        out[2].Value  = (uint8_t)(height >> 8);
+        out[3].Reg    = 0x380b;
+        out[3].Value  = (uint8_t)(height & 0xFFU);
+        out[4].Reg    = 0x3810;
+        out[4].Value  = 0x00;
+        out[5].Reg    = 0x3811;
+        out[5].Value  = 0x04;
+        out[6].Reg    = 0x3812;
+        out[6].Value  = 0x00;
+        out[7].Reg    = 0x3813;
+        out[7].Value  = 0x00;
+        OV5640_ProfileReplay(pProfile, out, OV5640_TABLE_LEN(out));
+
+        if (PixelClock != OV5640_PROFILE_PCLK_AUTO) {
+            OV5640_GetPCLKRegs(PixelClock, pll);
+            OV5640_ProfileReplay(pProfile, pll, OV5640_TABLE_LEN(pll));
+        }
+
+        pProfile->Resolution  = Resolution;
+        pProfile->PixelFormat = PixelFormat;
+        pProfile->PixelClock  = PixelClock;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Compute the register table switching the sensor between two profiles
+ * @note   Only registers whose value differs are emitted, wrapped in a group
+ *         hold so that the new mode takes effect on a single frame boundary.
+ *         The table can be written with OV5640_WriteTable or queued with
+ *         OV5640_SubmitTable. No update is needed when Size is returned as 0.
+ * @param  pFrom   profile currently applied, NULL to emit the whole profile
+ * @param  pTo     profile to switch to
+ * @param  pDelta  destination table, OV5640_PROFILE_DELTA_SIZE entries
+ * @param  pSize   filled with the number of entries of the table
+ * @retval Component status
+ */
+int32_t OV5640_GetModeProfileDelta(const OV5640_ModeProfile_t *pFrom, const OV5640_ModeProfile_t *pTo,
+                                   OV5640_RegVal_t *pDelta, uint32_t *pSize) {
+    int32_t  ret  = OV5640_OK;
+    uint32_t size = 0;
+    uint32_t i;
+
+    if ((pTo == NULL) || (pDelta == NULL) || (pSize == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pDelta[size].Reg   = OV5640_SRM_GROUP_ACCESS;
+        pDelta[size].Value = OV5640_GROUP_HOLD_START(OV5640_GROUP_DEFAULT);
+        size++;
+
+        for (i = 0; i < OV5640_PROFILE_NUM_REGS; i++) {
+            if ((pTo->Defined[i] != 0U) &&
+                ((pFrom == NULL) || (pFrom->Defined[i] == 0U) || (pFrom->Value[i] != pTo->Value[i]))) {
+                pDelta[size].Reg   = OV5640_ProfileRegs[i];
+                pDelta[size].Value = pTo->Value[i];
+                size++;
+            }
+        }
+
+        if (size == 1U) {
+            size = 0;
+        }
+        else {
+            pDelta[size].Reg   = OV5640_SRM_GROUP_ACCESS;
+            pDelta[size].Value = OV5640_GROUP_HOLD_END(OV5640_GROUP_DEFAULT);
+            size++;
+            pDelta[size].Reg   = OV5640_SRM_GROUP_ACCESS;
+            pDelta[size].Value = OV5640_GROUP_QUICK_LAUNCH(OV5640_GROUP_DEFAULT);
+            size++;
+        }
+        *pSize = size;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Switch the sensor to a precomputed mode profile
+ * @note   Only the difference with the profile applied last is written. The
+ *         whole profile is written when the current mode is unknown, e.g.
+ *         after a resolution, format, clock or mirror/flip setter was used.
+ * @param  pObj      pointer to component object
+ * @param  pProfile  profile to switch to, must stay valid while applied
+ * @retval Component status
+ */
+int32_t OV5640_SwitchModeProfile(OV5640_Object_t *pObj, const OV5640_ModeProfile_t *pProfile) {
+    int32_t         ret = OV5640_OK;
+    OV5640_RegVal_t delta[OV5640_PROFILE_DELTA_SIZE];
+    uint32_t        size;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_GetModeProfileDelta(pObj->pProfile, pProfile, delta, &size) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if ((pObj->GroupActive != 0U) && (size != 0U)) {
+        /* Part of the open batch: drop the delta own group hold control */
+        if (OV5640_WriteTable(pObj, &delta[1], size - 3U) != OV5640_OK) {
+            pObj->pProfile = NULL;
+            ret            = OV5640_ERROR;
+        }
+        else {
+            pObj->pProfile = pProfile;
+        }
+    }
+    else if (OV5640_WriteTable(pObj, delta, size) != OV5640_OK) {
+        pObj->pProfile = NULL;
+        ret            = OV5640_ERROR;
+    }
+    else {
+        pObj->pProfile = pProfile;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Precompute the power profiles of a sensor
+ * @note   The streaming profile is built as by OV5640_BuildModeProfile. The
+ *         monitor profile uses the lowest pixel clock preset, VTS stretched
+ *         to the monitor frame rate and the AEC allowed to expose the whole
+ *         frame. Built without bus access.
+ * @param  pProfiles  pointer to the profiles to build
+ * @param  pConfig    streaming and monitor modes
+ * @retval Component status, OV5640_ERROR when a mode is not supported
+ */
+int32_t OV5640_BuildPowerProfiles(OV5640_PowerProfiles_t *pProfiles, const OV5640_PowerConfig_t *pConfig) {
+    int32_t         ret = OV5640_OK;
+    OV5640_RegVal_t frame[6];
+    uint32_t        hts;
+    uint32_t        vts;
+    uint32_t        lines;
+
+    if ((pProfiles == NULL) || (pConfig == NULL) || (pConfig->MonitorFrameRate == 0U)) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_BuildModeProfile(&pProfiles->Streaming, pConfig->Resolution, pConfig->PixelFormat,
+                                     pConfig->PixelClock) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_BuildModeProfile(&pProfiles->Monitor, pConfig->MonitorResolution, pConfig->MonitorFormat,
+                                     OV5640_PCLK_7M) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        hts = ((uint32_t)OV5640_ProfileGet(&pProfiles->Monitor, OV5640_TIMING_HTS_HIGH) << 8) |
+              OV5640_ProfileGet(&pProfiles->Monitor, OV5640_TIMING_HTS_LOW);
+        vts = ((uint32_t)OV5640_ProfileGet(&pProfiles->Monitor, OV5640_TIMING_VTS_HIGH) << 8) |
+              OV5640_ProfileGet(&pProfiles->Monitor, OV5640_TIMING_VTS_LOW);
+
+        if (hts == 0U) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            /* OV5640_PCLKFreq starts with the OV5640_PCLK_7M preset */
+            lines = OV5640_PCLKFreq[0][1] / (hts * pConfig->MonitorFrameRate);
+            if (lines > 0xFFFFU) {
+                lines = 0xFFFFU;
+            }
+
+            /* Above the mode frame rate, the monitor keeps the mode VTS */
+            if (lines > vts) {
+                frame[0].Reg   = OV5640_TIMING_VTS_HIGH;
+                frame[0].Value = (uint8_t)(lines >> 8);
+                frame[1].Reg   = OV5640_TIMING_VTS_LOW;
+                frame[1].Value = (uint8_t)(lines & 0xFFU);
+                frame[2].Reg   = OV5640_AEC_CTRL02;
+                frame[2].Value = (uint8_t)(lines >> 8);
+                frame[3].Reg   = OV5640_AEC_CTRL03;
+                frame[3].Value = (uint8_t)(lines & 0xFFU);
+                frame[4].Reg   = OV5640_AEC_MAX_EXPO_HIGH;
+                frame[4].Value = (uint8_t)(lines >> 8);
+                frame[5].Reg   = OV5640_AEC_MAX_EXPO_LOW;
+                frame[5].Value = (uint8_t)(lines & 0xFFU);
+                OV5640_ProfileReplay(&pProfiles->Monitor, frame, OV5640_TABLE_LEN(frame));
+            }
+
+            pProfiles->Pad[0] = 0;
+            pProfiles->Pad[1] = 0;
+            pProfiles->State  = OV5640_POWER_UNKNOWN;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Switch the sensor to one of its power profiles
+ * @note   Between streaming and monitor, only the mode profile delta is
+ *         written, in a group hold taking effect on the next frame. From
+ *         standby the delta is written directly and the sensor wakes up in
+ *         the new mode. Standby is a single write to SYSTEM_CTROL0, pad-off
+ *         saves then clears the pad enables. Use OV5640_Suspend and
+ *         OV5640_Resume when the sensor supply can drop in standby.
+ * @param  pObj       pointer to component object
+ * @param  pProfiles  profiles built by OV5640_BuildPowerProfiles, must stay
+ *                    valid while applied
+ * @param  Profile    OV5640_POWER_STREAMING, MONITOR, STANDBY or PAD_OFF
+ * @retval Component status
+ */
+int32_t OV5640_SetPowerProfile(OV5640_Object_t *pObj, OV5640_PowerProfiles_t *pProfiles, uint32_t Profile) {
+    int32_t                     ret = OV5640_OK;
+    const OV5640_ModeProfile_t *pMode;
+    OV5640_RegVal_t             delta[OV5640_PROFILE_DELTA_SIZE];
+    uint32_t                    size;
+    uint8_t                     tmp;
+    uint8_t                     pad[2] = {0x00, 0x00};
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    /* The standby control cannot be held in an open batch */
+    if ((pProfiles == NULL) || (Profile > OV5640_POWER_PAD_OFF) || (pObj->GroupActive != 0U)) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        return OV5640_ERROR;
+    }
+
+    if (Profile == pProfiles->State) {
+        /* Nothing to do */
+    }
+    else if ((Profile == OV5640_POWER_STREAMING) || (Profile == OV5640_POWER_MONITOR)) {
+        pMode = (Profile == OV5640_POWER_STREAMING) ? &pProfiles->Streaming : &pProfiles->Monitor;
+
+        if ((pProfiles->State == OV5640_POWER_PAD_OFF) &&
+            (ov5640_write_reg(&pObj->Ctx, OV5640_PAD_OUTPUT_ENABLE01, pProfiles->Pad, 2) != OV5640_OK)) {
+            ret = OV5640_ERROR;
+        }
+        else if (OV5640_GetModeProfileDelta(pObj->pProfile, pMode, delta, &size) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else if ((pProfiles->State == OV5640_POWER_STREAMING) || (pProfiles->State == OV5640_POWER_MONITOR)) {
+            ret = OV5640_WriteTable(pObj, delta, size);
+        }
+        else {
+            /* No frame to latch a group hold on, drop its control */
+            if ((size != 0U) && (OV5640_WriteTable(pObj, &delta[1], size - 3U) != OV5640_OK)) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                tmp = 0x02;
+                ret = ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1);
+            }
+        }
+
+        pObj->pProfile = (ret == OV5640_OK) ? pMode : NULL;
+    }
+    else {
+        if (pProfiles->State == OV5640_POWER_PAD_OFF) {
+            ret = ov5640_write_reg(&pObj->Ctx, OV5640_PAD_OUTPUT_ENABLE01, pProfiles->Pad, 2);
+        }
+        else if (pProfiles->State != OV5640_POWER_STANDBY) {
+            tmp = 0x42;
+            ret = ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1);
+        }
+
+        if ((ret == OV5640_OK) && (Profile == OV5640_POWER_PAD_OFF)) {
+            if (ov5640_read_reg(&pObj->Ctx, OV5640_PAD_OUTPUT_ENABLE01, pProfiles->Pad, 2) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                ret = ov5640_write_reg(&pObj->Ctx, OV5640_PAD_OUTPUT_ENABLE01, pad, 2);
+            }
+        }
+    }
+
+    /* A failed switch leaves the sensor between two profiles */
+    pProfiles->State = (ret == OV5640_OK) ? (uint8_t)Profile : OV5640_POWER_UNKNOWN;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return (ret == OV5640_OK) ? OV5640_OK : OV5640_ERROR;
+}
+
+/**
+ * @brief  Compute the readout of an arbitrary output size
+ * @note   The readout window is centered and cropped to the output aspect
+ *         ratio, and subsampled 2x whenever that still leaves at least the
+ *         output size to the scaler, so the sensor never reads out more than
+ *         needed. HTS and VTS follow the window with the minimum blanking.
+ *         With a frame rate, the PLL is solved by OV5640_SolvePLL for an
+ *         OV5640_XCLK_FREQ input and 2 bytes per pixel (RGB565, YUV422),
+ *         within the 96MHz PCLK limit: e.g. VGA and 720p up to 30fps, 1080p
+ *         up to 15fps or 5MP up to 7fps. Call OV5640_SolvePLL directly for
+ *         another clock or pixel size.
+ * @param  Width      output width, 2592 max
+ * @param  Height     output height, 1944 max
+ * @param  FrameRate  frame rate in fps, 0 to keep the current pixel clock
+ * @param  pMode      filled with the computed mode
+ * @retval Component status, OV5640_ERROR when the frame rate cannot be met
+ */
+int32_t OV5640_ComputeOutputMode(uint16_t Width, uint16_t Height, uint32_t FrameRate, OV5640_OutputMode_t *pMode) {
+    int32_t  ret = OV5640_ERROR;
+    uint32_t sub;
+    uint32_t crop_w;
+    uint32_t crop_h;
+
+    if ((pMode != NULL) && (Width != 0U) && (Height != 0U) &&
+        (Width <= (OV5640_ARRAY_WIDTH - (2U * OV5640_ISP_HOFFSET))) &&
+        (Height <= (OV5640_ARRAY_HEIGHT - (2U * OV5640_ISP_VOFFSET)))) {
+        /* Try 2x subsampling first, then fall back to the full readout */
+        for (sub = 2U; sub > 0U; sub--) {
+            crop_w = OV5640_ARRAY_WIDTH - (2U * OV5640_ISP_HOFFSET * sub);
+            crop_h = OV5640_ARRAY_HEIGHT - (2U * OV5640_ISP_VOFFSET * sub);
+
+            /* Largest area with the output aspect ratio */
+            if (((uint32_t)Width * crop_h) >= ((uint32_t)Height * crop_w)) {
+                crop_h = (crop_w * Height) / Width;
+            }
+            else {
+                crop_w = (crop_h * Width) / Height;
+            }
+
+            /* Even number of pixels after subsampling */
+            crop_w &= ~((2U * sub) - 1U);
+            crop_h &= ~((2U * sub) - 1U);
+
+            if (((crop_w / sub) >= Width) && ((crop_h / sub) >= Height)) {
+                break;
+            }
+        }
+
+        if (sub == 0U) {
+            /* Odd size using the whole array */
+            sub    = 1U;
+            crop_w = Width;
+            crop_h = Height;
+        }
+
+        pMode->Width      = Width;
+        pMode->Height     = Height;
+        pMode->Subsample  = (uint8_t)sub;
+        pMode->XSize      = (uint16_t)(crop_w + (2U * OV5640_ISP_HOFFSET * sub));
+        pMode->YSize      = (uint16_t)(crop_h + (2U * OV5640_ISP_VOFFSET * sub));
+        pMode->XStart     = (uint16_t)(((OV5640_ARRAY_WIDTH - pMode->XSize) / 2U) & ~1U);
+        pMode->YStart     = (uint16_t)(((OV5640_ARRAY_HEIGHT - pMode->YSize) / 2U) & ~1U);
+        pMode->Hts        = (uint16_t)((pMode->XSize / sub) + ((sub == 2U) ? OV5640_HBLANK_SUBSAMPLE : OV5640_HBLANK_FULL));
+        pMode->Vts        = (uint16_t)((pMode->YSize / sub) + OV5640_VBLANK_MIN);
+        pMode->PixelClock = OV5640_PROFILE_PCLK_AUTO;
+        pMode->FrameRate  = FrameRate;
+
+        if (FrameRate == 0U) {
+            ret = OV5640_OK;
+        }
+        else {
+            /* Same readout, then the lowest PCLK and the VTS of the rate */
+            ret = OV5640_SolvePLL(OV5640_XCLK_FREQ, Width, Height, OV5640_PLL_OUTPUT_BPP, FrameRate, 0U, pMode);
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Program an output mode computed by OV5640_ComputeOutputMode
+ * @note   The window, scaler output, subsampling, HTS/VTS and the AEC
+ *         exposure limits are applied together in one group hold, after the
+ *         pixel clock.
+ * @param  pObj   pointer to component object
+ * @param  pMode  pointer to the computed mode
+ * @retval Component status
+ */
+int32_t OV5640_ApplyOutputMode(OV5640_Object_t *pObj, const OV5640_OutputMode_t *pMode) {
+    int32_t  ret  = OV5640_OK;
+    uint16_t xend = (uint16_t)(pMode->XStart + pMode->XSize - 1U);
+    uint16_t yend = (uint16_t)(pMode->YStart + pMode->YSize - 1U);
+    uint8_t  inc  = (pMode->Subsample == 2U) ? 0x31U : 0x11U;
+
+    /* 0x3800 ~ 0x3815 go out as a single burst */
+    OV5640_RegVal_t timing[] = {
+        {     OV5640_TIMING_HS_HIGH, (uint8_t)(pMode->XStart >> 8)},
+        {      OV5640_TIMING_HS_LOW, (uint8_t)(pMode->XStart & 0xFFU)},
+        {     OV5640_TIMING_VS_HIGH, (uint8_t)(pMode->YStart >> 8)},
+        {      OV5640_TIMING_VS_LOW, (uint8_t)(pMode->YStart & 0xFFU)},
+        {     OV5640_TIMING_HW_HIGH, (uint8_t)(xend >> 8)},
+        {      OV5640_TIMING_HW_LOW, (uint8_t)(xend & 0xFFU)},
+        {     OV5640_TIMING_VH_HIGH, (uint8_t)(yend >> 8)},
+        {      OV5640_TIMING_VH_LOW, (uint8_t)(yend & 0xFFU)},
+        {  OV5640_TIMING_DVPHO_HIGH, (uint8_t)(pMode->Width >> 8)},
+        {   OV5640_TIMING_DVPHO_LOW, (uint8_t)(pMode->Width & 0xFFU)},
+        {  OV5640_TIMING_DVPVO_HIGH, (uint8_t)(pMode->Height >> 8)},
+        {   OV5640_TIMING_DVPVO_LOW, (uint8_t)(pMode->Height & 0xFFU)},
+        {    OV5640_TIMING_HTS_HIGH, (uint8_t)(pMode->Hts >> 8)},
+        {     OV5640_TIMING_HTS_LOW, (uint8_t)(pMode->Hts & 0xFFU)},
+        {    OV5640_TIMING_VTS_HIGH, (uint8_t)(pMode->Vts >> 8)},
+        {     OV5640_TIMING_VTS_LOW, (uint8_t)(pMode->Vts & 0xFFU)},
+        {OV5640_TIMING_HOFFSET_HIGH, 0x00},
+        { OV5640_TIMING_HOFFSET_LOW, (uint8_t)OV5640_ISP_HOFFSET},
+        {OV5640_TIMING_VOFFSET_HIGH, 0x00},
+        { OV5640_TIMING_VOFFSET_LOW, (uint8_t)OV5640_ISP_VOFFSET},
+        {       OV5640_TIMING_X_INC, inc},
+        {       OV5640_TIMING_Y_INC, inc},
+        /* Exposure may use the whole frame */
+        {         OV5640_AEC_CTRL02, (uint8_t)(pMode->Vts >> 8)},
+        {         OV5640_AEC_CTRL03, (uint8_t)(pMode->Vts & 0xFFU)},
+        {  OV5640_AEC_MAX_EXPO_HIGH, (uint8_t)(pMode->Vts >> 8)},
+        {   OV5640_AEC_MAX_EXPO_LOW, (uint8_t)(pMode->Vts & 0xFFU)},
+    };
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (pMode->PixelClock == OV5640_PCLK_CUSTOM) {
+        ret = OV5640_SetPLL(pObj, &pMode->Pll);
+    }
+    else if (pMode->PixelClock != OV5640_PROFILE_PCLK_AUTO) {
+        ret = OV5640_SetPCLK(pObj, pMode->PixelClock);
+    }
+
+    if (ret != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_GroupOpen(pObj) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        if (OV5640_WriteTable(pObj, timing, OV5640_TABLE_LEN(timing)) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        if (OV5640_GroupClose(pObj) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    pObj->pProfile      = NULL;
+    pObj->CustomReadout = 1U;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Set an arbitrary output size and frame rate
+ * @param  pObj       pointer to component object
+ * @param  Width      output width, 2592 max
+ * @param  Height     output height, 1944 max
+ * @param  FrameRate  frame rate in fps, 0 to keep the current pixel clock
+ * @retval Component status
+ */
+int32_t OV5640_SetOutputMode(OV5640_Object_t *pObj, uint16_t Width, uint16_t Height, uint32_t FrameRate) {
+    int32_t             ret = OV5640_OK;
+    OV5640_OutputMode_t mode;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_ComputeOutputMode(Width, Height, FrameRate, &mode) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_ApplyOutputMode(pObj, &mode) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Compute the lowest pixel clock meeting a frame rate
+ * @note   The readout comes from OV5640_ComputeOutputMode. A line lasts at
+ *         least Width x BytesPerPixel PCLK cycles, the DVP sending one byte
+ *         per cycle, and the PLL is searched for the lowest
+ *         PCLK >= HTS x VTS x FrameRate, then the lowest VCO. VTS is then
+ *         stretched so the frame rate is met exactly. The PCLK is capped to
+ *         OV5640_PLL_PCLK_MAX (96MHz), rates needing more fail. Apply the
+ *         result with OV5640_ApplyOutputMode.
+ * @param  XClk           sensor input clock in Hz
+ * @param  Width          output width, 2592 max
+ * @param  Height         output height, 1944 max
+ * @param  BytesPerPixel  1 for Y8 and JPEG, 2 for RGB565 and YUV422, 3 for RGB888
+ * @param  FrameRate      frame rate in fps
+ * @param  MaxPClk        highest PCLK accepted by the host (DCMI) in Hz, 0 for the sensor limit only
+ * @param  pMode          filled with the output mode and its PLL settings
+ * @retval Component status, OV5640_ERROR when no PLL setting fits under the limits
+ */
+int32_t OV5640_SolvePLL(uint32_t XClk, uint16_t Width, uint16_t Height, uint32_t BytesPerPixel, uint32_t FrameRate,
+                        uint32_t MaxPClk, OV5640_OutputMode_t *pMode) {
+    int32_t      ret = OV5640_ERROR;
+    uint64_t     target;
+    uint32_t     hts;
+    uint32_t     vts;
+    OV5640_PLL_t best;
+
+    if ((XClk != 0U) && (BytesPerPixel != 0U) && (FrameRate != 0U) &&
+        (OV5640_ComputeOutputMode(Width, Height, 0U, pMode) == OV5640_OK)) {
+        hts = pMode->Hts;
+        if (((uint32_t)Width * BytesPerPixel) > hts) {
+            hts = (uint32_t)Width * BytesPerPixel;
+        }
+        target = (uint64_t)hts * pMode->Vts * FrameRate;
+
+        if (OV5640_SearchPLL(XClk, target, MaxPClk, &best) != 0U) {
+            vts               = best.PClk / (hts * FrameRate);
+            pMode->Hts        = (uint16_t)hts;
+            pMode->Vts        = (uint16_t)((vts > 0xFFFFU) ? 0xFFFFU : vts);
+            pMode->PixelClock = OV5640_PCLK_CUSTOM;
+            pMode->FrameRate  = FrameRate;
+            pMode->Pll        = best;
+            ret               = OV5640_OK;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Program PLL settings computed by OV5640_SolvePLL
+ * @note   The MIPI divider is kept and the manual PCLK divider is selected.
+ * @param  pObj  pointer to component object
+ * @param  pPll  pointer to the PLL settings
+ * @retval Component status
+ */
+int32_t OV5640_SetPLL(OV5640_Object_t *pObj, const OV5640_PLL_t *pPll) {
+    int32_t ret = OV5640_OK;
+    uint8_t ctrl1;
+    uint8_t vfifo;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((pPll->PreDiv == 0U) || (pPll->PreDiv > 8U) || ((pPll->RootDiv != 1U) && (pPll->RootDiv != 2U)) ||
+        (pPll->Mult < OV5640_PLL_MULT_MIN) || (pPll->SysDiv == 0U) || (pPll->SysDiv > OV5640_PLL_SYSDIV_MAX) ||
+        (pPll->PClkDiv == 0U) || (pPll->PClkDiv > OV5640_PLL_PCLKDIV_MAX)) {
+        ret = OV5640_ERROR;
+    }
+    else if (ov5640_read_reg(&pObj->Ctx, OV5640_SC_PLL_CONTRL1, &ctrl1, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (ov5640_read_reg(&pObj->Ctx, OV5640_VFIFO_CTRL0C, &vfifo, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        OV5640_RegVal_t pll[] = {
+            { OV5640_SC_PLL_CONTRL1, (uint8_t)((uint8_t)(pPll->SysDiv << 4) | (ctrl1 & 0x0FU))},
+            { OV5640_SC_PLL_CONTRL2, pPll->Mult},
+            { OV5640_SC_PLL_CONTRL3, (uint8_t)(((pPll->RootDiv == 2U) ? 0x10U : 0x00U) | pPll->PreDiv)},
+            {OV5640_PCLK_MANUAL_DIV, pPll->PClkDiv},
+            {   OV5640_VFIFO_CTRL0C, (uint8_t)(vfifo | 0x02U)},
+        };
+
+        if (OV5640_WriteTable(pObj, pll, OV5640_TABLE_LEN(pll)) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    pObj->pProfile = NULL;
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Compute a 1:1 readout of a region at the highest frame rate
+ * @note   X and Y are relative to the 2592x1944 area the ISP delivers, not
+ *         to the readable array: the readout window starts at (X, Y) and
+ *         its first 16 columns and 4 rows are the ISP border
+ *         (OV5640_ISP_HOFFSET, OV5640_ISP_VOFFSET), so the region output is
+ *         readable (X + 16, Y + 4) and X + Width <= 2592, Y + Height <= 1944.
+ *         The start is rounded down to even. The sensor reads the region
+ *         only, without subsampling or scaling, with the minimum horizontal
+ *         and vertical blanking. A line lasts at least Width x BytesPerPixel
+ *         PCLK cycles on the DVP. For the fastest rate the PLL is set to the
+ *         highest PCLK within MaxPClk (96MHz at most), otherwise to the
+ *         lowest PCLK meeting FrameRate and VTS is stretched to it. The
+ *         achieved rate is returned in pMode->FrameRate. Apply the result
+ *         with OV5640_ApplyOutputMode.
+ * @param  pROI   region, clocks and frame rate
+ * @param  pMode  filled with the readout, timing and PLL settings
+ * @retval Component status, OV5640_ERROR when the region or rate cannot be met
+ */
+int32_t OV5640_ComputeROIMode(const OV5640_ROI_t *pROI, OV5640_OutputMode_t *pMode) {
+    int32_t      ret = OV5640_ERROR;
+    uint32_t     xsize;
+    uint32_t     ysize;
+    uint32_t     hts;
+    uint32_t     vts;
+    uint64_t     target;
+    OV5640_PLL_t pll;
+
+    if ((pROI != NULL) && (pMode != NULL) && (pROI->XClk != 0U) && (pROI->BytesPerPixel != 0U) &&
+        (pROI->Width != 0U) && (pROI->Height != 0U)) {
+        /* Readout window with the ISP border around the region, even start:
+           (X, Y) in ISP-visible coordinates is the window origin */
+        xsize = (uint32_t)pROI->Width + (2U * OV5640_ISP_HOFFSET);
+        ysize = (uint32_t)pROI->Height + (2U * OV5640_ISP_VOFFSET);
+
+        if ((((uint32_t)(pROI->X & ~1U) + xsize) <= OV5640_ARRAY_WIDTH) &&
+            (((uint32_t)(pROI->Y & ~1U) + ysize) <= OV5640_ARRAY_HEIGHT)) {
+            hts = xsize + OV5640_HBLANK_FULL;
+            if (((uint32_t)pROI->Width * pROI->BytesPerPixel) > hts) {
+                hts = (uint32_t)pROI->Width * pROI->BytesPerPixel;
+            }
+            vts = ysize + OV5640_VBLANK_MIN;
+
+            /* Target 0 asks the search for the highest PCLK within the limit */
+            target = (pROI->FrameRate != 0U) ? ((uint64_t)hts * vts * pROI->FrameRate) : 0U;
+
+            if ((hts <= 0xFFFFU) && (OV5640_SearchPLL(pROI->XClk, target, pROI->MaxPClk, &pll) != 0U)) {
+                if (pROI->FrameRate != 0U) {
+                    vts = pll.PClk / (hts * pROI->FrameRate);
+                }
+
+                pMode->Width      = pROI->Width;
+                pMode->Height     = pROI->Height;
+                pMode->XStart     = (uint16_t)(pROI->X & ~1U);
+                pMode->YStart     = (uint16_t)(pROI->Y & ~1U);
+                pMode->XSize      = (uint16_t)xsize;
+                pMode->YSize      = (uint16_t)ysize;
+                pMode->Subsample  = 1U;
+                pMode->Hts        = (uint16_t)hts;
+                pMode->Vts        = (uint16_t)((vts > 0xFFFFU) ? 0xFFFFU : vts);
+                pMode->PixelClock = OV5640_PCLK_CUSTOM;
+                pMode->FrameRate  = pll.PClk / (hts * pMode->Vts);
+                pMode->Pll        = pll;
+                ret               = OV5640_OK;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Stream a region of the array at the highest frame rate it allows
+ * @param  pObj   pointer to component object
+ * @param  pROI   region, clocks and frame rate, see OV5640_ComputeROIMode
+ * @param  pMode  filled with the applied mode (achieved frame rate), can be NULL
+ * @retval Component status
+ */
+int32_t OV5640_SetROIMode(OV5640_Object_t *pObj, const OV5640_ROI_t *pROI, OV5640_OutputMode_t *pMode) {
+    int32_t             ret = OV5640_OK;
+    OV5640_OutputMode_t mode;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if (OV5640_ComputeROIMode(pROI, &mode) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_ApplyOutputMode(pObj, &mode) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (pMode != NULL) {
+        *pMode = mode;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Apply a register table to the sensor
+ * @note   Runs of entries targeting consecutive register addresses are merged
+ *         and sent as a single auto-increment write, so the table order must
+ *         be kept when editing tables. A run failing on the bus is sent
+ *         again up to OV5640_BUS_RETRIES times before the table is given up,
+ *         the preceding runs are not written again.
+ * @param  pObj    pointer to component object
+ * @param  pTable  pointer to the register table
+ * @param  Size    number of entries in the table
+ * @retval Component status
+ */
+int32_t OV5640_WriteTable(OV5640_Object_t *pObj, const OV5640_RegVal_t *pTable, uint32_t Size) {
+    int32_t ret = OV5640_OK;
+    uint8_t  run[OV5640_TABLE_RUN_SIZE];
+    uint32_t index = 0;
+    uint32_t max;
+    uint16_t reg;
+    uint16_t len;
+
+    max = OV5640_TABLE_RUN_SIZE;
+    if ((pObj->BurstSize != 0U) && (pObj->BurstSize < max)) {
+        max = pObj->BurstSize;
+    }
+
+    while ((index < Size) && (ret == OV5640_OK)) {
+        reg = pTable[index].Reg;
+        len = 0;
+
+        do {
+            run[len] = pTable[index].Value;
+            len++;
+            index++;
+        }
+        while ((index < Size) && (len < max) && (pTable[index].Reg == (uint16_t)(reg + len)));
+
+        if (ov5640_write_reg(&pObj->Ctx, reg, run, len) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Drop every register value held in the shadow cache
+ * @note   Must be called when the sensor lost its register content behind the
+ *         driver back (hardware reset, power cycle). Software resets issued
+ *         through SYSTEM_CTROL0 invalidate the cache automatically.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_InvalidateRegCache(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (pObj == NULL) {
+        ret = OV5640_ERROR;
+    }
+#if (OV5640_USE_REG_CACHE == 1U)
+    else if (OV5640_BusAcquire(pObj) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        uint32_t index;
+
+        for (index = 0; index < OV5640_REG_CACHE_SIZE; index++) {
+            pObj->RegCache.Reg[index] = 0xFFFFU;
+        }
+        OV5640_Unlock(pObj, OV5640_LOCK_BUS);
+    }
+#endif
+
+    return ret;
+}
+
+#if (OV5640_USE_ASYNC_IO == 1U)
+/**
+ * @brief  Queue a register table for non-blocking transfer
+ * @note   Consecutive registers are merged as in OV5640_WriteTable and the
+ *         resulting transfers are chained back-to-back by the completion
+ *         interrupt. Callback is called once the whole table is written, from
+ *         interrupt context. When IO.WriteRegAsync is not provided the table
+ *         is written before returning, which is refused while other jobs
+ *         are in flight.
+ * @param  pObj      pointer to component object
+ * @param  pTable    pointer to the register table, must stay valid until completion
+ * @param  Size      number of entries in the table
+ * @param  Callback  completion callback, can be NULL
+ * @param  pArg      callback user argument
+ * @retval Component status
+ */
+int32_t OV5640_SubmitTable(OV5640_Object_t *pObj, const OV5640_RegVal_t *pTable, uint32_t Size,
+                           OV5640_XferCplt_Func Callback, void *pArg) {
+    OV5640_AsyncJob_t job;
+    int32_t           ret;
+
+    if ((pObj == NULL) || (pTable == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else if ((pObj->IO.WriteRegAsync == NULL) && (pObj->Async.Busy != 0U)) {
+        /* A blocking fallback would overlap the jobs in flight */
+        ret = OV5640_ERROR;
+    }
+    else if (pObj->IO.WriteRegAsync == NULL) {
+        ret = OV5640_WriteTable(pObj, pTable, Size);
+        if (Callback != NULL) {
+            Callback(pArg, ret);
+        }
+    }
+    else {
+        job.pTable   = pTable;
+        job.pData    = NULL;
+        job.Size     = Size;
+        job.Reg      = 0;
+        job.Read     = 0U;
+        job.Callback = Callback;
+        job.pArg     = pArg;
+        ret          = OV5640_AsyncSubmit(pObj, &job);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Queue a block of consecutive registers for non-blocking write
+ * @param  pObj      pointer to component object
+ * @param  Reg       first register address
+ * @param  pData     values to be written, must stay valid until completion
+ * @param  Length    number of bytes to be written
+ * @param  Callback  completion callback, can be NULL
+ * @param  pArg      callback user argument
+ * @retval Component status
+ */
+int32_t OV5640_SubmitWrite(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint32_t Length,
+                           OV5640_XferCplt_Func Callback, void *pArg) {
+    OV5640_AsyncJob_t job;
+    int32_t           ret;
+
+    if ((pObj == NULL) || (pData == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else if ((pObj->IO.WriteRegAsync == NULL) && (pObj->Async.Busy != 0U)) {
+        /* A blocking fallback would overlap the jobs in flight */
+        ret = OV5640_ERROR;
+    }
+    else if (pObj->IO.WriteRegAsync == NULL) {
+        ret = OV5640_WriteBurst(pObj, Reg, pData, Length);
+        if (Callback != NULL) {
+            Callback(pArg, ret);
+        }
+    }
+    else {
+        job.pTable   = NULL;
+        job.pData    = (uint8_t *)pData;
+        job.Size     = Length;
+        job.Reg      = Reg;
+        job.Read     = 0U;
+        job.Callback = Callback;
+        job.pArg     = pArg;
+        ret          = OV5640_AsyncSubmit(pObj, &job);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Queue a block of consecutive registers for non-blocking read
+ * @param  pObj      pointer to component object
+ * @param  Reg       first register address
+ * @param  pData     destination buffer, must stay valid until completion
+ * @param  Length    number of bytes to be read
+ * @param  Callback  completion callback, can be NULL
+ * @param  pArg      callback user argument
+ * @retval Component status
+ */
+int32_t OV5640_SubmitRead(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint32_t Length,
+                          OV5640_XferCplt_Func Callback, void *pArg) {
+    OV5640_AsyncJob_t job;
+    int32_t           ret = OV5640_OK;
+    uint32_t          chunk;
+
+    if ((pObj == NULL) || (pData == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else if ((pObj->IO.ReadRegAsync == NULL) && (pObj->Async.Busy != 0U)) {
+        /* A blocking fallback would overlap the jobs in flight */
+        ret = OV5640_ERROR;
+    }
+    else if (pObj->IO.ReadRegAsync == NULL) {
+        while ((Length > 0U) && (ret == OV5640_OK)) {
+            chunk = ((pObj->BurstSize != 0U) && (Length > pObj->BurstSize)) ? pObj->BurstSize : Length;
+            if (ov5640_read_reg(&pObj->Ctx, Reg, pData, (uint16_t)chunk) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            Reg += (uint16_t)chunk;
+            pData += chunk;
+            Length -= chunk;
+        }
+        if (Callback != NULL) {
+            Callback(pArg, ret);
+        }
+    }
+    else {
+        job.pTable   = NULL;
+        job.pData    = pData;
+        job.Size     = Length;
+        job.Reg      = Reg;
+        job.Read     = 1U;
+        job.Callback = Callback;
+        job.pArg     = pArg;
+        ret          = OV5640_AsyncSubmit(pObj, &job);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  End of transfer notification from the bus layer
+ * @note   To be called from the I2C transfer complete / error interrupt for
+ *         every transfer started through IO.WriteRegAsync or IO.ReadRegAsync.
+ *         The next queued transfer is started from this context. The cache
+ *         and statistics are updated here without the BUS lock: while the
+ *         queue is busy, blocking transactions wait in OV5640_BusAcquire and
+ *         never touch them.
+ * @param  pObj    pointer to component object
+ * @param  Status  OV5640_OK if the transfer succeeded
+ */
+void OV5640_AsyncCpltCallback(OV5640_Object_t *pObj, int32_t Status) {
+    OV5640_Async_t      *pAsync = &pObj->Async;
+    OV5640_AsyncJob_t   *pJob   = &pAsync->Job[pAsync->Head];
+    OV5640_XferCplt_Func callback;
+    void                *arg;
+    uint32_t             primask;
+
+#if (OV5640_USE_STATS == 1U)
+    OV5640_StatsRecord(pObj, pJob->Read, pAsync->XferLen, Status, 0U);
+#endif
+#if (OV5640_USE_REG_CACHE == 1U)
+    if (pJob->Read != 0U) {
+        OV5640_CacheFill(pObj, pAsync->XferReg, pAsync->pXfer, pAsync->XferLen, Status);
+    }
+    else {
+        OV5640_CacheStore(pObj, pAsync->XferReg, pAsync->pXfer, pAsync->XferLen, Status);
+    }
+#endif
+
+    if (Status != OV5640_OK) {
+        /* Abort the rest of the job */
+        callback      = pJob->Callback;
+        arg           = pJob->pArg;
+        pAsync->Index = 0;
+
+        primask       = __get_PRIMASK();
+        __disable_irq();
+        pAsync->Head = (pAsync->Head + 1U) % OV5640_ASYNC_QUEUE_SIZE;
+        pAsync->Count--;
+        __set_PRIMASK(primask);
+
+        if (callback != NULL) {
+            callback(arg, OV5640_ERROR);
+        }
+    }
+
+    OV5640_AsyncNext(pObj);
+}
+
+/**
+ * @brief  Tell whether asynchronous jobs are still pending
+ * @param  pObj  pointer to component object
+ * @retval 1 while a job is queued or in progress, 0 otherwise
+ */
+uint8_t OV5640_AsyncIsBusy(OV5640_Object_t *pObj) {
+    return pObj->Async.Busy;
+}
+#endif
+
+/**
+ * @brief  Set the maximum number of bytes sent in one SCCB burst
+ * @param  pObj  pointer to component object
+ * @param  BurstSize  maximum burst length in bytes (1 disables bursting)
+ * @retval Component status
+ */
+int32_t OV5640_SetBurstSize(OV5640_Object_t *pObj, uint16_t BurstSize) {
+    int32_t ret;
+
+    if ((pObj == NULL) || (BurstSize == 0U)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->BurstSize = BurstSize;
+        ret             = OV5640_OK;
+    }
+
+    return ret;
+}
+
+#if (OV5640_USE_STATS == 1U)
+/**
+ * @brief  Select the call site charged for the following bus transfers
+ * @note   Bracket a driver call, e.g. boot or mode switch, with two calls to
+ *         measure its cost in isolation:
+ *         prev = OV5640_SetStatsSite(pObj, 1); ...; OV5640_SetStatsSite(pObj, prev);
+ * @param  pObj  pointer to component object
+ * @param  Site  call site, 0 to OV5640_STATS_NUM_SITES - 1
+ * @retval Previously selected call site
+ */
+uint8_t OV5640_SetStatsSite(OV5640_Object_t *pObj, uint8_t Site) {
+    uint8_t prev = pObj->Stats.Current;
+
+    if (Site < OV5640_STATS_NUM_SITES) {
+        pObj->Stats.Current = Site;
+    }
+
+    return prev;
+}
+
+/**
+ * @brief  Get the bus cost accumulated by a call site
+ * @param  pObj      pointer to component object
+ * @param  Site      call site, or OV5640_STATS_ALL for the sum of all sites
+ * @param  pCounter  filled with the counters
+ * @retval Component status
+ */
+int32_t OV5640_GetStats(OV5640_Object_t *pObj, uint8_t Site, OV5640_StatsCounter_t *pCounter) {
+    int32_t  ret = OV5640_OK;
+    uint32_t first;
+    uint32_t last;
+    uint32_t i;
+
+    if (pCounter == NULL) {
+        ret = OV5640_ERROR;
+    }
+    else if ((Site != OV5640_STATS_ALL) && (Site >= OV5640_STATS_NUM_SITES)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        first                  = (Site == OV5640_STATS_ALL) ? 0U : Site;
+        last                   = (Site == OV5640_STATS_ALL) ? (OV5640_STATS_NUM_SITES - 1U) : Site;
+
+        pCounter->Transactions = 0;
+        pCounter->BytesWritten = 0;
+        pCounter->BytesRead    = 0;
+        pCounter->Errors       = 0;
+        pCounter->Retries      = 0;
+        pCounter->CacheHits    = 0;
+        pCounter->Ticks        = 0;
+
+        for (i = first; i <= last; i++) {
+            pCounter->Transactions += pObj->Stats.Site[i].Transactions;
+            pCounter->BytesWritten += pObj->Stats.Site[i].BytesWritten;
+            pCounter->BytesRead += pObj->Stats.Site[i].BytesRead;
+            pCounter->Errors += pObj->Stats.Site[i].Errors;
+            pCounter->Retries += pObj->Stats.Site[i].Retries;
+            pCounter->CacheHits += pObj->Stats.Site[i].CacheHits;
+            pCounter->Ticks += pObj->Stats.Site[i].Ticks;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Clear the counters of every call site
+ * @note   The selected call site is left unchanged.
+ * @param  pObj  pointer to component object
+ * @retval OV5640_OK
+ */
+int32_t OV5640_ResetStats(OV5640_Object_t *pObj) {
+    uint32_t i;
+
+    for (i = 0; i < OV5640_STATS_NUM_SITES; i++) {
+        pObj->Stats.Site[i].Transactions = 0;
+        pObj->Stats.Site[i].BytesWritten = 0;
+        pObj->Stats.Site[i].BytesRead    = 0;
+        pObj->Stats.Site[i].Errors       = 0;
+        pObj->Stats.Site[i].Retries      = 0;
+        pObj->Stats.Site[i].CacheHits    = 0;
+        pObj->Stats.Site[i].Ticks        = 0;
+    }
+
+    return OV5640_OK;
+}
+#endif
+
+#if (OV5640_CFG_AF == 1U)
+/**
+ * @brief  Download the auto focus firmware and wait for the AF MCU to be ready
+ * @note   The firmware is sent in bursts of pObj->BurstSize bytes. Unless
+ *         OV5640_AF_VERIFY_MODE is OV5640_AF_VERIFY_NONE, nothing is
+ *         downloaded when the running firmware already matches the image.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Init(OV5640_Object_t *pObj) {
+    int32_t  ret = OV5640_OK;
+    uint32_t i;
+    uint8_t  ready;
+    uint8_t  resident = 0U;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+#if (OV5640_AF_VERIFY_MODE != OV5640_AF_VERIFY_NONE)
+    resident = OV5640_IsAFResident(pObj);
+#endif
+
+    if (resident != 0U) {
+        /* The running firmware matches, nothing to download */
+    }
+    else if (OV5640_Focus_Upload(pObj) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        /* Wait for the firmware to report idle */
+        for (i = 0; i < OV5640_AF_BOOT_POLLS; i++) {
+            if (OV5640_Focus_Ready(pObj, &ready) != OV5640_OK) {
+                ret = OV5640_ERROR;
+                break;
+            }
+            if (ready != 0U) {
+                break;
+            }
+            (void)OV5640_Delay(pObj, 5);
+        }
+
+        if (i == OV5640_AF_BOOT_POLLS) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+    return ret;
+}
+
+/**
+ * @brief  Download the AF firmware and start the AF MCU, without waiting
+ * @note   Poll OV5640_Focus_Ready until the firmware has booted, other
+ *         sensors can be configured in the meantime. The download is read
+ *         back with OV5640_AF_VERIFY_MODE before the MCU is released, so a
+ *         corrupted image fails here instead of at the end of the boot
+ *         timeout. Write-only IOs (no ReadReg hook) are not read back.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Upload(OV5640_Object_t *pObj) {
+    int32_t ret;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    /* A missing, partial or corrupted image is left in reset rather than started */
+    ret = OV5640_Focus_Download(pObj);
+    if ((ret == OV5640_OK) && (OV5640_Focus_Release(pObj) != OV5640_OK)) {
+        ret = OV5640_ERROR;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+    return ret;
+}
+
+/**
+ * @brief  Download the AF firmware with the AF MCU held in reset
+ * @note   First half of OV5640_Focus_Upload: the MCU stays in reset until
+ *         OV5640_Focus_Release, e.g. once every sensor reached by a
+ *         broadcast download has been verified.
+ * @param  pObj  pointer to component object
+ * @retval Component status, OV5640_ERROR when the readback does not match
+ */
+int32_t OV5640_Focus_Download(OV5640_Object_t *pObj) {
+    int32_t ret   = OV5640_OK;
+#if (OV5640_AF_VERIFY_MODE != OV5640_AF_VERIFY_NONE)
+    uint8_t match = 1U;
+#endif
+
+    static const OV5640_RegVal_t datas[] = {
+        {0x3000, 0x20}
+    };
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    /* Hold the AF MCU in reset while its firmware is downloaded */
+    if (OV5640_WriteTable(pObj, datas, OV5640_TABLE_LEN(datas)) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_WriteBurst(pObj, 0x8000, OV5640_AF_Config, sizeof(OV5640_AF_Config)) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+#if (OV5640_AF_VERIFY_MODE != OV5640_AF_VERIFY_NONE)
+    else if ((pObj->IO.ReadReg != NULL) &&
+             (OV5640_Focus_Verify(pObj, OV5640_AF_VERIFY_MODE, &match) != OV5640_OK)) {
+        ret = OV5640_ERROR;
+    }
+    else if (match == 0U) {
+        ret = OV5640_ERROR;
+    }
+#endif
 
-int32_t OV5640_OutSize_Set(OV5640_Object_t *pObj, uint16_t offx, uint16_t offy, uint16_t width, uint16_t height) {
-    uint32_t index;
-    uint8_t  tmp;
-    int32_t  ret        = OV5640_OK;
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+    return ret;
+}
 
-    uint16_t datas[][2] = {
-        {0X3212,          0X03},
-        {0x3808,    width >> 8},
-        {0x3809,  width & 0xff},
-        {0x380a,   height >> 8},
-        {0x380b, height & 0xff},
-        {0x3810,     offx >> 8},
-        {0x3811,   offx & 0xff},
-        {0x3812,     offy >> 8},
-        {0x3813,   offy & 0xff},
-        {0X3212,          0X13},
-        {0X3212,          0Xa3}
+/**
+ * @brief  Release the AF MCU after OV5640_Focus_Download
+ * @note   Poll OV5640_Focus_Ready until the firmware has booted.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Release(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    static const OV5640_RegVal_t datas2[] = {
+        {0x3022, 0x00},
+        {0x3023, 0x00},
+        {0x3024, 0x00},
+        {0x3025, 0x00},
+        {0x3026, 0x00},
+        {0x3027, 0x00},
+        {0x3028, 0x00},
+        {0x3029, 0x7f},
+        {0x3000, 0x00}
     };
 
-    for (index = 0; index < (sizeof(datas) / 4U); index++) {
-        tmp = (uint8_t)datas[index][1];
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
-        if (ov5640_write_reg(&pObj->Ctx, datas[index][0], &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-        }
+    if (OV5640_WriteTable(pObj, datas2, OV5640_TABLE_LEN(datas2)) != OV5640_OK) {
+        ret = OV5640_ERROR;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
     return ret;
 }
 
-int32_t OV5640_ImageWin_Set(OV5640_Object_t *pObj, uint16_t offx, uint16_t offy, uint16_t width, uint16_t height) {
-    uint16_t xst, yst, xend, yend;
-    xst  = offx;
-    yst  = offy;
-    xend = offx + width - 1;
-    yend = offy + height - 1;
+/**
+ * @brief  Compare the AF program RAM with the firmware image
+ * @note   The bytes read back and the matching bytes of OV5640_AF_Config go
+ *         through the same CRC-16, so the full check needs no image-sized
+ *         buffer. OV5640_AF_VERIFY_SAMPLED reads OV5640_AF_VERIFY_SAMPLES
+ *         windows from the head to the tail of the image, enough to catch a
+ *         truncated or missing download in a few transactions.
+ * @param  pObj    pointer to component object
+ * @param  Mode    OV5640_AF_VERIFY_SAMPLED or OV5640_AF_VERIFY_FULL
+ * @param  pMatch  set to 1 when the CRCs match
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Verify(OV5640_Object_t *pObj, uint32_t Mode, uint8_t *pMatch) {
+    int32_t  ret  = OV5640_OK;
+    uint8_t  buf[OV5640_AF_VERIFY_CHUNK];
+    uint16_t crc  = OV5640_AF_CRC_INIT;
+    uint16_t ref  = OV5640_AF_CRC_INIT;
+    uint32_t size = sizeof(OV5640_AF_Config);
+    uint32_t count;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t i;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
-    uint32_t index;
-    uint8_t  tmp;
-    int32_t  ret = OV5640_OK;
+    *pMatch = 0U;
 
-    //
-    uint16_t datas[][2] = {
-        {0X3212,        0X03},
-        {0X3800,    xst >> 8},
-        {0X3801,  xst & 0XFF},
-        {0X3802,    yst >> 8},
-        {0X3803,  yst & 0XFF},
-        {0X3804,   xend >> 8},
-        {0X3805, xend & 0XFF},
-        {0X3806,   yend >> 8},
-        {0X3807, yend & 0XFF},
-        {0X3212,        0X13},
-        {0X3212,        0Xa3}
-    };
+    if (Mode == OV5640_AF_VERIFY_FULL) {
+        count = (size + OV5640_AF_VERIFY_CHUNK - 1U) / OV5640_AF_VERIFY_CHUNK;
+    }
+    else if (Mode == OV5640_AF_VERIFY_SAMPLED) {
+        count = OV5640_AF_VERIFY_SAMPLES;
+    }
+    else {
+        ret = OV5640_ERROR;
+    }
 
-    for (index = 0; index < (sizeof(datas) / 4U); index++) {
-        tmp = (uint8_t)datas[index][1];
+    for (i = 0; (ret == OV5640_OK) && (i < count); i++) {
+        if (Mode == OV5640_AF_VERIFY_FULL) {
+            offset = i * OV5640_AF_VERIFY_CHUNK;
+            length = ((size - offset) < OV5640_AF_VERIFY_CHUNK) ? (size - offset) : OV5640_AF_VERIFY_CHUNK;
+        }
+        else {
+            offset = (i * (size - OV5640_AF_PROBE_SIZE)) / (OV5640_AF_VERIFY_SAMPLES - 1U);
+            length = OV5640_AF_PROBE_SIZE;
+        }
 
-        if (ov5640_write_reg(&pObj->Ctx, datas[index][0], &tmp, 1) != OV5640_OK) {
+        if (ov5640_read_reg(&pObj->Ctx, (uint16_t)(0x8000U + offset), buf, (uint16_t)length) != OV5640_OK) {
             ret = OV5640_ERROR;
         }
+        else {
+            crc = OV5640_Crc16(crc, buf, length);
+            ref = OV5640_Crc16(ref, &OV5640_AF_Config[offset], length);
+        }
+    }
+
+    if ((ret == OV5640_OK) && (crc == ref)) {
+        *pMatch = 1U;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
     return ret;
 }
 
-int32_t OV5640_JPEG_Mode(OV5640_Object_t *pObj) {
-    uint32_t index;
-    uint8_t  tmp;
-    int32_t  ret = OV5640_OK;
+/**
+ * @brief  Check once whether the AF firmware has booted
+ * @param  pObj    pointer to component object
+ * @param  pReady  set to 1 when the firmware reports idle (0x3029 = 0x70)
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Ready(OV5640_Object_t *pObj, uint8_t *pReady) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
 
-    for (index = 0; index < (sizeof(OV5640_jpeg_reg_tbl) / 4U); index++) {
-        tmp = (uint8_t)OV5640_jpeg_reg_tbl[index][1];
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
-        if (ov5640_write_reg(&pObj->Ctx, OV5640_jpeg_reg_tbl[index][0], &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-        }
+    *pReady = 0U;
+
+    if (ov5640_read_reg(&pObj->Ctx, 0x3029, &tmp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (tmp == 0x70U) {
+        *pReady = 1U;
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
     return ret;
 }
 
-int32_t OV5640_RGB565_Mode(OV5640_Object_t *pObj) {
-    uint32_t index;
-    uint8_t  tmp;
-    int32_t  ret = OV5640_OK;
+/**
+ * @brief  Run a single autofocus and wait for the lens to settle
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Single(OV5640_Object_t *pObj) {
+    int32_t ret;
 
-    for (index = 0; index < (sizeof(ov5640_rgb565_reg_tbl) / 4U); index++) {
-        tmp = (uint8_t)ov5640_rgb565_reg_tbl[index][1];
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
-        if (ov5640_write_reg(&pObj->Ctx, ov5640_rgb565_reg_tbl[index][0], &tmp, 1) != OV5640_OK) {
-            ret = OV5640_ERROR;
-        }
+    ret = OV5640_AF_Start(pObj, OV5640_AF_SINGLE, OV5640_AF_TIMEOUT_MS, NULL, NULL);
+    if (ret == OV5640_OK) {
+        ret = OV5640_AF_Wait(pObj);
+    }
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+    return ret;
+}
+
+/**
+ * @brief  Switch the AF MCU to continuous autofocus and wait for the ack
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Focus_Constant(OV5640_Object_t *pObj) {
+    int32_t ret;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
     }
 
+    ret = OV5640_AF_Start(pObj, OV5640_AF_CONTINUOUS, OV5640_AF_TIMEOUT_MS, NULL, NULL);
+    if (ret == OV5640_OK) {
+        ret = OV5640_AF_Wait(pObj);
+    }
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
     return ret;
 }
 
-int32_t OV5640_Init_General_Mode(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat) {
-    uint32_t index;
-    uint8_t  tmp;
-    int32_t  ret = OV5640_OK;
+int32_t OV5640_Focus_Send_Single(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+    uint8_t temp;
 
-    if (pObj->IsInitialized == 0U) {
-        /* Check if resolution is supported */
-        if ((Resolution > OV5640_R2592x1944) ||
-            ((PixelFormat != OV5640_RGB565) && (PixelFormat != OV5640_JPEG))) {
+    temp = 0x03;
+    if (ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+
+    return ret;
+}
+
+uint8_t OV5640_Focus_Read_Single(OV5640_Object_t *pObj) {
+    uint8_t ready;
+
+    /* A bus error reads as not focused */
+    (void)OV5640_AF_ReadAck(pObj, 0x3029, 0x10, &ready);
+    return ready;
+}
+
+int32_t OV5640_Focus_Send_Constant_IDLE(OV5640_Object_t *pObj) {
+    int32_t ret  = OV5640_OK;
+    uint8_t temp = 0;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    /* The command is only issued once its ack register is armed */
+    temp = 0x01;
+    if (ov5640_write_reg(&pObj->Ctx, 0x3023, &temp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        temp = 0x08;
+        if (ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1) != OV5640_OK) {
             ret = OV5640_ERROR;
         }
-        else {
-            /* Set common parameters for all resolutions */
-            for (index = 0; index < (sizeof(ov5640_uxga_init_reg_tbl) / 4U); index++) {
-                if (ret != OV5640_ERROR) {
-                    tmp = (uint8_t)ov5640_uxga_init_reg_tbl[index][1];
+    }
 
-                    if (ov5640_write_reg(&pObj->Ctx, ov5640_uxga_init_reg_tbl[index][0], &tmp, 1) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                }
-            }
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+    return ret;
+}
 
-            if (ret == OV5640_OK) {
-                if (PixelFormat == OV5640_RGB565) {
-                    if (OV5640_RGB565_Mode(pObj) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else if (OV5640_Set_Solution_More(pObj, Resolution) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else if (OV5640_SetPolarities(pObj, OV5640_POLARITY_PCLK_HIGH, OV5640_POLARITY_HREF_HIGH, OV5640_POLARITY_VSYNC_HIGH) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    OV5640_Focus_Init(pObj);
-                }
-                else if (PixelFormat == OV5640_JPEG) {
-                    if (OV5640_JPEG_Mode(pObj) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else if (OV5640_Set_Solution_More(pObj, Resolution) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    else if (OV5640_SetPolarities(pObj, OV5640_POLARITY_PCLK_HIGH, OV5640_POLARITY_HREF_HIGH, OV5640_POLARITY_VSYNC_HIGH) != OV5640_OK) {
-                        ret = OV5640_ERROR;
-                    }
-                    OV5640_Focus_Init(pObj);
-                }
-            }
+uint8_t OV5640_Focus_Read_Constant(OV5640_Object_t *pObj) {
+    uint8_t ready;
+
+    /* A bus error reads as not acknowledged */
+    (void)OV5640_AF_ReadAck(pObj, 0x3023, 0x00, &ready);
+    return ready;
+}
+
+int32_t OV5640_Focus_Send_Constant_Focus(OV5640_Object_t *pObj) {
+    int32_t ret  = OV5640_OK;
+    uint8_t temp = 0;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    temp = 0x01;
+    if (ov5640_write_reg(&pObj->Ctx, 0x3023, &temp, 1) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        temp = 0x04;
+        if (ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
         }
     }
 
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
     return ret;
 }
 
-int32_t OV5640_Set_Solution_More(OV5640_Object_t *pObj, uint32_t solution) {
-    return OV5640_OutSize_Set(pObj, 4, 0, solution_table[solution][0], solution_table[solution][1]);
-}
+/**
+ * @brief  Start a non-blocking autofocus sequence
+ * @note   The sequence is advanced by OV5640_AF_Process, called from a task,
+ *         e.g. woken once per frame by the VSYNC interrupt or by a periodic
+ *         timer, so no task blocks while the AF MCU works. Like the rest of
+ *         the driver it must not be called from the interrupt itself.
+ * @param  pObj      pointer to component object
+ * @param  Mode      OV5640_AF_SINGLE or OV5640_AF_CONTINUOUS
+ * @param  Timeout   maximum duration of the sequence in ms
+ * @param  Callback  called with OV5640_OK or OV5640_ERROR when over, can be NULL
+ * @param  pArg      callback user argument
+ * @retval Component status
+ */
+int32_t OV5640_AF_Start(OV5640_Object_t *pObj, uint32_t Mode, uint32_t Timeout, OV5640_XferCplt_Func Callback,
+                        void *pArg) {
+    int32_t ret = OV5640_OK;
 
-int32_t OV5640_Focus_Init(OV5640_Object_t *pObj) {
-    size_t   i;
-    uint16_t addr       = 0x8000;
-    int32_t  ret        = OV5640_OK;
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
-    uint16_t datas[][2] = {
-        {0x3000, 0x20}
-    };
+    if ((pObj->AF.State == OV5640_AF_BUSY) || (Mode > OV5640_AF_CONTINUOUS)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->AF.Callback  = Callback;
+        pObj->AF.pArg      = pArg;
+        pObj->AF.Timeout   = Timeout;
+        pObj->AF.TickStart = (uint32_t)pObj->IO.GetTick();
+
+        if (Mode == OV5640_AF_SINGLE) {
+            pObj->AF.Step = OV5640_AF_STEP_SINGLE;
+            ret           = OV5640_Focus_Send_Single(pObj);
+        }
+        else {
+            /* Release the lens first, continuous focus is started on ack */
+            pObj->AF.Step = OV5640_AF_STEP_RELEASE;
+            ret           = OV5640_Focus_Send_Constant_IDLE(pObj);
+        }
 
-    uint16_t datas2[][2] = {
-        {0x3022, 0x00},
-        {0x3023, 0x00},
-        {0x3024, 0x00},
-        {0x3025, 0x00},
-        {0x3026, 0x00},
-        {0x3027, 0x00},
-        {0x3028, 0x00},
-        {0x3029, 0x7f},
-        {0x3000, 0x00}
-    };
+        pObj->AF.State = (ret == OV5640_OK) ? OV5640_AF_BUSY : OV5640_AF_FAILED;
+    }
 
-    uint8_t tmp;
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+    return ret;
+}
+
+/**
+ * @brief  Poll the AF MCU once and advance the autofocus sequence
+ * @note   Call it from task context, see OV5640_AF_Start. A bus error ends
+ *         the sequence in OV5640_AF_FAILED.
+ * @param  pObj  pointer to component object
+ * @retval OV5640_ERROR once the sequence has timed out or failed on the bus,
+ *         OV5640_OK otherwise
+ */
+int32_t OV5640_AF_Process(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+    uint8_t ready;
 
-    tmp = datas[0][1];
-    ov5640_write_reg(&pObj->Ctx, datas[0][0], &tmp, 1);
-    for (i = 0; i < sizeof(OV5640_AF_Config); i++) {
-        tmp = OV5640_AF_Config[i];
-        ov5640_write_reg(&pObj->Ctx, addr, &tmp, 1);
-        addr++;
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
     }
 
-    for (size_t index = 0; index < (sizeof(datas2) / 4U); index++) {
-        tmp = (uint8_t)datas[index][1];
+    if (pObj->AF.State == OV5640_AF_BUSY) {
+        if (pObj->AF.Step == OV5640_AF_STEP_SINGLE) {
+            ret = OV5640_AF_ReadAck(pObj, 0x3029, 0x10, &ready);
+        }
+        else {
+            ret = OV5640_AF_ReadAck(pObj, 0x3023, 0x00, &ready);
+        }
 
-        if (ov5640_write_reg(&pObj->Ctx, datas[index][0], &tmp, 1) != OV5640_OK) {
+        if (ret != OV5640_OK) {
+            OV5640_AF_Finish(pObj, OV5640_AF_FAILED);
+        }
+        else if (ready != 0U) {
+            if (pObj->AF.Step == OV5640_AF_STEP_RELEASE) {
+                pObj->AF.Step = OV5640_AF_STEP_CONTINUOUS;
+                if (OV5640_Focus_Send_Constant_Focus(pObj) != OV5640_OK) {
+                    OV5640_AF_Finish(pObj, OV5640_AF_FAILED);
+                    ret = OV5640_ERROR;
+                }
+            }
+            else {
+                OV5640_AF_Finish(pObj, OV5640_AF_DONE);
+            }
+        }
+        else if (((uint32_t)pObj->IO.GetTick() - pObj->AF.TickStart) >= pObj->AF.Timeout) {
+            OV5640_AF_Finish(pObj, OV5640_AF_TIMEOUT);
             ret = OV5640_ERROR;
         }
     }
 
-    i   = 0;
-    tmp = 0x8F;
-    do {
-        ov5640_read_reg(&pObj->Ctx, 0x3029, &tmp, 1);
-        vTaskDelay(pdMS_TO_TICKS(5));
-        i++;
-        if (i > 1000)
-            return 1;
-    }
-    while (tmp != 0x70);
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
     return ret;
 }
 
-int32_t OV5640_Focus_Single(OV5640_Object_t *pObj) {
-    uint8_t  temp;
-    uint16_t retry = 0;
-
-    temp           = 0x03;
-    ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1);
-    while (1) {
-        retry++;
-        ov5640_read_reg(&pObj->Ctx, 0x3029, &temp, 1);
-        if (temp == 0x10)
-            break;
-        vTaskDelay(pdMS_TO_TICKS(5));
-        if (retry > 200)
-            return OV5640_ERROR;
+/**
+ * @brief  Stop tracking the autofocus sequence in progress
+ * @note   The callback is not called.
+ * @param  pObj  pointer to component object
+ * @retval OV5640_OK
+ */
+int32_t OV5640_AF_Abort(OV5640_Object_t *pObj) {
+    if (OV5640_Lock(pObj, OV5640_LOCK_AF) != OV5640_OK) {
+        return OV5640_ERROR;
     }
+
+    pObj->AF.State = OV5640_AF_IDLE;
+    OV5640_Unlock(pObj, OV5640_LOCK_AF);
+
     return OV5640_OK;
 }
 
-int32_t OV5640_Focus_Constant(OV5640_Object_t *pObj) {
-    uint8_t  temp  = 0;
-    uint16_t retry = 0;
+/**
+ * @brief  Get the autofocus sequence state
+ * @param  pObj  pointer to component object
+ * @retval OV5640_AF_IDLE, OV5640_AF_BUSY, OV5640_AF_DONE, OV5640_AF_TIMEOUT or OV5640_AF_FAILED
+ */
+uint8_t OV5640_AF_GetState(OV5640_Object_t *pObj) {
+    return pObj->AF.State;
+}
+#endif
 
-    temp           = 0x01;
-    ov5640_write_reg(&pObj->Ctx, 0x3023, &temp, 1);
-    temp = 0x08;
-    ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1);
-    do {
-        ov5640_read_reg(&pObj->Ctx, 0x3023, &temp, 1);
-        retry++;
-        if (retry > 200)
-            return OV5640_ERROR;
-        vTaskDelay(pdMS_TO_TICKS(5));
+/**
+ * @brief  Enter software standby and record the state needed by OV5640_Resume
+ * @note   Registers and the AF MCU RAM are kept by the sensor in software
+ *         standby as long as it stays powered.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_Suspend(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
     }
-    while (temp != 0x00);
-    temp = 0x01;
-    ov5640_write_reg(&pObj->Ctx, 0x3023, &temp, 1);
-    temp = 0x04;
-    ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1);
-    retry = 0;
-    do {
-        ov5640_read_reg(&pObj->Ctx, 0x3023, &temp, 1);
-        retry++;
-        if (retry > 200)
-            return OV5640_ERROR;
-        vTaskDelay(pdMS_TO_TICKS(5));
+
+    if (OV5640_ReadStandbySentinel(pObj, pObj->Standby.Timing, pObj->Standby.Pll) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+#if (OV5640_CFG_AF == 1U)
+        pObj->Standby.AFResident = OV5640_IsAFResident(pObj);
+#else
+        pObj->Standby.AFResident = 0U;
+#endif
+
+        tmp = 0x42;
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            pObj->Standby.Suspended = 1U;
+        }
     }
-    while (temp != 0x00);
-    return OV5640_OK;
-}
 
-int32_t OV5640_Focus_Send_Single(OV5640_Object_t *pObj) {
-    uint8_t temp;
-    temp = 0x03;
-    ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1);
-    return OV5640_OK;
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
 }
 
-uint8_t OV5640_Focus_Read_Single(OV5640_Object_t *pObj) {
-    uint8_t temp;
-    ov5640_read_reg(&pObj->Ctx, 0x3029, &temp, 1);
-    if (temp == 0x10)
-        return 1;
-    else
-        return 0;
-}
+/**
+ * @brief  Leave software standby, restoring only the state that was lost
+ * @note   When the timing and PLL registers still hold their suspend values
+ *         the sensor is simply woken up. Otherwise the last
+ *         OV5640_Init_General_Mode configuration (and mode profile) is
+ *         applied again. The AF firmware is downloaded again only when it is
+ *         no longer running from the MCU RAM.
+ * @param  pObj    pointer to component object
+ * @param  pFlags  filled with OV5640_RESUME_xxx flags, can be NULL
+ * @retval Component status
+ */
+int32_t OV5640_Resume(OV5640_Object_t *pObj, uint32_t *pFlags) {
+    int32_t                     ret   = OV5640_OK;
+    uint32_t                    flags = OV5640_RESUME_WARM;
+    uint8_t                     timing[OV5640_STANDBY_TIMING_SIZE];
+    uint8_t                     pll[OV5640_STANDBY_PLL_SIZE];
+    const OV5640_ModeProfile_t *profile;
+    uint8_t                     tmp;
+    uint32_t                    i;
+    uint8_t                     lost = 0U;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
 
-int32_t OV5640_Focus_Send_Constant_IDLE(OV5640_Object_t *pObj) {
-    uint8_t temp = 0;
-    //
-    temp = 0x01;
-    ov5640_write_reg(&pObj->Ctx, 0x3023, &temp, 1);
-    temp = 0x08;
-    ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1);
+    if (pObj->Standby.Suspended == 0U) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_ReadStandbySentinel(pObj, timing, pll) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        for (i = 0; i < OV5640_STANDBY_TIMING_SIZE; i++) {
+            if (timing[i] != pObj->Standby.Timing[i]) {
+                lost = 1U;
+            }
+        }
+        for (i = 0; i < OV5640_STANDBY_PLL_SIZE; i++) {
+            if (pll[i] != pObj->Standby.Pll[i]) {
+                lost = 1U;
+            }
+        }
 
-    return OV5640_OK;
-}
+        if (lost != 0U) {
+            /* The sensor went through a reset: nothing is left to resume */
+            (void)OV5640_InvalidateRegCache(pObj);
+            profile        = pObj->pProfile;
+            pObj->pProfile = NULL;
 
-uint8_t OV5640_Focus_Read_Constant(OV5640_Object_t *pObj) {
-    uint8_t temp;
-    ov5640_read_reg(&pObj->Ctx, 0x3023, &temp, 1);
-    if (temp == 0x00)
-        return 1;
-    else
-        return 0;
-}
+            /* Not Init_General_Mode, which is skipped once OV5640_Init has run */
+            if (pObj->Standby.Resolution == OV5640_MODE_UNKNOWN) {
+                ret = OV5640_ERROR;
+            }
+            else if (OV5640_Init_General_Config(pObj, pObj->Standby.Resolution, pObj->Standby.PixelFormat) !=
+                     OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+#if (OV5640_CFG_AF == 1U)
+            else if (OV5640_Focus_Init(pObj) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+#endif
+            else if ((profile != NULL) && (OV5640_SwitchModeProfile(pObj, profile) != OV5640_OK)) {
+                ret = OV5640_ERROR;
+            }
+            else {
+#if (OV5640_CFG_AF == 1U)
+                flags |= OV5640_RESUME_REGS_RESTORED | OV5640_RESUME_AF_RELOADED;
+#else
+                flags |= OV5640_RESUME_REGS_RESTORED;
+#endif
+            }
+        }
+#if (OV5640_CFG_AF == 1U)
+        else if ((pObj->Standby.AFResident != 0U) && (OV5640_IsAFResident(pObj) == 0U)) {
+            if (OV5640_Focus_Init(pObj) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else {
+                flags |= OV5640_RESUME_AF_RELOADED;
+            }
+        }
+#endif
 
-int32_t OV5640_Focus_Send_Constant_Focus(OV5640_Object_t *pObj) {
-    uint8_t temp = 0;
-    //
-    temp = 0x01;
-    ov5640_write_reg(&pObj->Ctx, 0x3023, &temp, 1);
-    temp = 0x04;
-    ov5640_write_reg(&pObj->Ctx, 0x3022, &temp, 1);
+        tmp = 0x02;
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_SYSTEM_CTROL0, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        pObj->Standby.Suspended = 0U;
+    }
 
-    return OV5640_OK;
+    if (pFlags != NULL) {
+        *pFlags = flags;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
 }
 
 const static uint8_t OV5640_SATURATION_TBL[7][6] = {
@@ -2908,38 +6651,76 @@ const static uint8_t OV5640_SATURATION_TBL[7][6] = {
     {0X2B, 0xAB, 0XD6, 0XDA, 0XD6, 0X04}  //+3
 };
 
-void OV5640_Color_Saturation(OV5640_Object_t *pObj, uint8_t sat) {
+/**
+ * @brief  Set the color saturation through the color matrix
+ * @param  pObj  pointer to component object
+ * @param  sat   0 (-3) to 6 (+3), 3 for the default saturation
+ * @retval Component status
+ */
+int32_t OV5640_Color_Saturation(OV5640_Object_t *pObj, uint8_t sat) {
+    int32_t ret = OV5640_OK;
     uint8_t i;
     uint8_t temp = 0;
 
-    temp         = 0x03;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((sat > 6U) || (OV5640_GroupOpen(pObj) != OV5640_OK)) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        return OV5640_ERROR;
+    }
+
     temp = 0x1c;
-    ov5640_write_reg(&pObj->Ctx, 0x5381, &temp, 1);
-    temp = 0x5a;
-    ov5640_write_reg(&pObj->Ctx, 0x5382, &temp, 1);
-    temp = 0x06;
-    ov5640_write_reg(&pObj->Ctx, 0x5383, &temp, 1);
+    ret  = ov5640_write_reg(&pObj->Ctx, 0x5381, &temp, 1);
+    if (ret == OV5640_OK) {
+        temp = 0x5a;
+        ret  = ov5640_write_reg(&pObj->Ctx, 0x5382, &temp, 1);
+    }
+    if (ret == OV5640_OK) {
+        temp = 0x06;
+        ret  = ov5640_write_reg(&pObj->Ctx, 0x5383, &temp, 1);
+    }
 
-    for (i = 0; i < 6; i++) {
+    for (i = 0; (i < 6U) && (ret == OV5640_OK); i++) {
         temp = OV5640_SATURATION_TBL[sat][i];
-        ov5640_write_reg(&pObj->Ctx, 0x5384, &temp, 1);
+        ret  = ov5640_write_reg(&pObj->Ctx, 0x5384, &temp, 1);
     }
 
-    temp = 0x98;
-    ov5640_write_reg(&pObj->Ctx, 0x538b, &temp, 1);
-    temp = 0x01;
-    ov5640_write_reg(&pObj->Ctx, 0x538a, &temp, 1);
-    temp = 0x13;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
-    temp = 0xa3;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
+    if (ret == OV5640_OK) {
+        temp = 0x98;
+        ret  = ov5640_write_reg(&pObj->Ctx, 0x538b, &temp, 1);
+    }
+    if (ret == OV5640_OK) {
+        temp = 0x01;
+        ret  = ov5640_write_reg(&pObj->Ctx, 0x538a, &temp, 1);
+    }
+
+    /* Launch even after a failure so the bank is not left holding */
+    if ((OV5640_GroupClose(pObj) != OV5640_OK) || (ret != OV5640_OK)) {
+        ret = OV5640_ERROR;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
 }
 
-void OV5640_Contrast(OV5640_Object_t *pObj, uint8_t contrast) {
+/**
+ * @brief  Set the contrast
+ * @param  pObj      pointer to component object
+ * @param  contrast  0 (-3) to 6 (+3), 3 for the default contrast
+ * @retval Component status
+ */
+int32_t OV5640_Contrast(OV5640_Object_t *pObj, uint8_t contrast) {
+    int32_t ret;
     uint8_t reg0val = 0X00;
     uint8_t reg1val = 0X20;
     uint8_t temp    = 0;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
     switch (contrast) {
     case 0: //-3
         reg1val = reg0val = 0X14;
@@ -2964,54 +6745,356 @@ void OV5640_Contrast(OV5640_Object_t *pObj, uint8_t contrast) {
         break;
     }
 
-    temp = 0x03;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
+    if (OV5640_GroupOpen(pObj) != OV5640_OK) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        return OV5640_ERROR;
+    }
+
     temp = reg0val;
-    ov5640_write_reg(&pObj->Ctx, 0x5585, &temp, 1);
-    temp = reg1val;
-    ov5640_write_reg(&pObj->Ctx, 0x5586, &temp, 1);
-    temp = 0x13;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
-    temp = 0xa3;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
+    ret  = ov5640_write_reg(&pObj->Ctx, 0x5585, &temp, 1);
+    if (ret == OV5640_OK) {
+        temp = reg1val;
+        ret  = ov5640_write_reg(&pObj->Ctx, 0x5586, &temp, 1);
+    }
+
+    if ((OV5640_GroupClose(pObj) != OV5640_OK) || (ret != OV5640_OK)) {
+        ret = OV5640_ERROR;
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
 }
 
-void OV5640_Sharpness(OV5640_Object_t *pObj, uint8_t sharp) {
-    uint8_t temp = 0;
-#define wr_reg(x, y) \
-    temp = (y);      \
-    ov5640_write_reg(&pObj->Ctx, (x), &temp, 1)
+/**
+ * @brief  Set the sharpness
+ * @param  pObj   pointer to component object
+ * @param  sharp  manual sharpness 0 to 32, 33 or more for auto sharpness
+ * @retval Component status
+ */
+int32_t OV5640_Sharpness(OV5640_Object_t *pObj, uint8_t sharp) {
+    int32_t ret;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    ret = OV5640_WriteSharpness(pObj, sharp);
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Write the sharpening registers of OV5640_Sharpness
+ * @param  pObj   pointer to component object
+ * @param  sharp  manual sharpness 0 to 32, 33 or more for auto sharpness
+ * @retval Component status
+ */
+static int32_t OV5640_WriteSharpness(OV5640_Object_t *pObj, uint8_t sharp) {
+    int32_t ret;
 
     if (sharp < 33) {
-        wr_reg(0x5308, 0x65);
-        wr_reg(0x5302, sharp);
+        OV5640_RegVal_t regs[] = {
+            {0x5308, 0x65 },
+            {0x5302, sharp}
+        };
+
+        ret = OV5640_WriteTable(pObj, regs, OV5640_TABLE_LEN(regs));
     }
     else {
-        wr_reg(0x5308, 0x25);
-        wr_reg(0x5300, 0x08);
-        wr_reg(0x5301, 0x30);
-        wr_reg(0x5302, 0x10);
-        wr_reg(0x5303, 0x00);
-        wr_reg(0x5309, 0x08);
-        wr_reg(0x530a, 0x30);
-        wr_reg(0x530b, 0x04);
-        wr_reg(0x530c, 0x06);
+        static const OV5640_RegVal_t regs[] = {
+            {0x5308, 0x25},
+            {0x5300, 0x08},
+            {0x5301, 0x30},
+            {0x5302, 0x10},
+            {0x5303, 0x00},
+            {0x5309, 0x08},
+            {0x530a, 0x30},
+            {0x530b, 0x04},
+            {0x530c, 0x06}
+        };
+
+        ret = OV5640_WriteTable(pObj, regs, OV5640_TABLE_LEN(regs));
     }
+
+    return ret;
 }
 
-void OV5640_StartGroup(OV5640_Object_t *pObj) {
-    uint8_t temp    = 0;
-    temp = 0x03;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
+/**
+ * @brief  Open the default group bank for the writes that follow
+ * @note   The ISP lock is held from OV5640_StartGroup to OV5640_UseGroup,
+ *         only call OV5640_UseGroup when OV5640_StartGroup succeeded.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_StartGroup(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_GroupOpen(pObj) != OV5640_OK) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        ret = OV5640_ERROR;
+    }
+
+    return ret;
 }
 
-void OV5640_UseGroup(OV5640_Object_t *pObj) {
-    uint8_t temp    = 0;
-    temp = 0x13;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
-    temp = 0xa3;
-    ov5640_write_reg(&pObj->Ctx, 0x3212, &temp, 1);
+/**
+ * @brief  Launch the default group bank opened by OV5640_StartGroup
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_UseGroup(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_GroupClose(pObj);
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+/**
+ * @brief  Open a group hold batch
+ * @note   Until OV5640_CommitBatch, every register written through the driver
+ *         is stored in the group bank instead of being applied, and the
+ *         setters that normally open their own group hold (OutSize_Set,
+ *         ImageWin_Set, Color_Saturation, Contrast, mode profiles, ...) join
+ *         the batch. Any combination of setters, e.g. SetBrightness,
+ *         Contrast, Sharpness and ZoomConfig, is then applied on one frame.
+ *         With OV5640_USE_LOCKS, the calling task holds the ISP lock until
+ *         OV5640_CommitBatch so the setters of other tasks stay out of the
+ *         batch.
+ * @param  pObj  pointer to component object
+ * @param  Bank  group bank, 0 to 3. A bank can be staged with
+ *               OV5640_GROUP_LAUNCH_NONE while another one is live.
+ * @retval Component status
+ */
+int32_t OV5640_BeginBatch(OV5640_Object_t *pObj, uint8_t Bank) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (Bank > OV5640_GROUP_BANK_MAX) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if (pObj->GroupActive != 0U) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        ret = OV5640_ERROR;
+    }
+    else {
+        tmp = OV5640_GROUP_HOLD_START(Bank);
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_SRM_GROUP_ACCESS, &tmp, 1) != OV5640_OK) {
+            OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+            ret = OV5640_ERROR;
+        }
+        else {
+            pObj->GroupBank   = Bank;
+            pObj->GroupActive = 1U;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Close the group hold batch opened by OV5640_BeginBatch
+ * @param  pObj    pointer to component object
+ * @param  Launch  OV5640_GROUP_LAUNCH_QUICK to apply the bank at once,
+ *                 OV5640_GROUP_LAUNCH_DELAYED to apply it on the next frame,
+ *                 OV5640_GROUP_LAUNCH_NONE to keep it staged for OV5640_LaunchBatch
+ * @retval Component status
+ */
+int32_t OV5640_CommitBatch(OV5640_Object_t *pObj, uint32_t Launch) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (pObj->GroupActive == 0U) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->GroupActive = 0U;
+
+        tmp               = OV5640_GROUP_HOLD_END(pObj->GroupBank);
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_SRM_GROUP_ACCESS, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else if (Launch != OV5640_GROUP_LAUNCH_NONE) {
+            ret = OV5640_LaunchBatch(pObj, pObj->GroupBank, Launch);
+        }
+
+        /* Taken by OV5640_BeginBatch */
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Apply a group bank previously staged by OV5640_CommitBatch
+ * @param  pObj    pointer to component object
+ * @param  Bank    group bank, 0 to 3
+ * @param  Launch  OV5640_GROUP_LAUNCH_QUICK or OV5640_GROUP_LAUNCH_DELAYED
+ * @retval Component status
+ */
+int32_t OV5640_LaunchBatch(OV5640_Object_t *pObj, uint8_t Bank, uint32_t Launch) {
+    int32_t ret = OV5640_OK;
+    uint8_t tmp;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        return OV5640_ERROR;
+    }
+
+    if ((Bank > OV5640_GROUP_BANK_MAX) || (Launch == OV5640_GROUP_LAUNCH_NONE)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        tmp = (Launch == OV5640_GROUP_LAUNCH_DELAYED) ? OV5640_GROUP_DELAY_LAUNCH(Bank)
+                                                       : OV5640_GROUP_QUICK_LAUNCH(Bank);
+        if (ov5640_write_reg(&pObj->Ctx, OV5640_SRM_GROUP_ACCESS, &tmp, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    return ret;
+}
+
+#if (OV5640_USE_DEFERRED == 1U)
+/**
+ * @brief  Start queuing the register writes for the next frame boundary
+ * @note   Until OV5640_EndDeferred, the setters called on this object, e.g.
+ *         ZoomConfig, MirrorFlipConfig or SetLightMode, queue their writes
+ *         instead of sending them, and their reads see the queued values.
+ *         The AF calls must stay out of that window, their commands would
+ *         be queued as well. With OV5640_USE_LOCKS, the calling task holds
+ *         the ISP lock until OV5640_EndDeferred.
+ * @param  pObj  pointer to component object
+ * @retval Component status
+ */
+int32_t OV5640_BeginDeferred(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (OV5640_Lock(pObj, OV5640_LOCK_ISP) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    else if ((pObj->Deferred.Capture != 0U) || (pObj->GroupActive != 0U)) {
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->Deferred.Start    = pObj->Deferred.Count;
+        pObj->Deferred.Overflow = 0U;
+        pObj->Deferred.Capture  = 1U;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Stop queuing and hand the queued writes to OV5640_FlushDeferred
+ * @note   When the writes of the capture did not fit in the queue, they are
+ *         all dropped so that no frame gets a partial update.
+ * @param  pObj  pointer to component object
+ * @retval Component status, OV5640_ERROR when the capture was dropped
+ */
+int32_t OV5640_EndDeferred(OV5640_Object_t *pObj) {
+    int32_t ret = OV5640_OK;
+
+    if (pObj->Deferred.Capture == 0U) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pObj->Deferred.Capture = 0U;
+        if (pObj->Deferred.Overflow != 0U) {
+            pObj->Deferred.Count = pObj->Deferred.Start;
+            ret                  = OV5640_ERROR;
+        }
+
+        /* Taken by OV5640_BeginDeferred */
+        OV5640_Unlock(pObj, OV5640_LOCK_ISP);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Send the queued writes as one group bank latched on the next frame
+ * @note   Call it from the VSYNC or frame end interrupt. The sensor applies
+ *         the bank at the start of the next frame, so the writes never land
+ *         in the middle of a frame even when the transfer overlaps the
+ *         readout. While a driver call, a capture or an asynchronous job is
+ *         in progress on the object, nothing is sent and the queue waits for
+ *         the next call. IO.WriteReg must be callable from the interrupt,
+ *         the lock hooks are not used.
+ * @param  pObj  pointer to component object
+ * @retval Component status, OV5640_OK when nothing was pending. On error
+ *         the queue is kept and sent again by the next call.
+ */
+int32_t OV5640_FlushDeferred(OV5640_Object_t *pObj) {
+    OV5640_Deferred_t *pDef = &pObj->Deferred;
+    int32_t            ret  = OV5640_OK;
+    uint32_t           i;
+    uint32_t           max;
+    uint16_t           reg;
+    uint16_t           len;
+    uint8_t            run[OV5640_TABLE_RUN_SIZE];
+    uint8_t            idle;
+
+    idle = ((pDef->Owners == 0U) && (pDef->Capture == 0U)) ? 1U : 0U;
+#if (OV5640_USE_ASYNC_IO == 1U)
+    if (pObj->Async.Busy != 0U) {
+        idle = 0U;
+    }
+#endif
+
+    if ((idle != 0U) && (pDef->Count != 0U)) {
+        max = OV5640_TABLE_RUN_SIZE;
+        if ((pObj->BurstSize != 0U) && (pObj->BurstSize < max)) {
+            max = pObj->BurstSize;
+        }
+
+        run[0] = OV5640_GROUP_HOLD_START(OV5640_DEFERRED_BANK);
+        if (OV5640_DeferredSend(pObj, OV5640_SRM_GROUP_ACCESS, run, 1) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            /* Merge the runs of consecutive registers */
+            i = 0;
+            while ((ret == OV5640_OK) && (i < pDef->Count)) {
+                reg = pDef->Entry[i].Reg;
+                len = 0;
+                do {
+                    run[len] = pDef->Entry[i].Value;
+                    len++;
+                    i++;
+                }
+                while ((i < pDef->Count) && (len < max) && (pDef->Entry[i].Reg == (uint16_t)(reg + len)));
+
+                ret = OV5640_DeferredSend(pObj, reg, run, len);
+            }
+
+            /* Always close the group, the sensor would keep recording */
+            run[0] = OV5640_GROUP_HOLD_END(OV5640_DEFERRED_BANK);
+            if (OV5640_DeferredSend(pObj, OV5640_SRM_GROUP_ACCESS, run, 1) != OV5640_OK) {
+                ret = OV5640_ERROR;
+            }
+            else if (ret == OV5640_OK) {
+                run[0] = OV5640_GROUP_DELAY_LAUNCH(OV5640_DEFERRED_BANK);
+                ret    = OV5640_DeferredSend(pObj, OV5640_SRM_GROUP_ACCESS, run, 1);
+            }
+        }
+
+        if (ret == OV5640_OK) {
+            pDef->Count = 0;
+            pDef->Flushed++;
+        }
+    }
+
+    return ret;
 }
+#endif
 
 /**
  * @}
@@ -52,7 +52,83 @@ extern "C"
     typedef int32_t (*OV5640_Delay_Func)(uint32_t);
     typedef int32_t (*OV5640_WriteReg_Func)(uint16_t, uint16_t, uint8_t *, uint16_t);
     typedef int32_t (*OV5640_ReadReg_Func)(uint16_t, uint16_t, uint8_t *, uint16_t);
+    typedef void (*OV5640_XferCplt_Func)(void *, int32_t);
+    typedef int32_t (*OV5640_Lock_Func)(uint16_t, uint32_t);
 
+    /* Size of the buffer used to coalesce consecutive table entries */
+    #ifndef OV5640_TABLE_RUN_SIZE
+        #define OV5640_TABLE_RUN_SIZE 64U
+    #endif
+
+    /* Sleeping Delay hook in OV5640_IO_t, without it the driver busy-waits on
+       GetTick */
+    #ifndef OV5640_USE_DELAY_HOOK
+        #define OV5640_USE_DELAY_HOOK 0U
+    #endif
+
+    #ifndef OV5640_USE_ASYNC_IO
+        #define OV5640_USE_ASYNC_IO 0U
+    #endif
+
+    /* Mutex hooks in OV5640_IO_t for calls from several tasks */
+    #ifndef OV5640_USE_LOCKS
+        #define OV5640_USE_LOCKS 0U
+    #endif
+
+    /* Number of pending asynchronous jobs per component object */
+    #ifndef OV5640_ASYNC_QUEUE_SIZE
+        #define OV5640_ASYNC_QUEUE_SIZE 8U
+    #endif
+
+    /* Longest wait in ms of a blocking transfer for the asynchronous jobs in
+       flight, which own the bus until the queue is empty */
+    #ifndef OV5640_ASYNC_WAIT_MS
+        #define OV5640_ASYNC_WAIT_MS 500U
+    #endif
+
+    /* Setter writes queued and applied on a frame boundary, see
+       OV5640_BeginDeferred */
+    #ifndef OV5640_USE_DEFERRED
+        #define OV5640_USE_DEFERRED 0U
+    #endif
+
+    /* Number of register writes held for the next frame */
+    #ifndef OV5640_DEFERRED_SIZE
+        #define OV5640_DEFERRED_SIZE 32U
+    #endif
+
+    /* Feature trimming for fixed deployments: set to 0U to compile out the
+       AF firmware and API, the JPEG output, the MIPI or DVP interface, the
+       manual white balance presets or the color effects */
+    #ifndef OV5640_CFG_AF
+        #define OV5640_CFG_AF 1U
+    #endif
+    #ifndef OV5640_CFG_JPEG
+        #define OV5640_CFG_JPEG 1U
+    #endif
+    #ifndef OV5640_CFG_MIPI
+        #define OV5640_CFG_MIPI 1U
+    #endif
+    #ifndef OV5640_CFG_DVP
+        #define OV5640_CFG_DVP 1U
+    #endif
+    #ifndef OV5640_CFG_LIGHT_MODES
+        #define OV5640_CFG_LIGHT_MODES 1U
+    #endif
+    #ifndef OV5640_CFG_COLOR_EFFECTS
+        #define OV5640_CFG_COLOR_EFFECTS 1U
+    #endif
+
+    /* OV5640_Init applies the single OV5640_FixedInit table generated on a
+       host by OV5640_SIM_GenerateInit instead of its own sequence */
+    #ifndef OV5640_CFG_FIXED_INIT
+        #define OV5640_CFG_FIXED_INIT 0U
+    #endif
+
+    /* Bus IO given to OV5640_RegisterBusIO. The optional hooks only exist when
+       their OV5640_USE_xxx option is enabled, and are called whenever they
+       are not NULL: zero-initialize the struct (e.g. OV5640_IO_t io = {0})
+       and leave the hooks the bus layer does not provide to NULL */
     typedef struct
     {
         OV5640_Init_Func     Init;
@@ -61,9 +137,322 @@ extern "C"
         OV5640_WriteReg_Func WriteReg;
         OV5640_ReadReg_Func  ReadReg;
         OV5640_GetTick_Func  GetTick;
+    #if (OV5640_USE_DELAY_HOOK == 1U)
+        /* Sleep for the given number of milliseconds (e.g. vTaskDelay or
+           osDelay), NULL to busy-wait on GetTick */
+        OV5640_Delay_Func    Delay;
+    #endif
+    #if (OV5640_USE_ASYNC_IO == 1U)
+        /* Non-blocking transfers (e.g. I2C DMA), NULL when not supported. The bus
+           layer reports the end of each transfer with OV5640_AsyncCpltCallback.
+           Jobs are submitted from a task or from a completion callback, the
+           queue owns the bus until it is empty */
+        OV5640_WriteReg_Func WriteRegAsync;
+        OV5640_ReadReg_Func  ReadRegAsync;
+    #endif
+    #if (OV5640_USE_LOCKS == 1U)
+        /* Take and give back the mutex Id (OV5640_LOCK_xxx) of the sensor at
+           Address, 0 on success, NULL without RTOS. Exported functions call
+           each other, so the mutexes must be recursive (e.g.
+           xSemaphoreTakeRecursive). Not usable from interrupts: call
+           OV5640_AF_Process from a task */
+        OV5640_Lock_Func     Lock;
+        OV5640_Lock_Func     Unlock;
+    #endif
     } OV5640_IO_t;
 
 
+    /* One entry of a register initialization table */
+    typedef __PACKED_STRUCT
+    {
+        uint16_t Reg;
+        uint8_t  Value;
+    } OV5640_RegVal_t;
+
+    #ifndef OV5640_USE_REG_CACHE
+        #define OV5640_USE_REG_CACHE 0U
+    #endif
+
+    /* Number of shadowed registers, must be a power of 2 */
+    #ifndef OV5640_REG_CACHE_SIZE
+        #define OV5640_REG_CACHE_SIZE 256U
+    #endif
+
+    #if (OV5640_USE_REG_CACHE == 1U)
+    /* Direct-mapped write-through shadow of the sensor registers */
+    typedef struct
+    {
+        uint16_t Reg[OV5640_REG_CACHE_SIZE];   /*!< Cached register address, 0xFFFF when empty */
+        uint8_t  Value[OV5640_REG_CACHE_SIZE]; /*!< Last value written to or read from Reg     */
+    } OV5640_RegCache_t;
+    #endif
+
+    #if (OV5640_USE_ASYNC_IO == 1U)
+    /* Queued asynchronous job: register table write, block write or block read */
+    typedef struct
+    {
+        const OV5640_RegVal_t *pTable;   /*!< Table to write, NULL for block jobs */
+        uint8_t               *pData;    /*!< Block data for block jobs           */
+        uint32_t               Size;     /*!< Table entries or block bytes        */
+        uint16_t               Reg;      /*!< First register of a block job       */
+        uint8_t                Read;     /*!< 1 for a block read                  */
+        OV5640_XferCplt_Func   Callback; /*!< Called once the whole job is over  */
+        void                  *pArg;     /*!< Callback user argument              */
+    } OV5640_AsyncJob_t;
+
+    typedef struct
+    {
+        OV5640_AsyncJob_t Job[OV5640_ASYNC_QUEUE_SIZE];
+        volatile uint32_t Head;     /*!< Slot of the job being transferred     */
+        volatile uint32_t Count;    /*!< Number of queued jobs                 */
+        volatile uint8_t  Busy;     /*!< The queue is being processed          */
+        uint32_t          Index;    /*!< Progress inside the head job          */
+        uint16_t          XferReg;  /*!< First register of the transfer        */
+        uint16_t          XferLen;  /*!< Length of the transfer                */
+        uint8_t          *pXfer;    /*!< Buffer of the transfer                */
+        uint8_t           Run[OV5640_TABLE_RUN_SIZE];
+    } OV5640_Async_t;
+    #endif
+
+    #if (OV5640_USE_DEFERRED == 1U)
+    /* Register writes waiting for the next frame boundary */
+    typedef struct
+    {
+        OV5640_RegVal_t   Entry[OV5640_DEFERRED_SIZE];
+        volatile uint32_t Count;    /*!< Queued entries                             */
+        uint32_t          Start;    /*!< First entry of the open capture            */
+        volatile uint32_t Owners;   /*!< Driver locks taken, the flush waits for 0  */
+        uint32_t          Flushed;  /*!< Frames that received queued writes         */
+        volatile uint8_t  Capture;  /*!< 1 between BeginDeferred and EndDeferred    */
+        uint8_t           Overflow; /*!< The open capture did not fit               */
+    } OV5640_Deferred_t;
+    #endif
+
+    /* Times a failed bus transfer is issued again before the error is
+       reported, 0 to report the first failure. Asynchronous jobs and
+       OV5640_FlushDeferred never retry, they run in interrupt context */
+    #ifndef OV5640_BUS_RETRIES
+        #define OV5640_BUS_RETRIES 0U
+    #endif
+
+    /* Wait before the first retry in ms, doubled on each further retry so a
+       transfer never takes more than DELAY x (2^RETRIES - 1) ms extra */
+    #ifndef OV5640_BUS_RETRY_DELAY
+        #define OV5640_BUS_RETRY_DELAY 1U
+    #endif
+
+    #ifndef OV5640_USE_STATS
+        #define OV5640_USE_STATS 0U
+    #endif
+
+    /* Number of instrumentation call sites, see OV5640_SetStatsSite */
+    #ifndef OV5640_STATS_NUM_SITES
+        #define OV5640_STATS_NUM_SITES 8U
+    #endif
+
+    #if (OV5640_USE_STATS == 1U)
+    /* Bus cost accumulated by one call site */
+    typedef struct
+    {
+        uint32_t Transactions; /*!< Bus transfers issued                     */
+        uint32_t BytesWritten; /*!< Register bytes written                   */
+        uint32_t BytesRead;    /*!< Register bytes read                      */
+        uint32_t Errors;       /*!< Transfers reported as failed             */
+        uint32_t Retries;      /*!< Transfers issued again after a failure   */
+        uint32_t CacheHits;    /*!< Transfers avoided by the register cache  */
+        uint32_t Ticks;        /*!< Time spent in the bus hooks, GetTick unit */
+    } OV5640_StatsCounter_t;
+
+    typedef struct
+    {
+        OV5640_StatsCounter_t Site[OV5640_STATS_NUM_SITES];
+        uint8_t               Current; /*!< Site charged for the transfers */
+    } OV5640_Stats_t;
+    #endif
+
+    /* Number of registers held by a mode profile */
+    #define OV5640_PROFILE_NUM_REGS    49U
+    /* Entries of a profile delta table: registers plus group hold control */
+    #define OV5640_PROFILE_DELTA_SIZE  (OV5640_PROFILE_NUM_REGS + 3U)
+
+    /* Precomputed register image of a resolution/format/clock combination */
+    typedef struct
+    {
+        uint32_t Resolution;                     /*!< Index in solution_table     */
+        uint32_t PixelFormat;                    /*!< OV5640_RGB565, OV5640_JPEG, ... */
+        uint32_t PixelClock;                     /*!< OV5640_PCLK_xxx or AUTO     */
+        uint8_t  Value[OV5640_PROFILE_NUM_REGS];   /*!< Register image               */
+        uint8_t  Defined[OV5640_PROFILE_NUM_REGS]; /*!< 1 when the mode sets Value[i] */
+    } OV5640_ModeProfile_t;
+
+    /* PLL settings, PCLK = XCLK / PreDiv x Mult / SysDiv / RootDiv / 2 / PClkDiv */
+    typedef struct
+    {
+        uint8_t  PreDiv;  /*!< SC_PLL_CONTRL3[3:0]              */
+        uint8_t  RootDiv; /*!< 1 or 2, SC_PLL_CONTRL3[4]         */
+        uint8_t  Mult;    /*!< SC_PLL_CONTRL2, even above 127    */
+        uint8_t  SysDiv;  /*!< SC_PLL_CONTRL1[7:4]              */
+        uint8_t  PClkDiv; /*!< PCLK_MANUAL_DIV                   */
+        uint32_t PClk;    /*!< Resulting pixel clock in Hz       */
+    } OV5640_PLL_t;
+
+    /* Sensor readout and timing computed for an arbitrary output size */
+    typedef struct
+    {
+        uint16_t Width;      /*!< Scaler output size, OV5640_OutSize_Set   */
+        uint16_t Height;
+        uint16_t XStart;     /*!< Readout window, OV5640_ImageWin_Set      */
+        uint16_t YStart;
+        uint16_t XSize;
+        uint16_t YSize;
+        uint8_t  Subsample;  /*!< 1 for full readout, 2 for 2x subsampling */
+        uint16_t Hts;        /*!< Total line length in pixels              */
+        uint16_t Vts;        /*!< Total frame length in lines              */
+        uint32_t PixelClock; /*!< OV5640_PCLK_xxx, CUSTOM or AUTO          */
+        uint32_t FrameRate;  /*!< Requested frame rate, 0 for the fastest  */
+        OV5640_PLL_t Pll;    /*!< PLL settings when PixelClock is CUSTOM   */
+    } OV5640_OutputMode_t;
+
+    /* Region streamed 1:1 by the ROI mode */
+    typedef struct
+    {
+        uint16_t X;             /*!< Left column of the 2592x1944 ISP area      */
+        uint16_t Y;             /*!< Top row of the 2592x1944 ISP area          */
+        uint16_t Width;         /*!< Region and output size                     */
+        uint16_t Height;
+        uint32_t XClk;          /*!< Sensor input clock in Hz                   */
+        uint32_t BytesPerPixel; /*!< 1 for Y8 and JPEG, 2 for RGB565 and YUV422 */
+        uint32_t MaxPClk;       /*!< Host PCLK limit in Hz, 0 for the sensor's  */
+        uint32_t FrameRate;     /*!< Frame rate in fps, 0 for the fastest       */
+    } OV5640_ROI_t;
+
+    /* Timing and PLL blocks compared on resume to detect register loss */
+    #define OV5640_STANDBY_TIMING_SIZE 22U /* 0x3800 ~ 0x3815 */
+    #define OV5640_STANDBY_PLL_SIZE    4U  /* 0x3034 ~ 0x3037 */
+
+    /* State recorded when entering software standby */
+    typedef struct
+    {
+        uint8_t  Suspended;                          /*!< 1 between Suspend and Resume      */
+        uint8_t  AFResident;                         /*!< AF firmware was running           */
+        uint8_t  Timing[OV5640_STANDBY_TIMING_SIZE]; /*!< Timing registers at suspend       */
+        uint8_t  Pll[OV5640_STANDBY_PLL_SIZE];       /*!< PLL registers at suspend          */
+        uint32_t Resolution;                         /*!< Last Init_General_Mode resolution */
+        uint32_t PixelFormat;                        /*!< Last Init_General_Mode format     */
+    } OV5640_Standby_t;
+
+    /* Image tuning preset of OV5640_SetLook */
+    typedef struct
+    {
+        int32_t Brightness; /*!< -4 to 4, levels of OV5640_SetBrightness */
+        int32_t Contrast;   /*!< -4 to 4, levels of OV5640_SetContrast   */
+        int32_t Saturation; /*!< -4 to 4, levels of OV5640_SetSaturation */
+        int32_t HueDegree;  /*!< -6 to 5, steps of OV5640_SetHueDegree   */
+        uint8_t Sharpness;  /*!< 0 to 32 manual, OV5640_SHARPNESS_xxx    */
+    } OV5640_Look_t;
+
+    #define OV5640_SDE_SIZE 9U /* SDE_CTRL0 ~ SDE_CTRL8, 0x5580 ~ 0x5588 */
+
+    /* Registers of a preset computed by OV5640_ComputeLook */
+    typedef struct
+    {
+        uint8_t Sde[OV5640_SDE_SIZE]; /*!< Sent as a single burst         */
+        uint8_t Bright;               /*!< Brightness sign of SDE_CTRL8   */
+        uint8_t HueDegree;            /*!< Hue signs of SDE_CTRL8         */
+        uint8_t Sharpness;            /*!< As in OV5640_Look_t            */
+    } OV5640_LookRegs_t;
+
+    /* Streaming and monitor modes of OV5640_BuildPowerProfiles */
+    typedef struct
+    {
+        uint32_t Resolution;        /*!< Streaming resolution, index in solution_table */
+        uint32_t PixelFormat;       /*!< Streaming pixel format                        */
+        uint32_t PixelClock;        /*!< OV5640_PCLK_xxx or OV5640_PROFILE_PCLK_AUTO   */
+        uint32_t MonitorResolution; /*!< Monitor resolution, index in solution_table   */
+        uint32_t MonitorFormat;     /*!< Monitor pixel format, subsampled unless JPEG  */
+        uint32_t MonitorFrameRate;  /*!< Monitor frame rate in fps                     */
+    } OV5640_PowerConfig_t;
+
+    /* Precomputed power profiles, one set per sensor */
+    typedef struct
+    {
+        OV5640_ModeProfile_t Streaming; /*!< Full rate capture                        */
+        OV5640_ModeProfile_t Monitor;   /*!< Lowest pixel clock, VTS stretched         */
+        uint8_t              Pad[2];    /*!< Pad enables saved by PAD_OFF, from 0x3017 */
+        uint8_t              State;     /*!< OV5640_POWER_xxx applied last             */
+    } OV5640_PowerProfiles_t;
+
+    #define OV5640_MIPI_CLOCK_GATED      0U /* Clock lane stops between packets */
+    #define OV5640_MIPI_CLOCK_CONTINUOUS 1U /* Clock lane always in HS mode     */
+    #define OV5640_MIPI_VC_MAX           3U /* CSI-2 virtual channels 0 to 3    */
+
+    /* MIPI CSI-2 link request of OV5640_ComputeMIPI */
+    typedef struct
+    {
+        uint32_t XClk;           /*!< Sensor input clock in Hz                       */
+        uint32_t PClk;           /*!< Byte rate to carry in Hz, as the DVP PCLK      */
+        uint8_t  Lanes;          /*!< Data lanes, 1 or 2                             */
+        uint8_t  Continuous;     /*!< OV5640_MIPI_CLOCK_xxx                          */
+        uint8_t  VirtualChannel; /*!< 0 to OV5640_MIPI_VC_MAX                        */
+    } OV5640_MIPIConfig_t;
+
+    /* MIPI CSI-2 link settings computed by OV5640_ComputeMIPI */
+    typedef struct
+    {
+        uint32_t LaneRate;       /*!< Bit rate of each data lane in bit/s            */
+        uint8_t  PreDiv;         /*!< SC_PLL_CONTRL3[3:0]                            */
+        uint8_t  Mult;           /*!< SC_PLL_CONTRL2                                 */
+        uint8_t  SysDiv;         /*!< SC_PLL_CONTRL1[7:4]                            */
+        uint8_t  MipiDiv;        /*!< SC_PLL_CONTRL1[3:0]                            */
+        uint8_t  PClkPeriod;     /*!< PCLK_PERIOD, byte clock period in ns           */
+        uint8_t  Lanes;          /*!< As in OV5640_MIPIConfig_t                      */
+        uint8_t  Continuous;     /*!< As in OV5640_MIPIConfig_t                      */
+        uint8_t  VirtualChannel; /*!< As in OV5640_MIPIConfig_t                      */
+    } OV5640_MIPILink_t;
+
+    /* JPEG compressed size controller */
+    typedef struct
+    {
+        uint32_t TargetSize; /*!< Target bytes per frame, 0 when disabled  */
+        uint8_t  QScale;     /*!< Quantization scale programmed in 0x4407  */
+        uint8_t  MinQScale;  /*!< Best quality allowed                     */
+        uint8_t  MaxQScale;  /*!< Strongest compression allowed            */
+    } OV5640_JPEGRate_t;
+
+    /* Manual exposure and gain */
+    #define OV5640_AEC_SHADOW_SIZE 12U /* 0x3500 ~ 0x350B */
+
+    typedef struct
+    {
+        uint8_t Regs[OV5640_AEC_SHADOW_SIZE]; /*!< Last values sent from 0x3500      */
+        uint8_t Manual;                       /*!< 1 once OV5640_SetManualExposure  */
+        uint8_t Bank;                         /*!< Group bank used by the next apply */
+    } OV5640_AEC_t;
+
+    /* Measurements of the sensor AEC and AWB, see OV5640_GetSensorStats */
+    #define OV5640_LUMA_ZONES 16U /* 4 x 4 windows, 0x5691 ~ 0x56A0 */
+
+    typedef struct
+    {
+        uint8_t  Luma;                        /*!< Average of the AEC window        */
+        uint8_t  ZoneLuma[OV5640_LUMA_ZONES]; /*!< Averages of the 4 x 4 windows    */
+        uint16_t AWBGain[3];                  /*!< Current R, G, B gains, 0x400 = 1x */
+        uint8_t  AWBAverage[3];               /*!< R, G, B averages seen by the AWB */
+        uint32_t Exposure;                    /*!< Current exposure in 1/16 line    */
+        uint16_t Gain;                        /*!< Current gain in 1/16 (16 = 1x)   */
+    } OV5640_SensorStats_t;
+
+    /* Non-blocking autofocus sequencer */
+    typedef struct
+    {
+        uint8_t              State;     /*!< OV5640_AF_IDLE, OV5640_AF_BUSY, ...     */
+        uint8_t              Step;      /*!< Command currently acknowledged by the MCU */
+        uint32_t             TickStart; /*!< GetTick value when the command was sent */
+        uint32_t             Timeout;   /*!< Timeout of the whole sequence in ms      */
+        OV5640_XferCplt_Func Callback;  /*!< Called when the sequence is over        */
+        void                *pArg;      /*!< Callback user argument                  */
+    } OV5640_AF_t;
+
     typedef struct
     {
         OV5640_IO_t  IO;
@@ -75,6 +464,28 @@ extern "C"
         uint32_t     contrast;
         uint32_t     bright;
         uint32_t     huedegree;
+        uint16_t     BurstSize;
+        OV5640_AF_t  AF;
+        /* Mode profile applied last, NULL when the sensor mode is unknown */
+        const OV5640_ModeProfile_t *pProfile;
+        uint8_t      GroupBank;   /* Bank of the open batch              */
+        uint8_t      GroupActive; /* 1 between BeginBatch and CommitBatch */
+        uint8_t      CustomReadout; /* Readout set by OV5640_ApplyOutputMode */
+        OV5640_Standby_t Standby;
+        OV5640_JPEGRate_t JPEGRate;
+        OV5640_AEC_t AEC;
+    #if (OV5640_USE_REG_CACHE == 1U)
+        OV5640_RegCache_t RegCache;
+    #endif
+    #if (OV5640_USE_ASYNC_IO == 1U)
+        OV5640_Async_t Async;
+    #endif
+    #if (OV5640_USE_DEFERRED == 1U)
+        OV5640_Deferred_t Deferred;
+    #endif
+    #if (OV5640_USE_STATS == 1U)
+        OV5640_Stats_t Stats;
+    #endif
     } OV5640_Object_t;
 
     typedef struct
@@ -129,6 +540,18 @@ extern "C"
      */
     #define OV5640_OK                    (0)
     #define OV5640_ERROR                 (-1)
+
+    /* Maximum number of bytes sent in a single auto-increment SCCB burst.
+       Can be overridden to fit the host I2C/DMA transfer limit. */
+    #ifndef OV5640_BURST_SIZE
+        #define OV5640_BURST_SIZE        256U
+    #endif
+
+    /* Sensor input clock in Hz assumed by OV5640_ComputeOutputMode to solve
+       the PLL of a frame rate */
+    #ifndef OV5640_XCLK_FREQ
+        #define OV5640_XCLK_FREQ         24000000U
+    #endif
     /**
      * @brief  OV5640 Features Parameters
      */
@@ -208,11 +631,85 @@ extern "C"
     #define OV5640_PCLK_12M              0x04U /* Pixel Clock set to 12Mhz   */
     #define OV5640_PCLK_24M              0x08U /* Pixel Clock set to 24Mhz   */
     #define OV5640_PCLK_48M              0x09U /* Pixel Clock set to 48MHz   */
+    #define OV5640_PROFILE_PCLK_AUTO     0xFFU /* Keep the mode table PLL    */
+    #define OV5640_PCLK_CUSTOM           0xFEU /* PLL computed by the solver */
 
     /* Mode */
     #define PARALLEL_MODE                0x00U /* Parallel Interface Mode */
     #define SERIAL_MODE                  0x01U /* Serial Interface Mode   */
 
+    /* Resume report flags */
+    #define OV5640_RESUME_WARM           0x00U /* All the state was retained      */
+    #define OV5640_RESUME_REGS_RESTORED  0x01U /* Registers lost, mode re-applied */
+    #define OV5640_RESUME_AF_RELOADED    0x02U /* AF firmware downloaded again    */
+    #define OV5640_MODE_UNKNOWN          0xFFFFFFFFU
+    #define OV5640_FIXED_INIT_DELAY      0xFFFFU /* OV5640_FixedInit entry: wait Value ms */
+
+    /* Power profiles */
+    #define OV5640_POWER_STREAMING       0x00U /* Full rate capture                */
+    #define OV5640_POWER_MONITOR         0x01U /* Low frame rate, lowest PCLK      */
+    #define OV5640_POWER_STANDBY         0x02U /* Software standby, registers kept */
+    #define OV5640_POWER_PAD_OFF         0x03U /* Standby with the pads tristated  */
+    #define OV5640_POWER_UNKNOWN         0xFFU /* Not set since the build          */
+
+    /* Driver locks, taken in the order ISP, AF, BUS */
+    #define OV5640_LOCK_BUS              0x00U /* One transaction and the cache  */
+    #define OV5640_LOCK_ISP              0x01U /* Sensor, ISP and group hold     */
+    #define OV5640_LOCK_AF               0x02U /* AF MCU and its firmware        */
+
+    /* Statistics */
+    #define OV5640_STATS_ALL             0xFFU /* Sum of every call site     */
+
+    /* Sharpness of OV5640_Look_t */
+    #define OV5640_SHARPNESS_AUTO        0x21U /* Sensor auto sharpness      */
+    #define OV5640_SHARPNESS_KEEP        0xFFU /* Not written by the preset  */
+
+    /* Group hold batch */
+    #define OV5640_GROUP_BANK_MAX        0x03U /* Banks 0 to 3               */
+    #define OV5640_GROUP_LAUNCH_QUICK    0x00U /* Apply the bank at once     */
+    #define OV5640_GROUP_LAUNCH_DELAYED  0x01U /* Apply on the next frame    */
+    #define OV5640_GROUP_LAUNCH_NONE     0x02U /* Keep the bank staged       */
+
+    /* Autofocus */
+    #define OV5640_AF_SINGLE             0x00U /* Focus once and hold the lens   */
+    #define OV5640_AF_CONTINUOUS         0x01U /* Release then continuous focus  */
+
+    #define OV5640_AF_IDLE               0x00U /* No sequence in progress   */
+    #define OV5640_AF_BUSY               0x01U /* Waiting for the AF MCU    */
+    #define OV5640_AF_DONE               0x02U /* Sequence completed        */
+    #define OV5640_AF_TIMEOUT            0x03U /* AF MCU did not answer     */
+    #define OV5640_AF_FAILED             0x04U /* Bus error                 */
+
+    #ifndef OV5640_AF_TIMEOUT_MS
+        #define OV5640_AF_TIMEOUT_MS     1000U /* Blocking focus timeout    */
+    #endif
+
+    /* AF firmware readback checked against the CRC of OV5640_AF_Config */
+    #define OV5640_AF_VERIFY_NONE        0x00U /* Download is trusted            */
+    #define OV5640_AF_VERIFY_SAMPLED     0x01U /* A few windows spread over it   */
+    #define OV5640_AF_VERIFY_FULL        0x02U /* The whole program RAM          */
+
+    /* Check of OV5640_Focus_Upload and of the resident firmware skipping the
+       download in OV5640_Focus_Init, NONE always downloads */
+    #ifndef OV5640_AF_VERIFY_MODE
+        #define OV5640_AF_VERIFY_MODE    OV5640_AF_VERIFY_SAMPLED
+    #endif
+
+    /* Manual exposure in 1/16 line and gain in 1/16 (16 = 1x) */
+    #define OV5640_EXPOSURE_MAX          0xFFFFFU
+    #define OV5640_GAIN_MAX              0x3FFU
+    #define OV5640_AEC_WINDOW_MAX        0xFFFU /* AEC window coordinates */
+
+    /* Blocks read by OV5640_GetSensorStats, one burst each */
+    #define OV5640_SENSOR_STATS_LUMA     0x01U /* Luma, ZoneLuma         */
+    #define OV5640_SENSOR_STATS_AWB      0x02U /* AWBGain, AWBAverage    */
+    #define OV5640_SENSOR_STATS_AEC      0x04U /* Exposure, Gain         */
+    #define OV5640_SENSOR_STATS_ALL      0x07U
+
+    /* JPEG quantization scale, larger values compress more */
+    #define OV5640_JPEG_QSCALE_MIN       0x01U
+    #define OV5640_JPEG_QSCALE_MAX       0x3FU
+
     /**
      * @}
      */
@@ -231,6 +728,9 @@ extern "C"
     int32_t OV5640_SetSaturation(OV5640_Object_t *pObj, int32_t Level);
     int32_t OV5640_SetContrast(OV5640_Object_t *pObj, int32_t Level);
     int32_t OV5640_SetHueDegree(OV5640_Object_t *pObj, int32_t Degree);
+    int32_t OV5640_ComputeLook(const OV5640_Look_t *pLook, OV5640_LookRegs_t *pRegs);
+    int32_t OV5640_ApplyLook(OV5640_Object_t *pObj, const OV5640_LookRegs_t *pRegs);
+    int32_t OV5640_SetLook(OV5640_Object_t *pObj, const OV5640_Look_t *pLook);
     int32_t OV5640_MirrorFlipConfig(OV5640_Object_t *pObj, uint32_t Config);
     int32_t OV5640_ZoomConfig(OV5640_Object_t *pObj, uint32_t Zoom);
     int32_t OV5640_SetResolution(OV5640_Object_t *pObj, uint32_t Resolution);
@@ -246,20 +746,86 @@ extern "C"
     int32_t OV5640_EmbeddedSynchroConfig(OV5640_Object_t *pObj, OV5640_SyncCodes_t *pSyncCodes);
     int32_t OV5640_SetPCLK(OV5640_Object_t *pObj, uint32_t ClockValue);
 
+    #if (OV5640_CFG_DVP == 1U)
     int     OV5640_EnableDVPMode(OV5640_Object_t *pObj);
+    #endif
+    #if (OV5640_CFG_MIPI == 1U)
     int32_t OV5640_EnableMIPIMode(OV5640_Object_t *pObj);
+    #endif
     int     OV5640_DisablePADOutput(OV5640_Object_t *pObj);
+    #if (OV5640_CFG_MIPI == 1U)
     int32_t OV5640_SetMIPIVirtualChannel(OV5640_Object_t *pObj, uint32_t vchannel);
+    int32_t OV5640_ComputeMIPI(const OV5640_MIPIConfig_t *pConfig, OV5640_MIPILink_t *pLink);
+    int32_t OV5640_ApplyMIPI(OV5640_Object_t *pObj, const OV5640_MIPILink_t *pLink);
+    int32_t OV5640_SetMIPIConfig(OV5640_Object_t *pObj, const OV5640_MIPIConfig_t *pConfig);
+    #endif
     int32_t OV5640_Start(OV5640_Object_t *pObj);
     int32_t OV5640_Stop(OV5640_Object_t *pObj);
+    int32_t OV5640_Suspend(OV5640_Object_t *pObj);
+    int32_t OV5640_Resume(OV5640_Object_t *pObj, uint32_t *pFlags);
 
     int32_t OV5640_OutSize_Set(OV5640_Object_t *pObj, uint16_t offx, uint16_t offy, uint16_t width, uint16_t height);
     int32_t OV5640_ImageWin_Set(OV5640_Object_t *pObj, uint16_t offx, uint16_t offy, uint16_t width, uint16_t height);
+    #if (OV5640_CFG_JPEG == 1U)
     int32_t OV5640_JPEG_Mode(OV5640_Object_t *pObj);
+    #endif
     int32_t OV5640_RGB565_Mode(OV5640_Object_t *pObj);
+    #if (OV5640_CFG_JPEG == 1U)
+    int32_t OV5640_JPEG_SetQScale(OV5640_Object_t *pObj, uint8_t QScale);
+    int32_t OV5640_JPEG_StartRateControl(OV5640_Object_t *pObj, uint32_t TargetSize, uint8_t MinQScale,
+                                         uint8_t MaxQScale);
+    int32_t OV5640_JPEG_ReportFrame(OV5640_Object_t *pObj, uint32_t FrameSize);
+    #endif
+    int32_t OV5640_SetManualExposure(OV5640_Object_t *pObj, uint32_t Enable);
+    int32_t OV5640_SetExposureGain(OV5640_Object_t *pObj, uint32_t Exposure, uint16_t Gain);
+    int32_t OV5640_GetExposureGain(OV5640_Object_t *pObj, uint32_t *pExposure, uint16_t *pGain);
+    int32_t OV5640_SetAECWindow(OV5640_Object_t *pObj, uint16_t X, uint16_t Y, uint16_t Width, uint16_t Height);
+    int32_t OV5640_GetSensorStats(OV5640_Object_t *pObj, uint32_t Blocks, OV5640_SensorStats_t *pStats);
     int32_t OV5640_Init_General_Mode(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat);
+    int32_t OV5640_Init_General_Config(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat);
+    int32_t OV5640_Init_General_Common(OV5640_Object_t *pObj);
+    int32_t OV5640_Init_General_Format(OV5640_Object_t *pObj, uint32_t Resolution, uint32_t PixelFormat);
     int32_t OV5640_Set_Solution_More(OV5640_Object_t *pObj, uint32_t solution);
+    int32_t OV5640_BuildModeProfile(OV5640_ModeProfile_t *pProfile, uint32_t Resolution, uint32_t PixelFormat,
+                                    uint32_t PixelClock);
+    int32_t OV5640_GetModeProfileDelta(const OV5640_ModeProfile_t *pFrom, const OV5640_ModeProfile_t *pTo,
+                                       OV5640_RegVal_t *pDelta, uint32_t *pSize);
+    int32_t OV5640_SwitchModeProfile(OV5640_Object_t *pObj, const OV5640_ModeProfile_t *pProfile);
+    int32_t OV5640_BuildPowerProfiles(OV5640_PowerProfiles_t *pProfiles, const OV5640_PowerConfig_t *pConfig);
+    int32_t OV5640_SetPowerProfile(OV5640_Object_t *pObj, OV5640_PowerProfiles_t *pProfiles, uint32_t Profile);
+    int32_t OV5640_ComputeOutputMode(uint16_t Width, uint16_t Height, uint32_t FrameRate, OV5640_OutputMode_t *pMode);
+    int32_t OV5640_ApplyOutputMode(OV5640_Object_t *pObj, const OV5640_OutputMode_t *pMode);
+    int32_t OV5640_SetOutputMode(OV5640_Object_t *pObj, uint16_t Width, uint16_t Height, uint32_t FrameRate);
+    int32_t OV5640_SolvePLL(uint32_t XClk, uint16_t Width, uint16_t Height, uint32_t BytesPerPixel, uint32_t FrameRate,
+                            uint32_t MaxPClk, OV5640_OutputMode_t *pMode);
+    int32_t OV5640_SetPLL(OV5640_Object_t *pObj, const OV5640_PLL_t *pPll);
+    int32_t OV5640_ComputeROIMode(const OV5640_ROI_t *pROI, OV5640_OutputMode_t *pMode);
+    int32_t OV5640_SetROIMode(OV5640_Object_t *pObj, const OV5640_ROI_t *pROI, OV5640_OutputMode_t *pMode);
+    int32_t OV5640_WriteTable(OV5640_Object_t *pObj, const OV5640_RegVal_t *pTable, uint32_t Size);
+    int32_t OV5640_InvalidateRegCache(OV5640_Object_t *pObj);
+    #if (OV5640_USE_ASYNC_IO == 1U)
+    int32_t OV5640_SubmitTable(OV5640_Object_t *pObj, const OV5640_RegVal_t *pTable, uint32_t Size,
+                               OV5640_XferCplt_Func Callback, void *pArg);
+    int32_t OV5640_SubmitWrite(OV5640_Object_t *pObj, uint16_t Reg, const uint8_t *pData, uint32_t Length,
+                               OV5640_XferCplt_Func Callback, void *pArg);
+    int32_t OV5640_SubmitRead(OV5640_Object_t *pObj, uint16_t Reg, uint8_t *pData, uint32_t Length,
+                              OV5640_XferCplt_Func Callback, void *pArg);
+    void    OV5640_AsyncCpltCallback(OV5640_Object_t *pObj, int32_t Status);
+    uint8_t OV5640_AsyncIsBusy(OV5640_Object_t *pObj);
+    #endif
+    int32_t OV5640_SetBurstSize(OV5640_Object_t *pObj, uint16_t BurstSize);
+    #if (OV5640_USE_STATS == 1U)
+    uint8_t OV5640_SetStatsSite(OV5640_Object_t *pObj, uint8_t Site);
+    int32_t OV5640_GetStats(OV5640_Object_t *pObj, uint8_t Site, OV5640_StatsCounter_t *pCounter);
+    int32_t OV5640_ResetStats(OV5640_Object_t *pObj);
+    #endif
+    #if (OV5640_CFG_AF == 1U)
     int32_t OV5640_Focus_Init(OV5640_Object_t *pObj);
+    int32_t OV5640_Focus_Upload(OV5640_Object_t *pObj);
+    int32_t OV5640_Focus_Download(OV5640_Object_t *pObj);
+    int32_t OV5640_Focus_Release(OV5640_Object_t *pObj);
+    int32_t OV5640_Focus_Ready(OV5640_Object_t *pObj, uint8_t *pReady);
+    int32_t OV5640_Focus_Verify(OV5640_Object_t *pObj, uint32_t Mode, uint8_t *pMatch);
     int32_t OV5640_Focus_Single(OV5640_Object_t *pObj);
     int32_t OV5640_Focus_Constant(OV5640_Object_t *pObj);
 
@@ -270,15 +836,38 @@ extern "C"
     int32_t OV5640_Focus_Send_Constant_Focus(OV5640_Object_t *pObj);
     uint8_t OV5640_Focus_Read_Constant(OV5640_Object_t *pObj);
 
-    void    OV5640_Color_Saturation(OV5640_Object_t *pObj, uint8_t sat);
-    void    OV5640_Contrast(OV5640_Object_t *pObj, uint8_t contrast);
-    void    OV5640_Sharpness(OV5640_Object_t *pObj, uint8_t sharp);
-    void    OV5640_StartGroup(OV5640_Object_t *pObj);
-    void    OV5640_UseGroup(OV5640_Object_t *pObj);
+    int32_t OV5640_AF_Start(OV5640_Object_t *pObj, uint32_t Mode, uint32_t Timeout, OV5640_XferCplt_Func Callback,
+                            void *pArg);
+    int32_t OV5640_AF_Process(OV5640_Object_t *pObj);
+    int32_t OV5640_AF_Abort(OV5640_Object_t *pObj);
+    uint8_t OV5640_AF_GetState(OV5640_Object_t *pObj);
+    #endif
+
+    int32_t OV5640_Color_Saturation(OV5640_Object_t *pObj, uint8_t sat);
+    int32_t OV5640_Contrast(OV5640_Object_t *pObj, uint8_t contrast);
+    int32_t OV5640_Sharpness(OV5640_Object_t *pObj, uint8_t sharp);
+    int32_t OV5640_StartGroup(OV5640_Object_t *pObj);
+    int32_t OV5640_UseGroup(OV5640_Object_t *pObj);
+    int32_t OV5640_BeginBatch(OV5640_Object_t *pObj, uint8_t Bank);
+    int32_t OV5640_CommitBatch(OV5640_Object_t *pObj, uint32_t Launch);
+    int32_t OV5640_LaunchBatch(OV5640_Object_t *pObj, uint8_t Bank, uint32_t Launch);
+    #if (OV5640_USE_DEFERRED == 1U)
+    int32_t OV5640_BeginDeferred(OV5640_Object_t *pObj);
+    int32_t OV5640_EndDeferred(OV5640_Object_t *pObj);
+    int32_t OV5640_FlushDeferred(OV5640_Object_t *pObj);
+    #endif
 
     /* CAMERA driver structure */
     extern OV5640_CAMERA_Drv_t OV5640_CAMERA_Driver;
     extern uint16_t            solution_table[][2];
+    #if (OV5640_CFG_FIXED_INIT == 1U)
+    /* Generated by OV5640_SIM_GenerateInit, provided by the application */
+    extern const OV5640_RegVal_t OV5640_FixedInit[];
+    extern const uint32_t        OV5640_FixedInitSize;
+    extern const uint32_t        OV5640_FixedInitResolution;
+    extern const uint32_t        OV5640_FixedInitFormat;
+    extern const uint32_t        OV5640_FixedInitMode;
+    #endif
     /**
      * @}
      */
@@ -0,0 +1,544 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_capture.c
+ * @brief   Capture pipeline around OV5640_Start and OV5640_Stop.
+ *          A pool of frame buffers is filled one after the other by the
+ *          camera interface DMA (Arm hook). At each frame event,
+ *          OV5640_CAP_FrameDone queues the filled buffer and arms the next
+ *          free one; consumers take the frames by reference with
+ *          OV5640_CAP_Get and give them back with OV5640_CAP_Release, no
+ *          pixel is copied. When the consumers fall behind, frames are
+ *          dropped according to the policy and the capture never stalls.
+ *          In JPEG, where the frame size is only known at EOI, the stream
+ *          can instead be delivered chunk by chunk as the DMA fills the
+ *          halves of a circular buffer, with the frame boundaries found by
+ *          scanning each chunk for the SOI and EOI markers.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ov5640_capture.h"
+#include <string.h>
+
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @addtogroup Components
+ * @{
+ */
+
+/** @addtogroup OV5640_CAPTURE
+ * @brief     This file provides a zero-copy frame buffer pipeline.
+ * @{
+ */
+
+/** @defgroup OV5640_CAPTURE_Private_Defines
+ * @{
+ */
+#define OV5640_CAP_NONE 0xFFU
+
+/* JPEG markers, after 0xFF */
+#define OV5640_CAP_JPEG_SOI 0xD8U
+#define OV5640_CAP_JPEG_EOI 0xD9U
+#define OV5640_CAP_NOT_FOUND 0xFFFFFFFFU
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_CAPTURE_Private_Functions_Prototypes
+ * @{
+ */
+static uint32_t OV5640_CAP_TakeFree(OV5640_CAP_t *pCap);
+static uint32_t OV5640_CAP_FindMarker(const OV5640_CAP_JPEG_t *pStream, const uint8_t *pData, uint32_t From,
+                                      uint32_t Length, uint8_t Marker);
+static void     OV5640_CAP_JPEGScan(OV5640_CAP_JPEG_t *pStream, const uint8_t *pData, uint32_t Length);
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_CAPTURE_Exported_Functions
+ * @{
+ */
+
+/**
+ * @brief  Initialize a capture pipeline
+ * @param  pCap     pointer to the pipeline
+ * @param  pSensor  pointer to the sensor component object, initialized
+ * @param  pConfig  buffer pool and hooks, copied
+ * @retval Component status
+ */
+int32_t OV5640_CAP_Init(OV5640_CAP_t *pCap, OV5640_Object_t *pSensor, const OV5640_CAP_Config_t *pConfig) {
+    int32_t  ret = OV5640_OK;
+    uint32_t index;
+
+    if ((pSensor == NULL) || (pConfig == NULL) || (pConfig->pPool == NULL) || (pConfig->Arm == NULL) ||
+        (pConfig->Count < 2U) || (pConfig->Count > OV5640_CAP_MAX_BUFFERS) || (pConfig->Size == 0U) ||
+        (pConfig->Policy > OV5640_CAP_DROP_OLDEST)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pCap->pSensor = pSensor;
+        pCap->Config  = *pConfig;
+        pCap->Running = 0U;
+
+        for (index = 0; index < pConfig->Count; index++) {
+            pCap->Frame[index].pData    = &pConfig->pPool[index * pConfig->Size];
+            pCap->Frame[index].Length   = 0;
+            pCap->Frame[index].Sequence = 0;
+            pCap->Frame[index].Tick     = 0;
+            pCap->Frame[index].Index    = (uint8_t)index;
+            pCap->Frame[index].State    = OV5640_CAP_FRAME_FREE;
+        }
+
+        pCap->ReadyHead  = 0;
+        pCap->ReadyCount = 0;
+        pCap->Sequence   = 0;
+        pCap->Captured   = 0;
+        pCap->Dropped    = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Arm the first free buffer and start the sensor streaming
+ * @note   Frames still held by consumers stay theirs, the ready ones are
+ *         returned to the pool.
+ * @param  pCap  pointer to the pipeline
+ * @retval Component status
+ */
+int32_t OV5640_CAP_Start(OV5640_CAP_t *pCap) {
+    int32_t  ret = OV5640_ERROR;
+    uint32_t primask;
+    uint32_t index;
+
+    if (pCap->Running == 0U) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        for (index = 0; index < pCap->Config.Count; index++) {
+            if (pCap->Frame[index].State != OV5640_CAP_FRAME_HELD) {
+                pCap->Frame[index].State = OV5640_CAP_FRAME_FREE;
+            }
+        }
+        pCap->ReadyHead  = 0;
+        pCap->ReadyCount = 0;
+        pCap->Active     = OV5640_CAP_TakeFree(pCap);
+        __set_PRIMASK(primask);
+
+        if ((pCap->Active != OV5640_CAP_NONE) &&
+            (pCap->Config.Arm(pCap->Config.pArg, pCap->Frame[pCap->Active].pData, pCap->Config.Size) == 0)) {
+            pCap->Running = 1U;
+            ret           = OV5640_Start(pCap->pSensor);
+            if (ret != OV5640_OK) {
+                pCap->Running = 0U;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Stop the sensor streaming
+ * @note   The ready frames can still be taken with OV5640_CAP_Get. The
+ *         camera interface must be stopped by the application.
+ * @param  pCap  pointer to the pipeline
+ * @retval Component status
+ */
+int32_t OV5640_CAP_Stop(OV5640_CAP_t *pCap) {
+    uint32_t primask;
+
+    primask       = __get_PRIMASK();
+    __disable_irq();
+    if ((pCap->Running != 0U) && (pCap->Frame[pCap->Active].State == OV5640_CAP_FRAME_FILLING)) {
+        pCap->Frame[pCap->Active].State = OV5640_CAP_FRAME_FREE;
+    }
+    pCap->Running = 0U;
+    __set_PRIMASK(primask);
+
+    return OV5640_Stop(pCap->pSensor);
+}
+
+/**
+ * @brief  End of frame event, to call from the camera interface interrupt
+ * @note   For instance from HAL_DCMI_FrameEventCallback. The filled buffer
+ *         is queued for the consumers and the next one armed. Without free
+ *         buffer, OV5640_CAP_DROP_OLDEST recycles the oldest frame no
+ *         consumer took yet, otherwise (or when all the frames are held)
+ *         the new frame is discarded and its buffer armed again.
+ * @param  pCap    pointer to the pipeline
+ * @param  Length  bytes captured, 0 for a full buffer
+ * @retval Component status
+ */
+int32_t OV5640_CAP_FrameDone(OV5640_CAP_t *pCap, uint32_t Length) {
+    int32_t             ret    = OV5640_OK;
+    OV5640_CAP_Frame_t *pReady = NULL;
+    OV5640_CAP_Frame_t *pFrame;
+    uint32_t            primask;
+    uint32_t            next;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (pCap->Running == 0U) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pFrame = &pCap->Frame[pCap->Active];
+        next   = OV5640_CAP_TakeFree(pCap);
+
+        if ((next == OV5640_CAP_NONE) && (pCap->Config.Policy == OV5640_CAP_DROP_OLDEST) && (pCap->ReadyCount > 0U)) {
+            next       = pCap->Ready[pCap->ReadyHead];
+            pCap->ReadyHead = (pCap->ReadyHead + 1U) % OV5640_CAP_MAX_BUFFERS;
+            pCap->ReadyCount--;
+            pCap->Frame[next].State = OV5640_CAP_FRAME_FILLING;
+            pCap->Dropped++;
+        }
+
+        if (next == OV5640_CAP_NONE) {
+            next = pCap->Active;
+            pCap->Dropped++;
+        }
+        else {
+            pFrame->Length   = ((Length == 0U) || (Length > pCap->Config.Size)) ? pCap->Config.Size : Length;
+            pFrame->Sequence = pCap->Sequence;
+            pFrame->Tick     = (pCap->pSensor->IO.GetTick != NULL) ? (uint32_t)pCap->pSensor->IO.GetTick() : 0U;
+            pFrame->State    = OV5640_CAP_FRAME_READY;
+            pCap->Ready[(pCap->ReadyHead + pCap->ReadyCount) % OV5640_CAP_MAX_BUFFERS] = pFrame->Index;
+            pCap->ReadyCount++;
+            pCap->Captured++;
+            pReady = pFrame;
+        }
+        pCap->Sequence++;
+        pCap->Active = next;
+    }
+    __set_PRIMASK(primask);
+
+    if (ret == OV5640_OK) {
+        if (pCap->Config.Arm(pCap->Config.pArg, pCap->Frame[next].pData, pCap->Config.Size) != 0) {
+            ret = OV5640_ERROR;
+        }
+
+        if ((pReady != NULL) && (pCap->Config.Notify != NULL)) {
+            pCap->Config.Notify(pCap->Config.pArg, pReady);
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Take the oldest ready frame
+ * @note   The frame belongs to the caller until OV5640_CAP_Release.
+ * @param  pCap     pointer to the pipeline
+ * @param  ppFrame  ready frame, NULL when none
+ * @retval OV5640_OK, OV5640_ERROR when no frame is ready
+ */
+int32_t OV5640_CAP_Get(OV5640_CAP_t *pCap, OV5640_CAP_Frame_t **ppFrame) {
+    int32_t  ret = OV5640_ERROR;
+    uint32_t primask;
+
+    *ppFrame = NULL;
+
+    primask  = __get_PRIMASK();
+    __disable_irq();
+    if (pCap->ReadyCount > 0U) {
+        *ppFrame        = &pCap->Frame[pCap->Ready[pCap->ReadyHead]];
+        pCap->ReadyHead = (pCap->ReadyHead + 1U) % OV5640_CAP_MAX_BUFFERS;
+        pCap->ReadyCount--;
+        (*ppFrame)->State = OV5640_CAP_FRAME_HELD;
+        ret               = OV5640_OK;
+    }
+    __set_PRIMASK(primask);
+
+    return ret;
+}
+
+/**
+ * @brief  Give a frame taken with OV5640_CAP_Get back to the pool
+ * @param  pCap    pointer to the pipeline
+ * @param  pFrame  frame to release
+ * @retval Component status
+ */
+int32_t OV5640_CAP_Release(OV5640_CAP_t *pCap, const OV5640_CAP_Frame_t *pFrame) {
+    int32_t  ret = OV5640_ERROR;
+    uint32_t primask;
+
+    if ((pFrame != NULL) && (pFrame->Index < pCap->Config.Count) && (pFrame == &pCap->Frame[pFrame->Index])) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (pCap->Frame[pFrame->Index].State == OV5640_CAP_FRAME_HELD) {
+            pCap->Frame[pFrame->Index].State = OV5640_CAP_FRAME_FREE;
+            ret                              = OV5640_OK;
+        }
+        __set_PRIMASK(primask);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Initialize a JPEG stream
+ * @note   The sensor must be in JPEG, see OV5640_JPEG_Mode or
+ *         OV5640_SetPixelFormat with OV5640_JPEG, and the camera interface
+ *         DMA set in circular mode over pRing with a half transfer
+ *         interrupt, e.g. HAL_DCMI_Start_DMA in continuous mode.
+ * @param  pStream    pointer to the stream
+ * @param  pSensor    pointer to the sensor component object, initialized
+ * @param  pRing      DMA buffer of 2 x ChunkSize bytes
+ * @param  ChunkSize  bytes per half transfer, sets the delivery latency
+ * @param  Chunk      hook receiving the frames chunk by chunk
+ * @param  pArg       argument of the hook
+ * @retval Component status
+ */
+int32_t OV5640_CAP_JPEGInit(OV5640_CAP_JPEG_t *pStream, OV5640_Object_t *pSensor, uint8_t *pRing, uint32_t ChunkSize,
+                            OV5640_CAP_Chunk_Func Chunk, void *pArg) {
+    int32_t ret = OV5640_OK;
+
+    if ((pSensor == NULL) || (pRing == NULL) || (ChunkSize == 0U) || (Chunk == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pStream->pSensor   = pSensor;
+        pStream->pRing     = pRing;
+        pStream->ChunkSize = ChunkSize;
+        pStream->Chunk     = Chunk;
+        pStream->pArg      = pArg;
+        pStream->LastSize  = 0;
+        pStream->Frames    = 0;
+        pStream->Aborted   = 0;
+        pStream->Running   = 0U;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Start the sensor streaming, the first chunk is the first half
+ * @note   The camera interface DMA must be started before.
+ * @param  pStream  pointer to the stream
+ * @retval Component status
+ */
+int32_t OV5640_CAP_JPEGStart(OV5640_CAP_JPEG_t *pStream) {
+    int32_t ret;
+
+    pStream->Half       = 0;
+    pStream->FrameBytes = 0;
+    pStream->InFrame    = 0U;
+    pStream->PrevFF     = 0U;
+    pStream->Running    = 1U;
+
+    ret                 = OV5640_Start(pStream->pSensor);
+    if (ret != OV5640_OK) {
+        pStream->Running = 0U;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Stop the sensor streaming
+ * @note   A frame in progress is reported with OV5640_CAP_CHUNK_ABORT.
+ * @param  pStream  pointer to the stream
+ * @retval Component status
+ */
+int32_t OV5640_CAP_JPEGStop(OV5640_CAP_JPEG_t *pStream) {
+    uint32_t primask;
+    uint8_t  abort;
+
+    primask          = __get_PRIMASK();
+    __disable_irq();
+    abort            = pStream->InFrame;
+    pStream->InFrame = 0U;
+    pStream->Running = 0U;
+    __set_PRIMASK(primask);
+
+    if (abort != 0U) {
+        pStream->Aborted++;
+        pStream->Chunk(pStream->pArg, NULL, 0, OV5640_CAP_CHUNK_ABORT);
+    }
+
+    return OV5640_Stop(pStream->pSensor);
+}
+
+/**
+ * @brief  DMA half or full transfer event, to call from its interrupt
+ * @note   For instance from the DMA XferHalfCpltCallback (Half 0) and
+ *         XferCpltCallback (Half 1). The bytes of the chunk belonging to a
+ *         frame are passed to the Chunk hook, which must be done with them
+ *         before the DMA comes back to this half. When a half is missed the
+ *         frame in progress is aborted and the stream sync again on the
+ *         next SOI. The size of each complete frame is kept in LastSize,
+ *         e.g. for OV5640_JPEG_ReportFrame from the consumer task.
+ * @param  pStream  pointer to the stream
+ * @param  Half     0 for the first half of pRing, 1 for the second one
+ * @retval Component status
+ */
+int32_t OV5640_CAP_JPEGHalfDone(OV5640_CAP_JPEG_t *pStream, uint32_t Half) {
+    int32_t ret = OV5640_OK;
+
+    if ((pStream->Running == 0U) || (Half > 1U)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        if (Half != pStream->Half) {
+            if (pStream->InFrame != 0U) {
+                pStream->Aborted++;
+                pStream->Chunk(pStream->pArg, NULL, 0, OV5640_CAP_CHUNK_ABORT);
+            }
+            pStream->InFrame = 0U;
+            pStream->PrevFF  = 0U;
+            ret              = OV5640_ERROR;
+        }
+
+        OV5640_CAP_JPEGScan(pStream, &pStream->pRing[Half * pStream->ChunkSize], pStream->ChunkSize);
+        pStream->Half = Half ^ 1U;
+    }
+
+    return ret;
+}
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_CAPTURE_Private_Functions
+ * @{
+ */
+
+/**
+ * @brief  Take a free buffer of the pool, interrupts disabled
+ * @param  pCap  pointer to the pipeline
+ * @retval Index of the buffer, now filling, OV5640_CAP_NONE when none
+ */
+static uint32_t OV5640_CAP_TakeFree(OV5640_CAP_t *pCap) {
+    uint32_t index;
+    uint32_t ret = OV5640_CAP_NONE;
+
+    for (index = 0; (index < pCap->Config.Count) && (ret == OV5640_CAP_NONE); index++) {
+        if (pCap->Frame[index].State == OV5640_CAP_FRAME_FREE) {
+            pCap->Frame[index].State = OV5640_CAP_FRAME_FILLING;
+            ret                      = index;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Find a JPEG marker in a chunk
+ * @note   0xFF is byte-stuffed in the entropy coded data, so 0xFF followed
+ *         by the marker code only appears at the real markers. memchr skips
+ *         the bytes other than 0xFF a word at a time.
+ * @param  pStream  pointer to the stream, for a 0xFF ending the last chunk
+ * @param  pData    chunk
+ * @param  From     first byte to look at
+ * @param  Length   chunk length
+ * @param  Marker   marker code, OV5640_CAP_JPEG_SOI or OV5640_CAP_JPEG_EOI
+ * @retval Offset following the marker, OV5640_CAP_NOT_FOUND when absent
+ */
+static uint32_t OV5640_CAP_FindMarker(const OV5640_CAP_JPEG_t *pStream, const uint8_t *pData, uint32_t From,
+                                      uint32_t Length, uint8_t Marker) {
+    uint32_t       ret = OV5640_CAP_NOT_FOUND;
+    const uint8_t *pFF;
+
+    if ((From == 0U) && (pStream->PrevFF != 0U) && (Length > 0U) && (pData[0] == Marker)) {
+        ret = 1U;
+    }
+
+    while ((ret == OV5640_CAP_NOT_FOUND) && (From < Length)) {
+        pFF = (const uint8_t *)memchr(&pData[From], 0xFF, Length - From);
+        if (pFF == NULL) {
+            From = Length;
+        }
+        else {
+            From = (uint32_t)(pFF - pData) + 1U;
+            if ((From < Length) && (pData[From] == Marker)) {
+                ret = From + 1U;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Deliver the frame bytes of a chunk
+ * @param  pStream  pointer to the stream
+ * @param  pData    chunk
+ * @param  Length   chunk length
+ */
+static void OV5640_CAP_JPEGScan(OV5640_CAP_JPEG_t *pStream, const uint8_t *pData, uint32_t Length) {
+    static const uint8_t marker = 0xFFU;
+    uint32_t             pos    = 0;
+    uint32_t             begin;
+    uint32_t             end;
+    uint32_t             flags;
+
+    while (pos < Length) {
+        flags = 0;
+        begin = pos;
+
+        if (pStream->InFrame == 0U) {
+            end = OV5640_CAP_FindMarker(pStream, pData, pos, Length, OV5640_CAP_JPEG_SOI);
+            if (end == OV5640_CAP_NOT_FOUND) {
+                break;
+            }
+
+            pStream->InFrame    = 1U;
+            pStream->FrameBytes = 0;
+            if (end == 1U) {
+                /* SOI split over two chunks, its 0xFF is already overwritten */
+                pStream->Chunk(pStream->pArg, &marker, 1, OV5640_CAP_CHUNK_START);
+                pStream->FrameBytes = 1;
+                begin               = 0;
+            }
+            else {
+                flags = OV5640_CAP_CHUNK_START;
+                begin = end - 2U;
+            }
+            pos = end;
+        }
+
+        end = OV5640_CAP_FindMarker(pStream, pData, pos, Length, OV5640_CAP_JPEG_EOI);
+        if (end == OV5640_CAP_NOT_FOUND) {
+            end = Length;
+        }
+        else {
+            flags |= OV5640_CAP_CHUNK_END;
+        }
+
+        pStream->FrameBytes += end - begin;
+        pStream->Chunk(pStream->pArg, &pData[begin], end - begin, flags);
+
+        if ((flags & OV5640_CAP_CHUNK_END) != 0U) {
+            pStream->LastSize = pStream->FrameBytes;
+            pStream->Frames++;
+            pStream->InFrame = 0U;
+        }
+        pos = end;
+    }
+
+    pStream->PrevFF = ((Length > 0U) && (pData[Length - 1U] == 0xFFU)) ? 1U : 0U;
+}
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
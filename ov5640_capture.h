@@ -0,0 +1,176 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_capture.h
+ * @brief   Header of ov5640_capture.c: pool of frame buffers filled by the
+ *          camera interface and handed to the consumers by reference, and
+ *          JPEG streaming in chunks.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OV5640_CAPTURE_H
+    #define OV5640_CAPTURE_H
+
+    #ifdef __cplusplus
+extern "C"
+{
+    #endif
+
+    /* Includes ------------------------------------------------------------------*/
+    #include "ov5640.h"
+
+    /** @addtogroup BSP
+     * @{
+     */
+
+    /** @addtogroup Components
+     * @{
+     */
+
+    /** @addtogroup OV5640_CAPTURE
+     * @{
+     */
+
+    /** @defgroup OV5640_CAPTURE_Exported_Types
+     * @{
+     */
+
+    #ifndef OV5640_CAP_MAX_BUFFERS
+        #define OV5640_CAP_MAX_BUFFERS 4U
+    #endif
+
+    /* Frame buffer of the pool */
+    typedef struct
+    {
+        uint8_t *pData;    /*!< Buffer, Size bytes                              */
+        uint32_t Length;   /*!< Bytes captured, e.g. the JPEG size              */
+        uint32_t Sequence; /*!< Frame number, gaps show the dropped frames      */
+        uint32_t Tick;     /*!< Sensor IO GetTick at the end of the frame       */
+        uint8_t  Index;    /*!< Position in the pool                            */
+        uint8_t  State;    /*!< OV5640_CAP_FRAME_xxx                            */
+    } OV5640_CAP_Frame_t;
+
+    /* Point the camera interface DMA to the next buffer, e.g. with
+       HAL_DCMI_Start_DMA in snapshot mode, 0 on success. Called from the
+       frame event interrupt. */
+    typedef int32_t (*OV5640_CAP_Arm_Func)(void *pArg, uint8_t *pBuffer, uint32_t Size);
+
+    /* Tell the consumers a frame is ready, e.g. give a semaphore or post to
+       the queue the consumer task waits on. Called from the frame event
+       interrupt. */
+    typedef void (*OV5640_CAP_Notify_Func)(void *pArg, const OV5640_CAP_Frame_t *pFrame);
+
+    typedef struct
+    {
+        uint8_t               *pPool;  /*!< Count buffers of Size bytes, DMA capable */
+        uint32_t               Count;  /*!< 2 to OV5640_CAP_MAX_BUFFERS               */
+        uint32_t               Size;   /*!< Bytes per buffer                          */
+        uint32_t               Policy; /*!< OV5640_CAP_DROP_xxx                       */
+        OV5640_CAP_Arm_Func    Arm;    /*!< Mandatory                                 */
+        OV5640_CAP_Notify_Func Notify; /*!< Can be NULL, consumers then poll          */
+        void                  *pArg;   /*!< Argument of the hooks                     */
+    } OV5640_CAP_Config_t;
+
+    typedef struct
+    {
+        OV5640_Object_t    *pSensor;
+        OV5640_CAP_Config_t Config;
+        OV5640_CAP_Frame_t  Frame[OV5640_CAP_MAX_BUFFERS];
+        uint8_t             Ready[OV5640_CAP_MAX_BUFFERS]; /*!< Filled frames, oldest first */
+        uint32_t            ReadyHead;
+        uint32_t            ReadyCount;
+        uint32_t            Active;   /*!< Frame being filled                 */
+        uint32_t            Sequence; /*!< Sequence of the next frame         */
+        uint32_t            Captured; /*!< Frames handed to the consumers     */
+        uint32_t            Dropped;  /*!< Frames overwritten or discarded    */
+        uint8_t             Running;
+    } OV5640_CAP_t;
+
+    /* Part of a JPEG frame, OV5640_CAP_CHUNK_xxx Flags. Called from the DMA
+       interrupt, pData is overwritten one chunk period later. */
+    typedef void (*OV5640_CAP_Chunk_Func)(void *pArg, const uint8_t *pData, uint32_t Length, uint32_t Flags);
+
+    /* JPEG stream captured by a circular DMA over two chunks */
+    typedef struct
+    {
+        OV5640_Object_t      *pSensor;
+        uint8_t              *pRing;      /*!< 2 x ChunkSize bytes, DMA circular target */
+        uint32_t              ChunkSize;  /*!< Bytes per DMA half transfer              */
+        OV5640_CAP_Chunk_Func Chunk;      /*!< Mandatory                                */
+        void                 *pArg;       /*!< Argument of Chunk                        */
+        uint32_t              Half;       /*!< Half of pRing expected next              */
+        uint32_t              FrameBytes; /*!< Bytes delivered for the current frame    */
+        uint32_t              LastSize;   /*!< Size of the last complete frame          */
+        uint32_t              Frames;     /*!< Complete frames delivered                */
+        uint32_t              Aborted;    /*!< Frames cut by a missed half transfer     */
+        uint8_t               InFrame;    /*!< Between SOI and EOI                      */
+        uint8_t               PrevFF;     /*!< Previous chunk ended with 0xFF           */
+        uint8_t               Running;
+    } OV5640_CAP_JPEG_t;
+
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_CAPTURE_Exported_Constants
+     * @{
+     */
+    #define OV5640_CAP_FRAME_FREE    0x00U /* In the pool                      */
+    #define OV5640_CAP_FRAME_FILLING 0x01U /* Target of the camera DMA         */
+    #define OV5640_CAP_FRAME_READY   0x02U /* Filled, waiting for a consumer   */
+    #define OV5640_CAP_FRAME_HELD    0x03U /* Owned by a consumer until Release */
+
+    /* When no buffer is free at the end of a frame */
+    #define OV5640_CAP_DROP_NEWEST 0x00U /* Capture again in the same buffer    */
+    #define OV5640_CAP_DROP_OLDEST 0x01U /* Recycle the oldest unclaimed frame  */
+
+    /* Flags of the JPEG chunks */
+    #define OV5640_CAP_CHUNK_START 0x01U /* First chunk of a frame, from SOI    */
+    #define OV5640_CAP_CHUNK_END   0x02U /* Last chunk of a frame, up to EOI    */
+    #define OV5640_CAP_CHUNK_ABORT 0x04U /* Frame lost, discard its chunks      */
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_CAPTURE_Exported_Functions
+     * @{
+     */
+    int32_t OV5640_CAP_Init(OV5640_CAP_t *pCap, OV5640_Object_t *pSensor, const OV5640_CAP_Config_t *pConfig);
+    int32_t OV5640_CAP_Start(OV5640_CAP_t *pCap);
+    int32_t OV5640_CAP_Stop(OV5640_CAP_t *pCap);
+    int32_t OV5640_CAP_FrameDone(OV5640_CAP_t *pCap, uint32_t Length);
+    int32_t OV5640_CAP_Get(OV5640_CAP_t *pCap, OV5640_CAP_Frame_t **ppFrame);
+    int32_t OV5640_CAP_Release(OV5640_CAP_t *pCap, const OV5640_CAP_Frame_t *pFrame);
+    int32_t OV5640_CAP_JPEGInit(OV5640_CAP_JPEG_t *pStream, OV5640_Object_t *pSensor, uint8_t *pRing, uint32_t ChunkSize,
+                                OV5640_CAP_Chunk_Func Chunk, void *pArg);
+    int32_t OV5640_CAP_JPEGStart(OV5640_CAP_JPEG_t *pStream);
+    int32_t OV5640_CAP_JPEGStop(OV5640_CAP_JPEG_t *pStream);
+    int32_t OV5640_CAP_JPEGHalfDone(OV5640_CAP_JPEG_t *pStream, uint32_t Half);
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    #ifdef __cplusplus
+}
+    #endif
+
+#endif /* OV5640_CAPTURE_H */
@@ -0,0 +1,569 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_frame.c
+ * @brief   Post-processing of the OV5640 frames: YUV422 (YUYV) to Y8 and to
+ *          RGB565, RGB565 byte order swap, and 2x/4x box downscale of Y8
+ *          and RGB565 frames.
+ *          Helium and NEON (or SSE2 on a host) kernels process 16 pixels at
+ *          a time, the Cortex-M DSP and portable code 2 or 4 pixels per
+ *          32-bit word. All the paths give the same output bit for bit.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ov5640_frame.h"
+#include <string.h>
+
+#if (OV5640_FRAME_NO_SIMD == 1U)
+/* Portable code only */
+#elif defined(__ARM_FEATURE_MVE) && ((__ARM_FEATURE_MVE & 1) != 0)
+    #include <arm_mve.h>
+    #define OV5640_FRAME_VECTOR 1U
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define OV5640_FRAME_VECTOR 1U
+    #define OV5640_FRAME_NEON   1U
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define OV5640_FRAME_SSE2 1U
+#endif
+
+#if (OV5640_FRAME_NO_SIMD != 1U) && !defined(OV5640_HOST_BUILD) && defined(__ARM_FEATURE_DSP) && \
+    (__ARM_FEATURE_DSP == 1)
+    /* __REV16 and __UXTB16 from cmsis_compiler.h */
+    #define OV5640_FRAME_DSP 1U
+#endif
+
+#ifndef OV5640_FRAME_VECTOR
+    #define OV5640_FRAME_VECTOR 0U
+#endif
+#ifndef OV5640_FRAME_NEON
+    #define OV5640_FRAME_NEON 0U
+#endif
+#ifndef OV5640_FRAME_SSE2
+    #define OV5640_FRAME_SSE2 0U
+#endif
+#ifndef OV5640_FRAME_DSP
+    #define OV5640_FRAME_DSP 0U
+#endif
+
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @addtogroup Components
+ * @{
+ */
+
+/** @addtogroup OV5640_FRAME
+ * @brief     This file provides conversions of the captured OV5640 frames.
+ * @{
+ */
+
+/** @defgroup OV5640_FRAME_Private_Defines
+ * @{
+ */
+/* YUV to RGB, full range BT.601 in Q6: R = Y + 1.402 V, G = Y - 0.344 U - 0.714 V,
+   B = Y + 1.772 U. Every intermediate fits in 16 bits for the vector kernels. */
+#define OV5640_FRAME_Q          6U
+#define OV5640_FRAME_Q_HALF     32
+#define OV5640_FRAME_Q_MAX      0x3FFF /* 255.98 in Q6 */
+#define OV5640_FRAME_K_RV       90
+#define OV5640_FRAME_K_GU       22
+#define OV5640_FRAME_K_GV       46
+#define OV5640_FRAME_K_BU       113
+
+/* RGB565 spread over 32 bits, G in the upper half, with room for the sums of
+   16 pixels above each channel */
+#define OV5640_FRAME_565_SPREAD 0x07E0F81FU
+#define OV5640_FRAME_565_HALF_4 0x00401002U /* 2 in the LSB of each channel */
+#define OV5640_FRAME_565_HALF_16 0x01004008U /* 8 in the LSB of each channel */
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_FRAME_Private_Functions_Prototypes
+ * @{
+ */
+static uint32_t OV5640_FRAME_Load32(const void *pSrc);
+static void     OV5640_FRAME_Store32(void *pDst, uint32_t Value);
+static uint32_t OV5640_FRAME_Rev16(uint32_t Value);
+static uint32_t OV5640_FRAME_Even8(uint32_t Value);
+static uint32_t OV5640_FRAME_Avg8(uint32_t A, uint32_t B);
+static uint8_t  OV5640_FRAME_Clamp(int32_t Value);
+static uint32_t OV5640_FRAME_Spread565(uint16_t Pixel);
+static void     OV5640_FRAME_RowY8x2(const uint8_t *pSrc, uint32_t Width, uint8_t *pDst);
+static void     OV5640_FRAME_RowY8x4(const uint8_t *pSrc, uint32_t Width, uint8_t *pDst);
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_FRAME_Exported_Functions
+ * @{
+ */
+
+/**
+ * @brief  Swap the bytes of RGB565 pixels
+ * @note   The sensor sends the high byte first, which the DCMI/DMA stores at
+ *         the lower address: the swap gives pixels in CPU order for the
+ *         display controller and DownscaleRGB565. pDst can be pSrc.
+ * @param  pSrc   captured pixels
+ * @param  pDst   swapped pixels
+ * @param  Count  number of pixels
+ * @retval Component status
+ */
+int32_t OV5640_FRAME_SwapRGB565(const uint16_t *pSrc, uint16_t *pDst, uint32_t Count) {
+    int32_t  ret = OV5640_OK;
+    uint32_t i   = 0;
+
+    if ((pSrc == NULL) || (pDst == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+#if (OV5640_FRAME_VECTOR == 1U)
+        for (; (i + 8U) <= Count; i += 8U) {
+            vst1q_u8((uint8_t *)&pDst[i], vrev16q_u8(vld1q_u8((const uint8_t *)&pSrc[i])));
+        }
+#elif (OV5640_FRAME_SSE2 == 1U)
+        for (; (i + 8U) <= Count; i += 8U) {
+            __m128i v = _mm_loadu_si128((const __m128i *)&pSrc[i]);
+
+            _mm_storeu_si128((__m128i *)&pDst[i], _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+        }
+#endif
+        for (; (i + 2U) <= Count; i += 2U) {
+            OV5640_FRAME_Store32(&pDst[i], OV5640_FRAME_Rev16(OV5640_FRAME_Load32(&pSrc[i])));
+        }
+
+        if (i < Count) {
+            pDst[i] = (uint16_t)((uint32_t)pSrc[i] << 8) | (uint16_t)(pSrc[i] >> 8);
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Extract the luma of a YUV422 frame
+ * @note   YUYV order, as set by OV5640_SetPixelFormat. pDst can be pSrc.
+ * @param  pSrc   YUV422 pixels, 2 bytes each
+ * @param  pDst   Y8 pixels
+ * @param  Count  number of pixels
+ * @retval Component status
+ */
+int32_t OV5640_FRAME_YUV422ToY8(const uint8_t *pSrc, uint8_t *pDst, uint32_t Count) {
+    int32_t  ret = OV5640_OK;
+    uint32_t i   = 0;
+
+    if ((pSrc == NULL) || (pDst == NULL)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+#if (OV5640_FRAME_VECTOR == 1U)
+        for (; (i + 16U) <= Count; i += 16U) {
+            vst1q_u8(&pDst[i], vld2q_u8(&pSrc[2U * i]).val[0]);
+        }
+#elif (OV5640_FRAME_SSE2 == 1U)
+        const __m128i mask = _mm_set1_epi16(0x00FF);
+
+        for (; (i + 16U) <= Count; i += 16U) {
+            __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)&pSrc[2U * i]), mask);
+            __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)&pSrc[(2U * i) + 16U]), mask);
+
+            _mm_storeu_si128((__m128i *)&pDst[i], _mm_packus_epi16(a, b));
+        }
+#endif
+        for (; (i + 4U) <= Count; i += 4U) {
+            uint32_t lo = OV5640_FRAME_Even8(OV5640_FRAME_Load32(&pSrc[2U * i]));
+            uint32_t hi = OV5640_FRAME_Even8(OV5640_FRAME_Load32(&pSrc[(2U * i) + 4U]));
+
+            OV5640_FRAME_Store32(&pDst[i], ((lo | (lo >> 8)) & 0xFFFFU) | ((hi | (hi >> 8)) << 16));
+        }
+
+        for (; i < Count; i++) {
+            pDst[i] = pSrc[2U * i];
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Convert a YUV422 frame to RGB565
+ * @note   YUYV order, full range BT.601. The RGB565 pixels are in CPU order,
+ *         pDst can be pSrc.
+ * @param  pSrc   YUV422 pixels, 2 bytes each
+ * @param  pDst   RGB565 pixels
+ * @param  Count  number of pixels, even
+ * @retval Component status
+ */
+int32_t OV5640_FRAME_YUV422ToRGB565(const uint8_t *pSrc, uint16_t *pDst, uint32_t Count) {
+    int32_t  ret = OV5640_OK;
+    uint32_t i   = 0;
+    uint32_t k;
+    int32_t  u, v, y, r, g, b;
+
+    if ((pSrc == NULL) || (pDst == NULL) || ((Count & 1U) != 0U)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+#if (OV5640_FRAME_NEON == 1U)
+        for (; (i + 16U) <= Count; i += 16U) {
+            uint8x8x4_t  s  = vld4_u8(&pSrc[2U * i]); /* Y even, U, Y odd, V */
+            int16x8_t    cu = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(s.val[1])), vdupq_n_s16(128));
+            int16x8_t    cv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(s.val[3])), vdupq_n_s16(128));
+            int16x8_t    cr = vmulq_n_s16(cv, OV5640_FRAME_K_RV);
+            int16x8_t    cg = vmlaq_n_s16(vmulq_n_s16(cu, -OV5640_FRAME_K_GU), cv, -OV5640_FRAME_K_GV);
+            int16x8_t    cb = vmulq_n_s16(cu, OV5640_FRAME_K_BU);
+            uint16x8x2_t out;
+
+            for (k = 0; k < 2U; k++) {
+                int16x8_t yq = vreinterpretq_s16_u16(vshll_n_u8(s.val[2U * k], OV5640_FRAME_Q));
+                uint16x8_t p = vshll_n_u8(vqrshrun_n_s16(vaddq_s16(yq, cr), OV5640_FRAME_Q), 8);
+
+                p = vsriq_n_u16(p, vshll_n_u8(vqrshrun_n_s16(vaddq_s16(yq, cg), OV5640_FRAME_Q), 8), 5);
+                p = vsriq_n_u16(p, vshll_n_u8(vqrshrun_n_s16(vaddq_s16(yq, cb), OV5640_FRAME_Q), 8), 11);
+                out.val[k] = p;
+            }
+            vst2q_u16(&pDst[i], out);
+        }
+#elif (OV5640_FRAME_SSE2 == 1U)
+        const __m128i lo16 = _mm_set1_epi32(0x0000FFFF);
+        const __m128i c128 = _mm_set1_epi16(128);
+        const __m128i half = _mm_set1_epi16(OV5640_FRAME_Q_HALF);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i c255 = _mm_set1_epi16(255);
+
+        for (; (i + 8U) <= Count; i += 8U) {
+            __m128i s  = _mm_loadu_si128((const __m128i *)&pSrc[2U * i]);
+            __m128i yq = _mm_add_epi16(_mm_slli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x00FF)), OV5640_FRAME_Q), half);
+            __m128i c  = _mm_srli_epi16(s, 8);                 /* U V U V ... */
+            __m128i cu = _mm_and_si128(c, lo16);
+            __m128i cv = _mm_srli_epi32(c, 16);
+            __m128i r8, g8, b8;
+
+            cu = _mm_sub_epi16(_mm_or_si128(cu, _mm_slli_epi32(cu, 16)), c128);
+            cv = _mm_sub_epi16(_mm_or_si128(cv, _mm_slli_epi32(cv, 16)), c128);
+
+            r8 = _mm_add_epi16(yq, _mm_mullo_epi16(cv, _mm_set1_epi16(OV5640_FRAME_K_RV)));
+            g8 = _mm_sub_epi16(_mm_sub_epi16(yq, _mm_mullo_epi16(cu, _mm_set1_epi16(OV5640_FRAME_K_GU))),
+                               _mm_mullo_epi16(cv, _mm_set1_epi16(OV5640_FRAME_K_GV)));
+            b8 = _mm_add_epi16(yq, _mm_mullo_epi16(cu, _mm_set1_epi16(OV5640_FRAME_K_BU)));
+
+            r8 = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(r8, OV5640_FRAME_Q), zero), c255);
+            g8 = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(g8, OV5640_FRAME_Q), zero), c255);
+            b8 = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(b8, OV5640_FRAME_Q), zero), c255);
+
+            _mm_storeu_si128((__m128i *)&pDst[i],
+                             _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_and_si128(r8, _mm_set1_epi16(0xF8)), 8),
+                                                       _mm_slli_epi16(_mm_and_si128(g8, _mm_set1_epi16(0xFC)), 3)),
+                                          _mm_srli_epi16(b8, 3)));
+        }
+#endif
+        /* One chroma sample for two pixels */
+        for (; i < Count; i += 2U) {
+            u = (int32_t)pSrc[(2U * i) + 1U] - 128;
+            v = (int32_t)pSrc[(2U * i) + 3U] - 128;
+
+            for (k = 0; k < 2U; k++) {
+                y = ((int32_t)pSrc[(2U * i) + (2U * k)] << OV5640_FRAME_Q) + OV5640_FRAME_Q_HALF;
+                r = OV5640_FRAME_Clamp(y + (OV5640_FRAME_K_RV * v));
+                g = OV5640_FRAME_Clamp(y - (OV5640_FRAME_K_GU * u) - (OV5640_FRAME_K_GV * v));
+                b = OV5640_FRAME_Clamp(y + (OV5640_FRAME_K_BU * u));
+
+                pDst[i + k] = (uint16_t)(((uint32_t)r & 0xF8U) << 8) | (uint16_t)(((uint32_t)g & 0xFCU) << 3) |
+                              (uint16_t)((uint32_t)b >> 3);
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Downscale a Y8 frame by averaging Factor x Factor pixel blocks
+ * @note   Rows and columns beyond a multiple of Factor are dropped. pDst can
+ *         be pSrc.
+ * @param  pSrc    Y8 frame, Width bytes per row
+ * @param  Width   frame width in pixels
+ * @param  Height  frame height in pixels
+ * @param  Factor  OV5640_FRAME_SCALE_2 or OV5640_FRAME_SCALE_4
+ * @param  pDst    downscaled frame, Width / Factor bytes per row
+ * @retval Component status
+ */
+int32_t OV5640_FRAME_DownscaleY8(const uint8_t *pSrc, uint32_t Width, uint32_t Height, uint32_t Factor, uint8_t *pDst) {
+    int32_t  ret = OV5640_OK;
+    uint32_t row;
+
+    if ((pSrc == NULL) || (pDst == NULL) || ((Factor != OV5640_FRAME_SCALE_2) && (Factor != OV5640_FRAME_SCALE_4))) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        for (row = 0; row < (Height / Factor); row++) {
+            if (Factor == OV5640_FRAME_SCALE_2) {
+                OV5640_FRAME_RowY8x2(&pSrc[row * Factor * Width], Width, &pDst[row * (Width / Factor)]);
+            }
+            else {
+                OV5640_FRAME_RowY8x4(&pSrc[row * Factor * Width], Width, &pDst[row * (Width / Factor)]);
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Downscale an RGB565 frame by averaging Factor x Factor pixel blocks
+ * @note   The pixels must be in CPU order, see OV5640_FRAME_SwapRGB565. Rows
+ *         and columns beyond a multiple of Factor are dropped. pDst can be
+ *         pSrc.
+ * @param  pSrc    RGB565 frame, Width pixels per row
+ * @param  Width   frame width in pixels
+ * @param  Height  frame height in pixels
+ * @param  Factor  OV5640_FRAME_SCALE_2 or OV5640_FRAME_SCALE_4
+ * @param  pDst    downscaled frame, Width / Factor pixels per row
+ * @retval Component status
+ */
+int32_t OV5640_FRAME_DownscaleRGB565(const uint16_t *pSrc, uint32_t Width, uint32_t Height, uint32_t Factor,
+                                     uint16_t *pDst) {
+    int32_t         ret = OV5640_OK;
+    uint32_t        row, x, dy, dx;
+    uint32_t        sum, round, shift;
+    const uint16_t *src;
+
+    if ((pSrc == NULL) || (pDst == NULL) || ((Factor != OV5640_FRAME_SCALE_2) && (Factor != OV5640_FRAME_SCALE_4))) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        round = (Factor == OV5640_FRAME_SCALE_2) ? OV5640_FRAME_565_HALF_4 : OV5640_FRAME_565_HALF_16;
+        shift = (Factor == OV5640_FRAME_SCALE_2) ? 2U : 4U;
+
+        for (row = 0; row < (Height / Factor); row++) {
+            for (x = 0; x < (Width / Factor); x++) {
+                /* The three channels are summed at once */
+                src = &pSrc[(row * Factor * Width) + (x * Factor)];
+                sum = round;
+                for (dy = 0; dy < Factor; dy++) {
+                    for (dx = 0; dx < Factor; dx++) {
+                        sum += OV5640_FRAME_Spread565(src[(dy * Width) + dx]);
+                    }
+                }
+                sum = (sum >> shift) & OV5640_FRAME_565_SPREAD;
+
+                pDst[(row * (Width / Factor)) + x] = (uint16_t)(sum | (sum >> 16));
+            }
+        }
+    }
+
+    return ret;
+}
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_FRAME_Private_Functions
+ * @{
+ */
+
+/**
+ * @brief  Load 32 bits from a buffer of any alignment
+ * @param  pSrc  source
+ * @retval Value in CPU order
+ */
+static uint32_t OV5640_FRAME_Load32(const void *pSrc) {
+    uint32_t value;
+
+    (void)memcpy(&value, pSrc, sizeof(value));
+
+    return value;
+}
+
+/**
+ * @brief  Store 32 bits to a buffer of any alignment
+ * @param  pDst   destination
+ * @param  Value  value in CPU order
+ */
+static void OV5640_FRAME_Store32(void *pDst, uint32_t Value) {
+    (void)memcpy(pDst, &Value, sizeof(Value));
+}
+
+/**
+ * @brief  Swap the bytes of each halfword
+ * @param  Value  two halfwords
+ * @retval Swapped halfwords
+ */
+static uint32_t OV5640_FRAME_Rev16(uint32_t Value) {
+#if (OV5640_FRAME_DSP == 1U)
+    return __REV16(Value);
+#else
+    return ((Value & 0x00FF00FFU) << 8) | ((Value >> 8) & 0x00FF00FFU);
+#endif
+}
+
+/**
+ * @brief  Zero-extend bytes 0 and 2 to halfwords
+ * @param  Value  four bytes
+ * @retval Byte 0 in bits 0-7, byte 2 in bits 16-23
+ */
+static uint32_t OV5640_FRAME_Even8(uint32_t Value) {
+#if (OV5640_FRAME_DSP == 1U)
+    return __UXTB16(Value);
+#else
+    return Value & 0x00FF00FFU;
+#endif
+}
+
+/**
+ * @brief  Rounded average of four byte pairs, (a + b + 1) / 2
+ * @param  A  four bytes
+ * @param  B  four bytes
+ * @retval Four averages
+ */
+static uint32_t OV5640_FRAME_Avg8(uint32_t A, uint32_t B) {
+    return (A | B) - (((A ^ B) & 0xFEFEFEFEU) >> 1);
+}
+
+/**
+ * @brief  Convert a Q6 channel value, rounding already added, to 8 bits
+ * @param  Value  channel in Q6
+ * @retval Channel saturated to 0-255
+ */
+static uint8_t OV5640_FRAME_Clamp(int32_t Value) {
+    uint8_t ret;
+
+    if (Value < 0) {
+        ret = 0U;
+    }
+    else if (Value > OV5640_FRAME_Q_MAX) {
+        ret = 255U;
+    }
+    else {
+        ret = (uint8_t)((uint32_t)Value >> OV5640_FRAME_Q);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Spread the channels of an RGB565 pixel for SWAR sums
+ * @param  Pixel  RGB565 pixel in CPU order
+ * @retval G in bits 21-26, R in bits 11-15, B in bits 0-4
+ */
+static uint32_t OV5640_FRAME_Spread565(uint16_t Pixel) {
+    return ((uint32_t)Pixel | ((uint32_t)Pixel << 16)) & OV5640_FRAME_565_SPREAD;
+}
+
+/**
+ * @brief  Average the 2x2 blocks of two Y8 rows into one row
+ * @note   Each block is the average of its two column averages.
+ * @param  pSrc   first row, followed by the second one
+ * @param  Width  row width in pixels
+ * @param  pDst   output row, Width / 2 pixels
+ */
+static void OV5640_FRAME_RowY8x2(const uint8_t *pSrc, uint32_t Width, uint8_t *pDst) {
+    const uint8_t *a = pSrc;
+    const uint8_t *b = &pSrc[Width];
+    uint32_t       x = 0;
+    uint32_t       v, h;
+
+#if (OV5640_FRAME_VECTOR == 1U)
+    for (; (x + 16U) <= (Width / 2U); x += 16U) {
+        uint8x16x2_t pa = vld2q_u8(&a[2U * x]);
+        uint8x16x2_t pb = vld2q_u8(&b[2U * x]);
+
+        vst1q_u8(&pDst[x], vrhaddq_u8(vrhaddq_u8(pa.val[0], pb.val[0]), vrhaddq_u8(pa.val[1], pb.val[1])));
+    }
+#elif (OV5640_FRAME_SSE2 == 1U)
+    for (; (x + 8U) <= (Width / 2U); x += 8U) {
+        __m128i c = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)&a[2U * x]),
+                                 _mm_loadu_si128((const __m128i *)&b[2U * x]));
+
+        c = _mm_avg_epu16(_mm_and_si128(c, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(c, 8));
+        _mm_storel_epi64((__m128i *)&pDst[x], _mm_packus_epi16(c, c));
+    }
+#endif
+    for (; (x + 2U) <= (Width / 2U); x += 2U) {
+        v = OV5640_FRAME_Avg8(OV5640_FRAME_Load32(&a[2U * x]), OV5640_FRAME_Load32(&b[2U * x]));
+        h = ((OV5640_FRAME_Even8(v) + OV5640_FRAME_Even8(v >> 8) + 0x00010001U) >> 1) & 0x00FF00FFU;
+
+        pDst[x]      = (uint8_t)h;
+        pDst[x + 1U] = (uint8_t)(h >> 16);
+    }
+
+    if (x < (Width / 2U)) {
+        v       = OV5640_FRAME_Avg8(a[2U * x] | ((uint32_t)a[(2U * x) + 1U] << 8),
+                                    b[2U * x] | ((uint32_t)b[(2U * x) + 1U] << 8));
+        pDst[x] = (uint8_t)(((v & 0xFFU) + (v >> 8) + 1U) >> 1);
+    }
+}
+
+/**
+ * @brief  Average the 4x4 blocks of four Y8 rows into one row
+ * @note   Rows then columns are averaged two by two, as in RowY8x2.
+ * @param  pSrc   first row, followed by the three other ones
+ * @param  Width  row width in pixels
+ * @param  pDst   output row, Width / 4 pixels
+ */
+static void OV5640_FRAME_RowY8x4(const uint8_t *pSrc, uint32_t Width, uint8_t *pDst) {
+    uint32_t x = 0;
+    uint32_t v, h;
+
+#if (OV5640_FRAME_VECTOR == 1U)
+    for (; (x + 16U) <= (Width / 4U); x += 16U) {
+        uint8x16x4_t r0 = vld4q_u8(&pSrc[4U * x]);
+        uint8x16x4_t r1 = vld4q_u8(&pSrc[Width + (4U * x)]);
+        uint8x16x4_t r2 = vld4q_u8(&pSrc[(2U * Width) + (4U * x)]);
+        uint8x16x4_t r3 = vld4q_u8(&pSrc[(3U * Width) + (4U * x)]);
+        uint8x16_t   c[4];
+        uint32_t     k;
+
+        for (k = 0; k < 4U; k++) {
+            c[k] = vrhaddq_u8(vrhaddq_u8(r0.val[k], r1.val[k]), vrhaddq_u8(r2.val[k], r3.val[k]));
+        }
+        vst1q_u8(&pDst[x], vrhaddq_u8(vrhaddq_u8(c[0], c[1]), vrhaddq_u8(c[2], c[3])));
+    }
+#elif (OV5640_FRAME_SSE2 == 1U)
+    for (; (x + 4U) <= (Width / 4U); x += 4U) {
+        __m128i c = _mm_avg_epu8(_mm_avg_epu8(_mm_loadu_si128((const __m128i *)&pSrc[4U * x]),
+                                              _mm_loadu_si128((const __m128i *)&pSrc[Width + (4U * x)])),
+                                 _mm_avg_epu8(_mm_loadu_si128((const __m128i *)&pSrc[(2U * Width) + (4U * x)]),
+                                              _mm_loadu_si128((const __m128i *)&pSrc[(3U * Width) + (4U * x)])));
+
+        c = _mm_avg_epu16(_mm_and_si128(c, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(c, 8));
+        c = _mm_avg_epu16(_mm_and_si128(c, _mm_set1_epi32(0x0000FFFF)), _mm_srli_epi32(c, 16));
+        c = _mm_packs_epi32(c, c);
+        OV5640_FRAME_Store32(&pDst[x], (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(c, c)));
+    }
+#endif
+    for (; x < (Width / 4U); x++) {
+        v = OV5640_FRAME_Avg8(OV5640_FRAME_Avg8(OV5640_FRAME_Load32(&pSrc[4U * x]),
+                                                OV5640_FRAME_Load32(&pSrc[Width + (4U * x)])),
+                              OV5640_FRAME_Avg8(OV5640_FRAME_Load32(&pSrc[(2U * Width) + (4U * x)]),
+                                                OV5640_FRAME_Load32(&pSrc[(3U * Width) + (4U * x)])));
+        h = ((OV5640_FRAME_Even8(v) + OV5640_FRAME_Even8(v >> 8) + 0x00010001U) >> 1) & 0x00FF00FFU;
+
+        pDst[x] = (uint8_t)(((h & 0xFFU) + (h >> 16) + 1U) >> 1);
+    }
+}
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
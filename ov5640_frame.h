@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_frame.h
+ * @brief   Header of ov5640_frame.c: post-processing of the frames captured
+ *          in the pixel formats configured by OV5640_SetPixelFormat.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OV5640_FRAME_H
+    #define OV5640_FRAME_H
+
+    #ifdef __cplusplus
+extern "C"
+{
+    #endif
+
+    /* Includes ------------------------------------------------------------------*/
+    #include "ov5640.h"
+
+    /** @addtogroup BSP
+     * @{
+     */
+
+    /** @addtogroup Components
+     * @{
+     */
+
+    /** @addtogroup OV5640_FRAME
+     * @{
+     */
+
+    /** @defgroup OV5640_FRAME_Exported_Constants
+     * @{
+     */
+    /* Vector kernels (Helium, NEON, SSE2, DSP SIMD32) when the compiler targets
+       them, 1 to force the portable 32-bit code */
+    #ifndef OV5640_FRAME_NO_SIMD
+        #define OV5640_FRAME_NO_SIMD 0U
+    #endif
+
+    #define OV5640_FRAME_SCALE_2 2U /* Output is Width / 2 x Height / 2 */
+    #define OV5640_FRAME_SCALE_4 4U /* Output is Width / 4 x Height / 4 */
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_FRAME_Exported_Functions
+     * @{
+     */
+    int32_t OV5640_FRAME_SwapRGB565(const uint16_t *pSrc, uint16_t *pDst, uint32_t Count);
+    int32_t OV5640_FRAME_YUV422ToY8(const uint8_t *pSrc, uint8_t *pDst, uint32_t Count);
+    int32_t OV5640_FRAME_YUV422ToRGB565(const uint8_t *pSrc, uint16_t *pDst, uint32_t Count);
+    int32_t OV5640_FRAME_DownscaleY8(const uint8_t *pSrc, uint32_t Width, uint32_t Height, uint32_t Factor, uint8_t *pDst);
+    int32_t OV5640_FRAME_DownscaleRGB565(const uint16_t *pSrc, uint32_t Width, uint32_t Height, uint32_t Factor,
+                                         uint16_t *pDst);
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    #ifdef __cplusplus
+}
+    #endif
+
+#endif /* OV5640_FRAME_H */
@@ -0,0 +1,462 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_mgr.c
+ * @brief   Manager of several OV5640 sensors sharing one SCCB bus.
+ *          Behind muxes or at different addresses (OV5640_IO_t.Address), the
+ *          sensors are configured one after the other while the AF firmware
+ *          of the previous ones boots, then a single wait covers every AF
+ *          MCU. With a broadcast IO, the common tables and the AF firmware
+ *          are sent once to all the sensors. Every bus access of the manager
+ *          is made under the Lock and Unlock hooks, which the application
+ *          also uses around its own calls to the registered sensors.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ov5640_mgr.h"
+
+#if (OV5640_CFG_AF != 1U)
+    #error "ov5640_mgr.c schedules the AF firmware download, it needs OV5640_CFG_AF"
+#endif
+
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @addtogroup Components
+ * @{
+ */
+
+/** @addtogroup OV5640_MGR
+ * @brief     This file provides a shared-bus manager of OV5640 sensors.
+ * @{
+ */
+
+/** @defgroup OV5640_MGR_Private_Defines
+ * @{
+ */
+/* Period of the AF boot polls, the bus is released in between */
+#define OV5640_MGR_POLL_MS 5U
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_MGR_Private_Functions_Prototypes
+ * @{
+ */
+static int32_t OV5640_MGR_Delay(OV5640_MGR_t *pMgr, uint32_t Delay);
+static int32_t OV5640_MGR_GetTick(OV5640_MGR_t *pMgr);
+static uint8_t OV5640_MGR_HasTimeBase(OV5640_MGR_t *pMgr);
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_MGR_Exported_Functions
+ * @{
+ */
+
+/**
+ * @brief  Initialize a sensor manager
+ * @param  pMgr    pointer to the manager
+ * @param  Lock    hook taking the shared bus, NULL without RTOS
+ * @param  Unlock  hook giving the shared bus back, NULL without RTOS
+ * @param  pLock   argument passed to the hooks, e.g. the mutex handle
+ * @retval OV5640_OK
+ */
+int32_t OV5640_MGR_Init(OV5640_MGR_t *pMgr, OV5640_MGR_Lock_Func Lock, OV5640_MGR_Lock_Func Unlock, void *pLock) {
+    pMgr->Count  = 0;
+    pMgr->Lock   = Lock;
+    pMgr->Unlock = Unlock;
+    pMgr->pLock  = pLock;
+    pMgr->UseBroadcast = 0U;
+
+    return OV5640_OK;
+}
+
+/**
+ * @brief  Register a write-only IO reaching every sensor at once
+ * @note   For instance an I2C mux with all its channels enabled, or a
+ *         shared SCCB address all the sensors answer to. Only its Init and
+ *         WriteReg hooks are used, reads always go to each sensor's own IO.
+ * @param  pMgr  pointer to the manager
+ * @param  pIO   broadcast IO, NULL to upload to each sensor separately
+ * @retval Component status
+ */
+int32_t OV5640_MGR_SetBroadcast(OV5640_MGR_t *pMgr, OV5640_IO_t *pIO) {
+    int32_t ret = OV5640_OK;
+
+    pMgr->UseBroadcast = 0U;
+
+    if (pIO != NULL) {
+        if ((pIO->WriteReg == NULL) || (OV5640_RegisterBusIO(&pMgr->Broadcast, pIO) != OV5640_OK)) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            /* Several sensors answering one read would collide */
+            pMgr->Broadcast.IO.ReadReg = NULL;
+            pMgr->UseBroadcast         = 1U;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Register a sensor
+ * @note   OV5640_RegisterBusIO must have been called on the sensor.
+ * @param  pMgr         pointer to the manager
+ * @param  pSensor      pointer to the sensor component object
+ * @param  Resolution   resolution applied by OV5640_MGR_InitAll
+ * @param  PixelFormat  OV5640_RGB565 or OV5640_JPEG
+ * @retval Index of the sensor in the manager, OV5640_ERROR when full
+ */
+int32_t OV5640_MGR_Add(OV5640_MGR_t *pMgr, OV5640_Object_t *pSensor, uint32_t Resolution, uint32_t PixelFormat) {
+    int32_t ret;
+
+    if ((pSensor == NULL) || (pMgr->Count >= OV5640_MGR_MAX_SENSORS)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        pMgr->Sensor[pMgr->Count].pSensor     = pSensor;
+        pMgr->Sensor[pMgr->Count].Resolution  = Resolution;
+        pMgr->Sensor[pMgr->Count].PixelFormat = PixelFormat;
+        pMgr->Sensor[pMgr->Count].Phase       = OV5640_MGR_PHASE_IDLE;
+
+        ret                                   = (int32_t)pMgr->Count;
+        pMgr->Count++;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Initialize every registered sensor like OV5640_Init_General_Mode
+ * @note   Each sensor is configured then gets its AF firmware, which boots
+ *         while the next sensors are configured. With a broadcast IO the
+ *         common table and the AF firmware are written once to all the
+ *         sensors instead, and only the pixel format and resolution are
+ *         applied per sensor, after reading its AF firmware back with
+ *         OV5640_AF_VERIFY_MODE. Only the sensors whose readback matched are
+ *         released from reset, once all of them were read back. The boot of all the AF MCUs is then awaited at
+ *         once, releasing the bus between polls. The outcome of each sensor
+ *         is left in its Phase. The first sensor's IO.Delay or IO.GetTick
+ *         hook times the boot, registering neither is an error.
+ * @param  pMgr     pointer to the manager
+ * @param  Timeout  AF boot timeout in ms, e.g. OV5640_MGR_BOOT_TIMEOUT_MS
+ * @retval OV5640_OK when every sensor is ready
+ */
+int32_t OV5640_MGR_InitAll(OV5640_MGR_t *pMgr, uint32_t Timeout) {
+    int32_t              ret = OV5640_OK;
+    int32_t              status;
+    OV5640_MGR_Sensor_t *sensor;
+#if (OV5640_AF_VERIFY_MODE != OV5640_AF_VERIFY_NONE)
+    uint8_t              match;
+#endif
+    uint32_t             pending = 0;
+    uint32_t             polls   = 0;
+    uint32_t             start;
+    uint32_t             elapsed;
+    uint32_t             i;
+    uint8_t              ready;
+
+    if (pMgr->Count == 0U) {
+        ret = OV5640_ERROR;
+    }
+    else if (OV5640_MGR_HasTimeBase(pMgr) == 0U) {
+        /* No time base, the boot timeout would expire at once */
+        ret = OV5640_ERROR;
+    }
+    else if (pMgr->UseBroadcast != 0U) {
+        /* Common table and AF firmware once for all the sensors */
+        if (OV5640_MGR_Lock(pMgr) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            if ((OV5640_Init_General_Common(&pMgr->Broadcast) != OV5640_OK) ||
+                (OV5640_Focus_Download(&pMgr->Broadcast) != OV5640_OK)) {
+                ret = OV5640_ERROR;
+            }
+            (void)OV5640_MGR_Unlock(pMgr);
+        }
+    }
+
+    /* Configure (and start the AF firmware of) each sensor in turn, a
+       broadcast download is only verified here and released below */
+    for (i = 0; (ret == OV5640_OK) && (i < pMgr->Count); i++) {
+        sensor = &pMgr->Sensor[i];
+
+        if (OV5640_MGR_Lock(pMgr) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            if (pMgr->UseBroadcast != 0U) {
+                /* The sensor's cache did not see the broadcast writes */
+                (void)OV5640_InvalidateRegCache(sensor->pSensor);
+                status = OV5640_Init_General_Format(sensor->pSensor, sensor->Resolution, sensor->PixelFormat);
+#if (OV5640_AF_VERIFY_MODE != OV5640_AF_VERIFY_NONE)
+                /* The broadcast download could not be read back */
+                if ((status == OV5640_OK) &&
+                    ((OV5640_Focus_Verify(sensor->pSensor, OV5640_AF_VERIFY_MODE, &match) != OV5640_OK) ||
+                     (match == 0U))) {
+                    status = OV5640_ERROR;
+                }
+#endif
+            }
+            else if (OV5640_Init_General_Config(sensor->pSensor, sensor->Resolution, sensor->PixelFormat) != OV5640_OK) {
+                status = OV5640_ERROR;
+            }
+            else {
+                status = OV5640_Focus_Upload(sensor->pSensor);
+            }
+
+            if (status != OV5640_OK) {
+                sensor->Phase = OV5640_MGR_PHASE_FAILED;
+            }
+            else {
+                sensor->Phase = OV5640_MGR_PHASE_BOOTING;
+                pending++;
+            }
+            (void)OV5640_MGR_Unlock(pMgr);
+        }
+    }
+
+    /* Start the verified AF MCUs once every sensor was read back, a
+       corrupted one stays in reset */
+    for (i = 0; (ret == OV5640_OK) && (pMgr->UseBroadcast != 0U) && (i < pMgr->Count); i++) {
+        sensor = &pMgr->Sensor[i];
+
+        if (sensor->Phase != OV5640_MGR_PHASE_BOOTING) {
+            /* Failed its readback */
+        }
+        else if (OV5640_MGR_Lock(pMgr) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            if (OV5640_Focus_Release(sensor->pSensor) != OV5640_OK) {
+                sensor->Phase = OV5640_MGR_PHASE_FAILED;
+                pending--;
+            }
+            (void)OV5640_MGR_Unlock(pMgr);
+        }
+    }
+
+    /* One wait for all the AF MCUs */
+    start = (uint32_t)OV5640_MGR_GetTick(pMgr);
+    while ((ret == OV5640_OK) && (pending != 0U)) {
+        if (OV5640_MGR_Lock(pMgr) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            for (i = 0; i < pMgr->Count; i++) {
+                sensor = &pMgr->Sensor[i];
+                if (sensor->Phase == OV5640_MGR_PHASE_BOOTING) {
+                    if (OV5640_Focus_Ready(sensor->pSensor, &ready) != OV5640_OK) {
+                        sensor->Phase = OV5640_MGR_PHASE_FAILED;
+                        pending--;
+                    }
+                    else if (ready != 0U) {
+                        sensor->Phase = OV5640_MGR_PHASE_READY;
+                        pending--;
+                    }
+                }
+            }
+            (void)OV5640_MGR_Unlock(pMgr);
+
+            if (pending == 0U) {
+                break;
+            }
+
+            /* Without a tick, the delays between the polls measure the wait */
+            polls++;
+            if (pMgr->Sensor[0].pSensor->IO.GetTick != NULL) {
+                elapsed = (uint32_t)OV5640_MGR_GetTick(pMgr) - start;
+            }
+            else {
+                elapsed = polls * OV5640_MGR_POLL_MS;
+            }
+
+            if (elapsed > Timeout) {
+                for (i = 0; i < pMgr->Count; i++) {
+                    if (pMgr->Sensor[i].Phase == OV5640_MGR_PHASE_BOOTING) {
+                        pMgr->Sensor[i].Phase = OV5640_MGR_PHASE_FAILED;
+                    }
+                }
+                pending = 0;
+            }
+            else {
+                (void)OV5640_MGR_Delay(pMgr, OV5640_MGR_POLL_MS);
+            }
+        }
+    }
+
+    for (i = 0; (ret == OV5640_OK) && (i < pMgr->Count); i++) {
+        if (pMgr->Sensor[i].Phase != OV5640_MGR_PHASE_READY) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    return ret;
+}
+
+#if (OV5640_CFG_MIPI == 1U)
+/**
+ * @brief  Give each registered sensor its own CSI-2 virtual channel
+ * @note   Every sensor gets the same lanes, rate and clock mode, and the
+ *         virtual channel of its registration index. Their links are merged
+ *         in front of the single receiver by a CSI-2 aggregator, which must
+ *         carry the aggregate rate. The link is solved once by
+ *         OV5640_ComputeMIPI, a rate beyond its SYSCLK or lane rate limits
+ *         fails before any sensor is touched. Call after OV5640_MGR_InitAll.
+ * @param  pMgr     pointer to the manager
+ * @param  pConfig  link request, its VirtualChannel is ignored
+ * @param  pRate    filled with the aggregate bit rate in Mbit/s, can be NULL
+ * @retval Component status
+ */
+int32_t OV5640_MGR_SetMIPIChannels(OV5640_MGR_t *pMgr, const OV5640_MIPIConfig_t *pConfig, uint32_t *pRate) {
+    int32_t             ret = OV5640_OK;
+    OV5640_MIPIConfig_t config;
+    OV5640_MIPILink_t   link;
+    uint32_t            i;
+
+    if ((pConfig == NULL) || (pMgr->Count == 0U) || (pMgr->Count > (OV5640_MIPI_VC_MAX + 1U))) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        config                = *pConfig;
+        config.VirtualChannel = 0;
+        ret                   = OV5640_ComputeMIPI(&config, &link);
+    }
+
+    for (i = 0; (ret == OV5640_OK) && (i < pMgr->Count); i++) {
+        link.VirtualChannel = (uint8_t)i;
+
+        if (OV5640_MGR_Lock(pMgr) != OV5640_OK) {
+            ret = OV5640_ERROR;
+        }
+        else {
+            ret = OV5640_ApplyMIPI(pMgr->Sensor[i].pSensor, &link);
+            (void)OV5640_MGR_Unlock(pMgr);
+        }
+    }
+
+    if ((ret == OV5640_OK) && (pRate != NULL)) {
+        *pRate = (uint32_t)(((uint64_t)link.LaneRate * link.Lanes * pMgr->Count) / 1000000U);
+    }
+
+    return ret;
+}
+#endif
+
+/**
+ * @brief  Take the shared bus before calling the driver on a registered sensor
+ * @param  pMgr  pointer to the manager
+ * @retval Component status
+ */
+int32_t OV5640_MGR_Lock(OV5640_MGR_t *pMgr) {
+    int32_t ret = OV5640_OK;
+
+    if ((pMgr->Lock != NULL) && (pMgr->Lock(pMgr->pLock) != 0)) {
+        ret = OV5640_ERROR;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Give the shared bus back
+ * @param  pMgr  pointer to the manager
+ * @retval Component status
+ */
+int32_t OV5640_MGR_Unlock(OV5640_MGR_t *pMgr) {
+    int32_t ret = OV5640_OK;
+
+    if ((pMgr->Unlock != NULL) && (pMgr->Unlock(pMgr->pLock) != 0)) {
+        ret = OV5640_ERROR;
+    }
+
+    return ret;
+}
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_MGR_Private_Functions
+ * @{
+ */
+
+/**
+ * @brief  Wait with the first sensor's delay hook, or by polling its tick
+ * @param  pMgr   pointer to the manager
+ * @param  Delay  delay in ms
+ * @retval OV5640_OK
+ */
+static int32_t OV5640_MGR_Delay(OV5640_MGR_t *pMgr, uint32_t Delay) {
+    OV5640_IO_t *io = &pMgr->Sensor[0].pSensor->IO;
+    uint32_t     tickstart;
+
+#if (OV5640_USE_DELAY_HOOK == 1U)
+    if (io->Delay != NULL) {
+        (void)io->Delay(Delay);
+        return OV5640_OK;
+    }
+#endif
+
+    if (io->GetTick != NULL) {
+        tickstart = (uint32_t)io->GetTick();
+        while (((uint32_t)io->GetTick() - tickstart) < Delay) {
+        }
+    }
+
+    return OV5640_OK;
+}
+
+/**
+ * @brief  Time base of the manager: the first sensor's tick
+ * @param  pMgr  pointer to the manager
+ * @retval Tick in ms, 0 without GetTick hook
+ */
+static int32_t OV5640_MGR_GetTick(OV5640_MGR_t *pMgr) {
+    OV5640_IO_t *io = &pMgr->Sensor[0].pSensor->IO;
+
+    return (io->GetTick != NULL) ? io->GetTick() : 0;
+}
+
+/**
+ * @brief  Check that the first sensor can time the waits of the manager
+ * @param  pMgr  pointer to the manager
+ * @retval 1 with a Delay or GetTick hook, 0 otherwise
+ */
+static uint8_t OV5640_MGR_HasTimeBase(OV5640_MGR_t *pMgr) {
+    OV5640_IO_t *io = &pMgr->Sensor[0].pSensor->IO;
+    uint8_t      ret = (io->GetTick != NULL) ? 1U : 0U;
+
+#if (OV5640_USE_DELAY_HOOK == 1U)
+    if (io->Delay != NULL) {
+        ret = 1U;
+    }
+#endif
+
+    return ret;
+}
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
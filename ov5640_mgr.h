@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_mgr.h
+ * @brief   Header of ov5640_mgr.c: several OV5640 sensors sharing one SCCB
+ *          bus, initialized with interleaved configuration and AF boot.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OV5640_MGR_H
+    #define OV5640_MGR_H
+
+    #ifdef __cplusplus
+extern "C"
+{
+    #endif
+
+    /* Includes ------------------------------------------------------------------*/
+    #include "ov5640.h"
+
+    /** @addtogroup BSP
+     * @{
+     */
+
+    /** @addtogroup Components
+     * @{
+     */
+
+    /** @addtogroup OV5640_MGR
+     * @{
+     */
+
+    /** @defgroup OV5640_MGR_Exported_Types
+     * @{
+     */
+
+    #ifndef OV5640_MGR_MAX_SENSORS
+        #define OV5640_MGR_MAX_SENSORS 4U
+    #endif
+
+    /* Bus lock hook, e.g. a wrapper of xSemaphoreTake/xSemaphoreGive, 0 on success */
+    typedef int32_t (*OV5640_MGR_Lock_Func)(void *pLock);
+
+    /* Sensor registered to the manager */
+    typedef struct
+    {
+        OV5640_Object_t *pSensor;     /*!< Driver handle, IO already registered  */
+        uint32_t         Resolution;  /*!< Mode applied by OV5640_MGR_InitAll     */
+        uint32_t         PixelFormat; /*!< OV5640_RGB565 or OV5640_JPEG           */
+        uint8_t          Phase;       /*!< OV5640_MGR_PHASE_xxx                   */
+    } OV5640_MGR_Sensor_t;
+
+    typedef struct
+    {
+        OV5640_MGR_Sensor_t  Sensor[OV5640_MGR_MAX_SENSORS];
+        uint32_t             Count;
+        OV5640_MGR_Lock_Func Lock;   /*!< Take the shared bus, can be NULL */
+        OV5640_MGR_Lock_Func Unlock; /*!< Give the shared bus, can be NULL */
+        void                *pLock;  /*!< Argument of Lock and Unlock      */
+        uint8_t              UseBroadcast; /*!< 1 when Broadcast is registered */
+        OV5640_Object_t      Broadcast;    /*!< Write-only handle reaching every sensor */
+    } OV5640_MGR_t;
+
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_MGR_Exported_Constants
+     * @{
+     */
+    #define OV5640_MGR_PHASE_IDLE     0x00U /* Not initialized yet             */
+    #define OV5640_MGR_PHASE_BOOTING  0x01U /* Configured, AF firmware booting */
+    #define OV5640_MGR_PHASE_READY    0x02U /* Configured, AF firmware idle    */
+    #define OV5640_MGR_PHASE_FAILED   0x03U /* Bus error or AF boot timeout    */
+
+    #define OV5640_MGR_BOOT_TIMEOUT_MS 5000U
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_MGR_Exported_Functions
+     * @{
+     */
+    int32_t OV5640_MGR_Init(OV5640_MGR_t *pMgr, OV5640_MGR_Lock_Func Lock, OV5640_MGR_Lock_Func Unlock, void *pLock);
+    int32_t OV5640_MGR_Add(OV5640_MGR_t *pMgr, OV5640_Object_t *pSensor, uint32_t Resolution, uint32_t PixelFormat);
+    int32_t OV5640_MGR_SetBroadcast(OV5640_MGR_t *pMgr, OV5640_IO_t *pIO);
+    int32_t OV5640_MGR_InitAll(OV5640_MGR_t *pMgr, uint32_t Timeout);
+    #if (OV5640_CFG_MIPI == 1U)
+    int32_t OV5640_MGR_SetMIPIChannels(OV5640_MGR_t *pMgr, const OV5640_MIPIConfig_t *pConfig, uint32_t *pRate);
+    #endif
+    int32_t OV5640_MGR_Lock(OV5640_MGR_t *pMgr);
+    int32_t OV5640_MGR_Unlock(OV5640_MGR_t *pMgr);
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    #ifdef __cplusplus
+}
+    #endif
+
+#endif /* OV5640_MGR_H */
@@ -21,7 +21,16 @@
 #ifndef OV5640_REG_H
     #define OV5640_REG_H
 
-    #include <cmsis_compiler.h>
+    #if defined(OV5640_HOST_BUILD)
+        /* Host build (see ov5640_sim.c): stand-ins for the CMSIS compiler layer */
+        #include <stdint.h>
+        #define __PACKED_STRUCT  struct __attribute__((packed))
+        #define __get_PRIMASK()  (0U)
+        #define __disable_irq()
+        #define __set_PRIMASK(x) ((void)(x))
+    #else
+        #include <cmsis_compiler.h>
+    #endif
 
     #ifdef __cplusplus
 extern "C"
@@ -168,6 +177,7 @@ extern "C"
     #define OV5640_HSYNC_WIDTH_LOW              0x3819U
     #define OV5640_TIMING_TC_REG20              0x3820U
     #define OV5640_TIMING_TC_REG21              0x3821U
+    #define OV5640_PCLK_MANUAL_DIV              0x3824U
 
     /* AEC/AGC power down domain control [0x3A00 ~ 0x3A25] */
     #define OV5640_AEC_CTRL00                   0x3A00U
@@ -0,0 +1,710 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_sim.c
+ * @brief   Simulated SCCB bus and OV5640 sensor.
+ *          The IO returned by OV5640_SIM_GetIO drives a 64K register file
+ *          with a per-transaction latency model and a fake AF MCU, so that
+ *          the driver can be benchmarked and regression-tested on a host.
+ *          Build it together with ov5640.c and ov5640_reg.c, with
+ *          OV5640_HOST_BUILD defined and OV5640_USE_DELAY_HOOK set to 1U.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ov5640_sim.h"
+#include <string.h>
+
+#if (OV5640_USE_DELAY_HOOK != 1U)
+    #error "ov5640_sim.c advances the simulated time in its Delay hook, it needs OV5640_USE_DELAY_HOOK"
+#endif
+
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @addtogroup Components
+ * @{
+ */
+
+/** @addtogroup OV5640_SIM
+ * @brief     This file provides a host model of the OV5640 and its bus.
+ * @{
+ */
+
+/** @defgroup OV5640_SIM_Private_Defines
+ * @{
+ */
+/* Bytes compared to tell whether the AF program RAM holds the firmware */
+#define OV5640_SIM_AF_PROBE_SIZE 16U
+
+/* AF MCU 0x3029 status codes */
+#define OV5640_SIM_AF_S_FIRMWARE 0x7FU
+#define OV5640_SIM_AF_S_STARTUP  0x7EU
+#define OV5640_SIM_AF_S_IDLE     0x70U
+#define OV5640_SIM_AF_S_FOCUSING 0x00U
+#define OV5640_SIM_AF_S_FOCUSED  0x10U
+
+/* Writes a generated init table is never merged across */
+#define OV5640_SIM_GEN_BARRIER(reg) \
+    (((reg) == OV5640_SYSTEM_CTROL0) || ((reg) == 0x3212U) || ((reg) == OV5640_FIXED_INIT_DELAY))
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_SIM_Private_Types
+ * @{
+ */
+typedef struct
+{
+    uint8_t               Regs[0x10000];
+    OV5640_SIM_Config_t   Config;
+    OV5640_SIM_Trace_Func Trace;
+    uint32_t              NowUs;        /*!< Simulated time                     */
+    uint32_t              Transactions; /*!< Counters since the last reset      */
+    uint32_t              Bytes;
+    uint32_t              BusTimeUs;
+    uint8_t               AFRunning;    /*!< AF MCU out of reset with firmware  */
+    uint8_t               StatusPending;
+    uint8_t               StatusNext;   /*!< Value of 0x3029 at StatusAtUs      */
+    uint32_t              StatusAtUs;
+    uint8_t               AckPending;   /*!< 0x3023 cleared at AckAtUs          */
+    uint32_t              AckAtUs;
+    uint32_t              NackSkip;     /*!< Transactions left before the NACKs */
+    uint32_t              NackCount;    /*!< Consecutive transactions to NACK   */
+} OV5640_SIM_State_t;
+
+/* Recorder of OV5640_SIM_GenerateInit */
+typedef struct
+{
+    OV5640_RegVal_t *pTable;
+    uint32_t         MaxSize;
+    uint32_t         Count;
+    uint8_t          Error;
+    uint8_t          Written[0x10000 / 8]; /*!< Registers known since the last reset */
+} OV5640_SIM_Gen_t;
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_SIM_Private_Variables
+ * @{
+ */
+#if (OV5640_CFG_AF == 1U)
+extern const uint8_t      OV5640_AF_Config[];
+#endif
+
+static OV5640_SIM_State_t OV5640_SIM;
+#if (OV5640_CFG_FIXED_INIT != 1U)
+static OV5640_SIM_Gen_t   OV5640_SIM_Gen;
+#endif
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_SIM_Private_Functions_Prototypes
+ * @{
+ */
+static int32_t OV5640_SIM_IoInit(void);
+static int32_t OV5640_SIM_IoDeInit(void);
+static int32_t OV5640_SIM_WriteReg(uint16_t Address, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static int32_t OV5640_SIM_ReadReg(uint16_t Address, uint16_t Reg, uint8_t *pData, uint16_t Length);
+static int32_t OV5640_SIM_GetTick(void);
+static int32_t OV5640_SIM_Delay(uint32_t Delay);
+static void    OV5640_SIM_PowerOn(void);
+static void    OV5640_SIM_Transfer(uint16_t Length);
+static void    OV5640_SIM_Update(void);
+static void    OV5640_SIM_OnWrite(uint16_t Reg, uint8_t Value);
+static void    OV5640_SIM_Measure(OV5640_SIM_Result_t *pResult, int32_t Status, uint32_t StartUs);
+static uint8_t OV5640_SIM_Nack(void);
+#if (OV5640_CFG_FIXED_INIT != 1U)
+static void    OV5640_SIM_GenTrace(uint8_t Read, uint16_t Reg, const uint8_t *pData, uint16_t Length);
+static int32_t OV5640_SIM_GenDelay(uint32_t Delay);
+#endif
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_SIM_Exported_Functions
+ * @{
+ */
+
+/**
+ * @brief  Power on the simulated sensor
+ * @param  pConfig  timing model, NULL for the OV5640_SIM_xxx defaults
+ * @retval OV5640_OK
+ */
+int32_t OV5640_SIM_Init(const OV5640_SIM_Config_t *pConfig) {
+    if (pConfig != NULL) {
+        OV5640_SIM.Config = *pConfig;
+    }
+    else {
+        OV5640_SIM.Config.XferLatencyUs = OV5640_SIM_XFER_LATENCY_US;
+        OV5640_SIM.Config.ByteLatencyUs = OV5640_SIM_BYTE_LATENCY_US;
+        OV5640_SIM.Config.AFBootMs      = OV5640_SIM_AF_BOOT_MS;
+        OV5640_SIM.Config.AFFocusMs     = OV5640_SIM_AF_FOCUS_MS;
+        OV5640_SIM.Config.AFAckMs       = OV5640_SIM_AF_ACK_MS;
+    }
+
+    OV5640_SIM.Trace     = NULL;
+    OV5640_SIM.NowUs     = 0;
+    OV5640_SIM.NackCount = 0;
+    OV5640_SIM_PowerOn();
+    OV5640_SIM_ResetCounters();
+
+    return OV5640_OK;
+}
+
+/**
+ * @brief  Get the bus IO to register with OV5640_RegisterBusIO
+ * @param  pIO  filled with the simulated bus hooks
+ */
+void OV5640_SIM_GetIO(OV5640_IO_t *pIO) {
+    (void)memset(pIO, 0, sizeof(OV5640_IO_t));
+
+    pIO->Init     = OV5640_SIM_IoInit;
+    pIO->DeInit   = OV5640_SIM_IoDeInit;
+    pIO->Address  = 0x78;
+    pIO->WriteReg = OV5640_SIM_WriteReg;
+    pIO->ReadReg  = OV5640_SIM_ReadReg;
+    pIO->GetTick  = OV5640_SIM_GetTick;
+    pIO->Delay    = OV5640_SIM_Delay;
+}
+
+/**
+ * @brief  Install a hook called for every simulated transaction
+ * @param  Trace  trace hook, NULL to disable tracing
+ */
+void OV5640_SIM_SetTrace(OV5640_SIM_Trace_Func Trace) {
+    OV5640_SIM.Trace = Trace;
+}
+
+/**
+ * @brief  Read a register of the simulated sensor without bus cost
+ * @param  Reg  register address
+ * @retval Register value
+ */
+uint8_t OV5640_SIM_Peek(uint16_t Reg) {
+    OV5640_SIM_Update();
+    return OV5640_SIM.Regs[Reg];
+}
+
+/**
+ * @brief  Write a register of the simulated sensor without bus cost
+ * @note   The AF MCU does not see the write, use it to inject faults.
+ * @param  Reg    register address
+ * @param  Value  register value
+ */
+void OV5640_SIM_Poke(uint16_t Reg, uint8_t Value) {
+    OV5640_SIM.Regs[Reg] = Value;
+}
+
+/**
+ * @brief  Make the simulated sensor NACK some of the next transactions
+ * @note   A NACKed transaction costs its bus time, writes nothing and
+ *         returns OV5640_ERROR, like a glitch on the SCCB lines.
+ * @param  Skip   transactions completed normally before the first NACK
+ * @param  Count  consecutive transactions NACKed, 0 to cancel
+ */
+void OV5640_SIM_InjectNack(uint32_t Skip, uint32_t Count) {
+    OV5640_SIM.NackSkip  = Skip;
+    OV5640_SIM.NackCount = Count;
+}
+
+/**
+ * @brief  Clear the transaction counters
+ */
+void OV5640_SIM_ResetCounters(void) {
+    OV5640_SIM.Transactions = 0;
+    OV5640_SIM.Bytes        = 0;
+    OV5640_SIM.BusTimeUs    = 0;
+}
+
+/**
+ * @brief  Get the transaction counters
+ * @param  pResult  filled with the counters, Status and ElapsedUs are not set
+ */
+void OV5640_SIM_GetCounters(OV5640_SIM_Result_t *pResult) {
+    pResult->Transactions = OV5640_SIM.Transactions;
+    pResult->Bytes        = OV5640_SIM.Bytes;
+    pResult->BusTimeUs    = OV5640_SIM.BusTimeUs;
+}
+
+/**
+ * @brief  Get the simulated time
+ * @retval Microseconds since OV5640_SIM_Init
+ */
+uint32_t OV5640_SIM_GetTimeUs(void) {
+    return OV5640_SIM.NowUs;
+}
+
+/**
+ * @brief  Measure the main driver sequences on a freshly powered sensor
+ * @param  pConfig  timing model, NULL for the OV5640_SIM_xxx defaults
+ * @param  pBench   filled with the cost of each sequence
+ * @retval OV5640_OK if every sequence succeeded
+ */
+int32_t OV5640_SIM_Benchmark(const OV5640_SIM_Config_t *pConfig, OV5640_SIM_Bench_t *pBench) {
+    OV5640_Object_t obj;
+    OV5640_IO_t     io;
+    int32_t         ret = OV5640_OK;
+    int32_t         status;
+    uint32_t        start;
+
+    /* OV5640_Init */
+    (void)OV5640_SIM_Init(pConfig);
+    (void)memset(&obj, 0, sizeof(obj));
+    OV5640_SIM_GetIO(&io);
+    (void)OV5640_RegisterBusIO(&obj, &io);
+    start  = OV5640_SIM.NowUs;
+    status = OV5640_Init(&obj, OV5640_R640x480, OV5640_RGB565);
+    OV5640_SIM_Measure(&pBench->Init, status, start);
+
+    /* OV5640_SetResolution on the initialized sensor */
+    OV5640_SIM_ResetCounters();
+    start  = OV5640_SIM.NowUs;
+    status = OV5640_SetResolution(&obj, OV5640_R320x240);
+    OV5640_SIM_Measure(&pBench->SetResolution, status, start);
+
+    /* OV5640_Init_General_Mode, AF firmware download included */
+    (void)OV5640_SIM_Init(pConfig);
+    (void)memset(&obj, 0, sizeof(obj));
+    (void)OV5640_RegisterBusIO(&obj, &io);
+    start  = OV5640_SIM.NowUs;
+    status = OV5640_Init_General_Mode(&obj, OV5640_R640x480, OV5640_RGB565);
+    OV5640_SIM_Measure(&pBench->InitGeneral, status, start);
+
+    /* OV5640_Focus_Init alone */
+    (void)OV5640_SIM_Init(pConfig);
+    (void)memset(&obj, 0, sizeof(obj));
+    (void)OV5640_RegisterBusIO(&obj, &io);
+    start  = OV5640_SIM.NowUs;
+#if (OV5640_CFG_AF == 1U)
+    status = OV5640_Focus_Init(&obj);
+#else
+    status = OV5640_OK;
+#endif
+    OV5640_SIM_Measure(&pBench->FocusInit, status, start);
+
+    if ((pBench->Init.Status != OV5640_OK) || (pBench->SetResolution.Status != OV5640_OK) ||
+        (pBench->InitGeneral.Status != OV5640_OK) || (pBench->FocusInit.Status != OV5640_OK)) {
+        ret = OV5640_ERROR;
+    }
+
+    return ret;
+}
+
+#if (OV5640_CFG_FIXED_INIT != 1U)
+/**
+ * @brief  Record OV5640_Init on a freshly powered sensor as a single table
+ *         for an OV5640_CFG_FIXED_INIT build
+ * @note   A write is dropped when a later write of the sequence sets the
+ *         same register again with no software reset or group hold write in
+ *         between, the order of the other writes is kept. The delays of the
+ *         driver are recorded as OV5640_FIXED_INIT_DELAY entries, which
+ *         writes are never merged across. The generation fails when the
+ *         driver reads a register it did not write since the last reset,
+ *         since its value on the sensor is not modeled.
+ * @param  Resolution   resolution given to OV5640_Init
+ * @param  PixelFormat  pixel format given to OV5640_Init
+ * @param  Mode         PARALLEL_MODE or SERIAL_MODE, virtual channel 0
+ * @param  pTable       destination, must hold the unmerged sequence
+ * @param  MaxSize      number of entries of pTable
+ * @param  pSize        number of entries of the generated table
+ * @retval Component status
+ */
+int32_t OV5640_SIM_GenerateInit(uint32_t Resolution, uint32_t PixelFormat, uint32_t Mode, OV5640_RegVal_t *pTable,
+                                uint32_t MaxSize, uint32_t *pSize) {
+    OV5640_Object_t obj;
+    OV5640_IO_t     io;
+    int32_t         ret = OV5640_OK;
+    uint32_t        i;
+    uint32_t        j;
+    uint32_t        count;
+    uint8_t         keep;
+
+    (void)OV5640_SIM_Init(NULL);
+    (void)memset(&obj, 0, sizeof(obj));
+    OV5640_SIM_GetIO(&io);
+    io.Delay = OV5640_SIM_GenDelay;
+    (void)OV5640_RegisterBusIO(&obj, &io);
+    obj.Mode = (uint8_t)Mode;
+
+    (void)memset(&OV5640_SIM_Gen, 0, sizeof(OV5640_SIM_Gen));
+    OV5640_SIM_Gen.pTable  = pTable;
+    OV5640_SIM_Gen.MaxSize = MaxSize;
+
+    OV5640_SIM_SetTrace(OV5640_SIM_GenTrace);
+    if (OV5640_Init(&obj, Resolution, PixelFormat) != OV5640_OK) {
+        ret = OV5640_ERROR;
+    }
+    OV5640_SIM_SetTrace(NULL);
+
+    if ((ret != OV5640_OK) || (OV5640_SIM_Gen.Error != 0U)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        count = 0;
+        for (i = 0; i < OV5640_SIM_Gen.Count; i++) {
+            /* Look for an overwrite up to the next barrier */
+            keep = 1U;
+            if (OV5640_SIM_GEN_BARRIER(pTable[i].Reg) == 0) {
+                for (j = i + 1U; (j < OV5640_SIM_Gen.Count) && (OV5640_SIM_GEN_BARRIER(pTable[j].Reg) == 0); j++) {
+                    if (pTable[j].Reg == pTable[i].Reg) {
+                        keep = 0U;
+                        break;
+                    }
+                }
+            }
+
+            if (keep != 0U) {
+                pTable[count] = pTable[i];
+                count++;
+            }
+        }
+        *pSize = count;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  Print a generated init table as the C source of the
+ *         OV5640_CFG_FIXED_INIT symbols
+ * @param  pFile        destination file
+ * @param  pTable       table from OV5640_SIM_GenerateInit
+ * @param  Size         number of entries of pTable
+ * @param  Resolution   resolution the table was generated for
+ * @param  PixelFormat  pixel format the table was generated for
+ * @param  Mode         interface mode the table was generated for
+ * @retval Component status
+ */
+int32_t OV5640_SIM_WriteInitSource(FILE *pFile, const OV5640_RegVal_t *pTable, uint32_t Size, uint32_t Resolution,
+                                   uint32_t PixelFormat, uint32_t Mode) {
+    int32_t  ret = OV5640_OK;
+    uint32_t i;
+
+    if ((pFile == NULL) || (pTable == NULL) || (Size == 0U)) {
+        ret = OV5640_ERROR;
+    }
+    else {
+        (void)fprintf(pFile, "/* Generated by OV5640_SIM_GenerateInit, do not edit */\n");
+        (void)fprintf(pFile, "#include \"ov5640.h\"\n\n");
+        (void)fprintf(pFile, "const OV5640_RegVal_t OV5640_FixedInit[] = {\n");
+        for (i = 0; i < Size; i++) {
+            (void)fprintf(pFile, "    {0x%04X, 0x%02X},\n", (unsigned)pTable[i].Reg, (unsigned)pTable[i].Value);
+        }
+        (void)fprintf(pFile, "};\n\n");
+        (void)fprintf(pFile, "const uint32_t OV5640_FixedInitSize       = %luU;\n", (unsigned long)Size);
+        (void)fprintf(pFile, "const uint32_t OV5640_FixedInitResolution = %luU;\n", (unsigned long)Resolution);
+        (void)fprintf(pFile, "const uint32_t OV5640_FixedInitFormat     = %luU;\n", (unsigned long)PixelFormat);
+        if (fprintf(pFile, "const uint32_t OV5640_FixedInitMode       = %luU;\n", (unsigned long)Mode) < 0) {
+            ret = OV5640_ERROR;
+        }
+    }
+
+    return ret;
+}
+#endif
+/**
+ * @}
+ */
+
+/** @defgroup OV5640_SIM_Private_Functions
+ * @{
+ */
+static int32_t OV5640_SIM_IoInit(void) {
+    return OV5640_OK;
+}
+
+static int32_t OV5640_SIM_IoDeInit(void) {
+    return OV5640_OK;
+}
+
+/**
+ * @brief  Simulated bus write
+ * @param  Address  device address, ignored
+ * @param  Reg      first register address
+ * @param  pData    values to be written
+ * @param  Length   number of bytes, written with auto-increment
+ * @retval OV5640_OK, OV5640_ERROR when NACKed
+ */
+static int32_t OV5640_SIM_WriteReg(uint16_t Address, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    uint16_t i;
+
+    (void)Address;
+
+    OV5640_SIM_Transfer(Length);
+    OV5640_SIM_Update();
+    if (OV5640_SIM_Nack() != 0U) {
+        return OV5640_ERROR;
+    }
+    if (OV5640_SIM.Trace != NULL) {
+        OV5640_SIM.Trace(0U, Reg, pData, Length);
+    }
+
+    for (i = 0; i < Length; i++) {
+        OV5640_SIM_OnWrite((uint16_t)(Reg + i), pData[i]);
+    }
+
+    return OV5640_OK;
+}
+
+/**
+ * @brief  Simulated bus read
+ * @param  Address  device address, ignored
+ * @param  Reg      first register address
+ * @param  pData    destination buffer
+ * @param  Length   number of bytes, read with auto-increment
+ * @retval OV5640_OK, OV5640_ERROR when NACKed
+ */
+static int32_t OV5640_SIM_ReadReg(uint16_t Address, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+    uint16_t i;
+
+    (void)Address;
+
+    OV5640_SIM_Transfer(Length);
+    OV5640_SIM_Update();
+    if (OV5640_SIM_Nack() != 0U) {
+        return OV5640_ERROR;
+    }
+
+    for (i = 0; i < Length; i++) {
+        pData[i] = OV5640_SIM.Regs[(uint16_t)(Reg + i)];
+    }
+
+    if (OV5640_SIM.Trace != NULL) {
+        OV5640_SIM.Trace(1U, Reg, pData, Length);
+    }
+
+    return OV5640_OK;
+}
+
+static int32_t OV5640_SIM_GetTick(void) {
+    return (int32_t)(OV5640_SIM.NowUs / 1000U);
+}
+
+static int32_t OV5640_SIM_Delay(uint32_t Delay) {
+    OV5640_SIM.NowUs += Delay * 1000U;
+    return OV5640_OK;
+}
+
+/**
+ * @brief  Reset the register file to its power-on content
+ */
+static void OV5640_SIM_PowerOn(void) {
+    (void)memset(OV5640_SIM.Regs, 0, sizeof(OV5640_SIM.Regs));
+
+    OV5640_SIM.Regs[OV5640_CHIP_ID_HIGH_BYTE] = (uint8_t)(OV5640_ID >> 8);
+    OV5640_SIM.Regs[OV5640_CHIP_ID_LOW_BYTE]  = (uint8_t)(OV5640_ID & 0xFFU);
+    OV5640_SIM.Regs[0x3000]                   = 0x20; /* AF MCU held in reset */
+    OV5640_SIM.Regs[0x3029]                   = OV5640_SIM_AF_S_FIRMWARE;
+
+    OV5640_SIM.AFRunning                      = 0U;
+    OV5640_SIM.StatusPending                  = 0U;
+    OV5640_SIM.AckPending                     = 0U;
+}
+
+/**
+ * @brief  Account for the bus cost of one transaction
+ * @param  Length  number of data bytes
+ */
+static void OV5640_SIM_Transfer(uint16_t Length) {
+    uint32_t cost;
+
+    /* Start, device address, 16-bit register address, data, stop */
+    cost = OV5640_SIM.Config.XferLatencyUs + ((2U + (uint32_t)Length) * OV5640_SIM.Config.ByteLatencyUs);
+
+    OV5640_SIM.Transactions++;
+    OV5640_SIM.Bytes += Length;
+    OV5640_SIM.BusTimeUs += cost;
+    OV5640_SIM.NowUs += cost;
+}
+
+/**
+ * @brief  Apply the AF MCU events that are due
+ */
+static void OV5640_SIM_Update(void) {
+    if ((OV5640_SIM.StatusPending != 0U) && ((int32_t)(OV5640_SIM.NowUs - OV5640_SIM.StatusAtUs) >= 0)) {
+        OV5640_SIM.Regs[0x3029]  = OV5640_SIM.StatusNext;
+        OV5640_SIM.StatusPending = 0U;
+    }
+    if ((OV5640_SIM.AckPending != 0U) && ((int32_t)(OV5640_SIM.NowUs - OV5640_SIM.AckAtUs) >= 0)) {
+        OV5640_SIM.Regs[0x3023] = 0x00;
+        OV5640_SIM.AckPending   = 0U;
+    }
+}
+
+/**
+ * @brief  Model the side effects of a register write
+ * @param  Reg    register address
+ * @param  Value  written value
+ */
+static void OV5640_SIM_OnWrite(uint16_t Reg, uint8_t Value) {
+    OV5640_SIM.Regs[Reg] = Value;
+
+    if ((Reg == OV5640_SYSTEM_CTROL0) && ((Value & 0x80U) != 0U)) {
+        /* Software reset */
+        OV5640_SIM_PowerOn();
+        OV5640_SIM.Regs[OV5640_SYSTEM_CTROL0] = Value & 0x7FU;
+    }
+    else if (Reg == 0x3000) {
+        if ((Value & 0x20U) != 0U) {
+            /* MCU reset asserted */
+            OV5640_SIM.AFRunning     = 0U;
+            OV5640_SIM.StatusPending = 0U;
+            OV5640_SIM.AckPending    = 0U;
+        }
+#if (OV5640_CFG_AF == 1U)
+        else if ((OV5640_SIM.AFRunning == 0U) &&
+                 (memcmp(&OV5640_SIM.Regs[0x8000], OV5640_AF_Config, OV5640_SIM_AF_PROBE_SIZE) == 0)) {
+            /* MCU released with a firmware in its program RAM */
+            OV5640_SIM.AFRunning     = 1U;
+            OV5640_SIM.Regs[0x3029]  = OV5640_SIM_AF_S_STARTUP;
+            OV5640_SIM.StatusNext    = OV5640_SIM_AF_S_IDLE;
+            OV5640_SIM.StatusAtUs    = OV5640_SIM.NowUs + (OV5640_SIM.Config.AFBootMs * 1000U);
+            OV5640_SIM.StatusPending = 1U;
+        }
+#endif
+    }
+    else if ((Reg == 0x3022) && (OV5640_SIM.AFRunning != 0U) && (Value != 0x00U)) {
+        /* Firmware command: acknowledged through 0x3023 */
+        OV5640_SIM.AckAtUs    = OV5640_SIM.NowUs + (OV5640_SIM.Config.AFAckMs * 1000U);
+        OV5640_SIM.AckPending = 1U;
+
+        switch (Value) {
+        case 0x03: /* Single focus */
+        case 0x04: /* Continuous focus */
+            OV5640_SIM.Regs[0x3029]  = OV5640_SIM_AF_S_FOCUSING;
+            OV5640_SIM.StatusNext    = OV5640_SIM_AF_S_FOCUSED;
+            OV5640_SIM.StatusAtUs    = OV5640_SIM.NowUs + (OV5640_SIM.Config.AFFocusMs * 1000U);
+            OV5640_SIM.StatusPending = 1U;
+            break;
+        case 0x08: /* Release the lens */
+            OV5640_SIM.StatusNext    = OV5640_SIM_AF_S_IDLE;
+            OV5640_SIM.StatusAtUs    = OV5640_SIM.AckAtUs;
+            OV5640_SIM.StatusPending = 1U;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief  Fill a benchmark result from the counters
+ * @param  pResult  result to fill
+ * @param  Status   value returned by the measured call
+ * @param  StartUs  simulated time when the call started
+ */
+static void OV5640_SIM_Measure(OV5640_SIM_Result_t *pResult, int32_t Status, uint32_t StartUs) {
+    OV5640_SIM_GetCounters(pResult);
+    pResult->Status    = Status;
+    pResult->ElapsedUs = OV5640_SIM.NowUs - StartUs;
+}
+
+/**
+ * @brief  Tell whether the current transaction is NACKed
+ * @retval 1 if the transaction fails, 0 otherwise
+ */
+static uint8_t OV5640_SIM_Nack(void) {
+    uint8_t ret = 0U;
+
+    if (OV5640_SIM.NackCount != 0U) {
+        if (OV5640_SIM.NackSkip != 0U) {
+            OV5640_SIM.NackSkip--;
+        }
+        else {
+            OV5640_SIM.NackCount--;
+            ret = 1U;
+        }
+    }
+
+    return ret;
+}
+
+#if (OV5640_CFG_FIXED_INIT != 1U)
+/**
+ * @brief  Trace hook of OV5640_SIM_GenerateInit
+ * @param  Read    1 for a read, 0 for a write
+ * @param  Reg     first register address
+ * @param  pData   transferred bytes
+ * @param  Length  number of bytes
+ */
+static void OV5640_SIM_GenTrace(uint8_t Read, uint16_t Reg, const uint8_t *pData, uint16_t Length) {
+    uint16_t i;
+    uint16_t reg;
+
+    for (i = 0; i < Length; i++) {
+        reg = (uint16_t)(Reg + i);
+
+        if (Read != 0U) {
+            if ((OV5640_SIM_Gen.Written[reg >> 3] & (1U << (reg & 7U))) == 0U) {
+                /* Value depends on the sensor defaults */
+                OV5640_SIM_Gen.Error = 1U;
+            }
+        }
+        else if (OV5640_SIM_Gen.Count >= OV5640_SIM_Gen.MaxSize) {
+            OV5640_SIM_Gen.Error = 1U;
+        }
+        else {
+            OV5640_SIM_Gen.pTable[OV5640_SIM_Gen.Count].Reg   = reg;
+            OV5640_SIM_Gen.pTable[OV5640_SIM_Gen.Count].Value = pData[i];
+            OV5640_SIM_Gen.Count++;
+
+            if ((reg == OV5640_SYSTEM_CTROL0) && ((pData[i] & 0x80U) != 0U)) {
+                /* Software reset, the registers are back to their defaults */
+                (void)memset(OV5640_SIM_Gen.Written, 0, sizeof(OV5640_SIM_Gen.Written));
+            }
+            OV5640_SIM_Gen.Written[reg >> 3] |= (uint8_t)(1U << (reg & 7U));
+        }
+    }
+}
+
+/**
+ * @brief  Delay hook of OV5640_SIM_GenerateInit
+ * @note   Records the wait as OV5640_FIXED_INIT_DELAY entries of at most
+ *         255 ms each.
+ * @param  Delay  wait in ms
+ * @retval OV5640_OK
+ */
+static int32_t OV5640_SIM_GenDelay(uint32_t Delay) {
+    uint32_t left = Delay;
+    uint32_t step;
+
+    while ((left != 0U) && (OV5640_SIM_Gen.pTable != NULL)) {
+        step = (left > 0xFFU) ? 0xFFU : left;
+        if (OV5640_SIM_Gen.Count >= OV5640_SIM_Gen.MaxSize) {
+            OV5640_SIM_Gen.Error = 1U;
+            break;
+        }
+        OV5640_SIM_Gen.pTable[OV5640_SIM_Gen.Count].Reg   = OV5640_FIXED_INIT_DELAY;
+        OV5640_SIM_Gen.pTable[OV5640_SIM_Gen.Count].Value = (uint8_t)step;
+        OV5640_SIM_Gen.Count++;
+        left -= step;
+    }
+
+    return OV5640_SIM_Delay(Delay);
+}
+#endif
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file    ov5640_sim.h
+ * @brief   Header of ov5640_sim.c: simulated SCCB bus and OV5640 sensor used
+ *          to benchmark the driver on a host, without hardware.
+ ******************************************************************************
+ * @attention
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OV5640_SIM_H
+    #define OV5640_SIM_H
+
+    #ifdef __cplusplus
+extern "C"
+{
+    #endif
+
+    /* Includes ------------------------------------------------------------------*/
+    #include "ov5640.h"
+    #include <stdio.h>
+
+    /** @addtogroup BSP
+     * @{
+     */
+
+    /** @addtogroup Components
+     * @{
+     */
+
+    /** @addtogroup OV5640_SIM
+     * @{
+     */
+
+    /** @defgroup OV5640_SIM_Exported_Types
+     * @{
+     */
+
+    /* Bus and AF MCU timing model */
+    typedef struct
+    {
+        uint32_t XferLatencyUs; /*!< Cost of a transaction: start, device address, stop */
+        uint32_t ByteLatencyUs; /*!< Cost of each register address or data byte         */
+        uint32_t AFBootMs;      /*!< Firmware start-up time before 0x3029 reads 0x70    */
+        uint32_t AFFocusMs;     /*!< Single focus duration before 0x3029 reads 0x10     */
+        uint32_t AFAckMs;       /*!< Time for the MCU to clear the 0x3023 ack register  */
+    } OV5640_SIM_Config_t;
+
+    /* Cost of a driver call on the simulated bus */
+    typedef struct
+    {
+        int32_t  Status;       /*!< Value returned by the driver call        */
+        uint32_t Transactions; /*!< SCCB transactions                        */
+        uint32_t Bytes;        /*!< Register data bytes moved                */
+        uint32_t BusTimeUs;    /*!< Modeled bus time                         */
+        uint32_t ElapsedUs;    /*!< Bus time plus the delays of the driver   */
+    } OV5640_SIM_Result_t;
+
+    /* Benchmarked driver calls */
+    typedef struct
+    {
+        OV5640_SIM_Result_t Init;          /*!< OV5640_Init, VGA RGB565                   */
+        OV5640_SIM_Result_t InitGeneral;   /*!< OV5640_Init_General_Mode, VGA RGB565      */
+        OV5640_SIM_Result_t SetResolution; /*!< OV5640_SetResolution to QVGA after Init   */
+        OV5640_SIM_Result_t FocusInit;     /*!< OV5640_Focus_Init                         */
+    } OV5640_SIM_Bench_t;
+
+    /* Transaction trace hook, e.g. to record a replay log */
+    typedef void (*OV5640_SIM_Trace_Func)(uint8_t Read, uint16_t Reg, const uint8_t *pData, uint16_t Length);
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_SIM_Exported_Constants
+     * @{
+     */
+    /* Default model: 400 kHz SCCB, 9 bit times per byte */
+    #define OV5640_SIM_XFER_LATENCY_US 30U
+    #define OV5640_SIM_BYTE_LATENCY_US 23U
+    #define OV5640_SIM_AF_BOOT_MS      10U
+    #define OV5640_SIM_AF_FOCUS_MS     200U
+    #define OV5640_SIM_AF_ACK_MS       5U
+    /**
+     * @}
+     */
+
+    /** @defgroup OV5640_SIM_Exported_Functions
+     * @{
+     */
+    int32_t  OV5640_SIM_Init(const OV5640_SIM_Config_t *pConfig);
+    void     OV5640_SIM_GetIO(OV5640_IO_t *pIO);
+    void     OV5640_SIM_SetTrace(OV5640_SIM_Trace_Func Trace);
+    uint8_t  OV5640_SIM_Peek(uint16_t Reg);
+    void     OV5640_SIM_Poke(uint16_t Reg, uint8_t Value);
+    void     OV5640_SIM_InjectNack(uint32_t Skip, uint32_t Count);
+    void     OV5640_SIM_ResetCounters(void);
+    void     OV5640_SIM_GetCounters(OV5640_SIM_Result_t *pResult);
+    uint32_t OV5640_SIM_GetTimeUs(void);
+    int32_t  OV5640_SIM_Benchmark(const OV5640_SIM_Config_t *pConfig, OV5640_SIM_Bench_t *pBench);
+    #if (OV5640_CFG_FIXED_INIT != 1U)
+    int32_t  OV5640_SIM_GenerateInit(uint32_t Resolution, uint32_t PixelFormat, uint32_t Mode, OV5640_RegVal_t *pTable,
+                                     uint32_t MaxSize, uint32_t *pSize);
+    int32_t  OV5640_SIM_WriteInitSource(FILE *pFile, const OV5640_RegVal_t *pTable, uint32_t Size, uint32_t Resolution,
+                                        uint32_t PixelFormat, uint32_t Mode);
+    #endif
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    /**
+     * @}
+     */
+
+    #ifdef __cplusplus
+}
+    #endif
+
+#endif /* OV5640_SIM_H */